@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <nlohmann/json.hpp>
+
+// Per-rank numbers of every champion ability (cooldown, cost, range and the
+// ddragon "effect" values), parsed once into fixed-width arrays: every
+// ability owns kMaxRanks floats in each column, so whole-table passes such as
+// the ability haste adjustment are one flat loop.
+class AbilityTable {
+public:
+    static constexpr int kMaxRanks = 6;
+    static constexpr int kMaxEffects = 10;
+    static constexpr int kSlots = 4;   // Q, W, E, R
+    static const char* SlotKey(int slot);
+
+    struct Ability {
+        uint32_t champion = 0;   // index into DataManager::GetChampionNames()
+        uint8_t slot = 0;
+        uint8_t maxRank = 0;
+        std::string name;
+    };
+
+    void Reset();
+    // Changes with every Reset, so views cached from one table can tell a
+    // rebuilt one of the same size apart
+    uint64_t Generation() const { return generation; }
+    // Appends one ddragon spell object; returns false if it has no ranks.
+    bool Add(uint32_t champion, int slot, const nlohmann::json& spell);
+
+    size_t Size() const { return abilities.size(); }
+    const Ability& GetAbility(size_t row) const { return abilities[row]; }
+    const float* Cooldowns(size_t row) const { return &cooldown[row * kMaxRanks]; }
+    const float* Costs(size_t row) const { return &cost[row * kMaxRanks]; }
+    const float* Ranges(size_t row) const { return &range[row * kMaxRanks]; }
+    // effect e1 - e10 of ddragon, e starting at 1
+    const float* Effect(size_t row, int e) const { return &effect[(row * kMaxEffects + (e - 1)) * kMaxRanks]; }
+
+    // Cooldown of every rank of every ability at the ability haste value, in
+    // the same layout as Cooldowns().
+    void HasteCooldowns(float abilityHaste, std::vector<float>& out) const;
+
+    // "10/9.5/9" -> { 10, 9.5, 9 }
+    static std::vector<float> ParseBurn(const std::string& burn);
+
+private:
+    std::vector<Ability> abilities;
+    std::vector<float> cooldown;
+    std::vector<float> cost;
+    std::vector<float> range;
+    std::vector<float> effect;
+    uint64_t generation = 0;
+    static std::atomic<uint64_t> nextGeneration;
+};
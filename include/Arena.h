@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// Bump allocator: an allocation is a pointer increment into the current
+// block, nothing is freed on its own, and Reset drops everything at once.
+// Reset keeps the memory, merged into one block, so a caller that reuses the
+// arena (a frame, a rebuild) stops allocating once it has seen its peak. It is
+// a std::pmr::memory_resource, so pmr containers can live in it. Not thread
+// safe; an arena belongs to whoever is filling it.
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(size_t blockSize = 64 * 1024);
+    ~Arena() override = default;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    // A null-terminated copy
+    std::string_view Store(std::string_view text);
+    // printf into the arena; valid until Reset
+    const char* Format(const char* format, ...);
+
+    void Reset();
+    size_t BytesUsed() const { return used + offset; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t blockSize;
+    size_t offset = 0;     // into blocks.back()
+    size_t used = 0;       // in the blocks before it
+
+    void* do_allocate(size_t bytes, size_t alignment) override { return Allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <cstdint>
+
+// A patch's dataset snapshots and icons in one zlib-compressed file, written
+// by the AssetPacker tool from a local Data Dragon mirror and embedded in the
+// executable as a resource, so the first launch needs no network. Entries are
+// compressed one by one and inflated only when asked for.
+class AssetBundle {
+public:
+    // Icons downscaled to one cell size and packed in a grid, cell i at
+    // column i % columns, row i / columns.
+    struct Atlas {
+        int cellSize = 0;
+        int columns = 0;
+        int rows = 0;
+        std::vector<std::string> keys;   // "champion/<id>", "item/<id>", "spell/<id>", by cell
+        std::vector<uint8_t> pixels;     // RGBA, columns * cellSize wide
+
+        int Width() const { return columns * cellSize; }
+        // Copies one cell out as a cellSize x cellSize RGBA image
+        std::vector<uint8_t> Cell(size_t index) const;
+    };
+
+    class Writer {
+    public:
+        explicit Writer(const std::string& patch);
+        void Add(const std::string& name, const std::vector<uint8_t>& bytes);
+        void AddAtlas(const std::string& name, const Atlas& atlas);
+        bool Save(const std::filesystem::path& path) const;
+
+    private:
+        struct Pending {
+            std::string name;
+            uint32_t size;
+            uint32_t crc;
+            std::vector<uint8_t> compressed;
+        };
+        std::string patch;
+        std::vector<Pending> entries;
+    };
+
+    bool Load(const std::filesystem::path& path);
+    // Reads an RCDATA resource of the running executable; false off Windows.
+    bool LoadEmbedded(int resourceId);
+
+    bool IsLoaded() const { return data != nullptr; }
+    const std::string& Patch() const { return patch; }
+    bool Has(const std::string& name) const;
+    bool Extract(const std::string& name, std::vector<uint8_t>& out) const;
+    bool ExtractAtlas(const std::string& name, Atlas& atlas) const;
+
+private:
+    struct Entry {
+        std::string name;
+        uint32_t offset;
+        uint32_t compressedSize;
+        uint32_t size;
+        uint32_t crc;
+    };
+
+    std::vector<uint8_t> owned;
+    const uint8_t* data = nullptr;       // owned, or the resource, which lives as long as the process
+    size_t size = 0;
+    std::string patch;
+    std::vector<Entry> entries;
+
+    bool Parse(const uint8_t* bytes, size_t length);
+};
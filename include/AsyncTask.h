@@ -0,0 +1,158 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "TaskPool.h"
+
+// Coroutine types over the task pools, so a loader that hops between threads
+// reads top to bottom:
+//
+//     std::string bytes = co_await FetchImage(url);       // I/O pool
+//     DecodedImage image = co_await DecodeImage(bytes);   // shared pool
+//     co_await ResumeOnMainThread();                      // GL upload
+//
+// AsyncTask<T> is a step that returns a value; it starts when awaited and
+// resumes its caller on whatever thread it finished on. AsyncJob is the top
+// of a chain and is started in an AsyncScope, which waits for its jobs.
+
+// Jobs that belong to one owner. Cancel marks the scope so jobs can stop at
+// their next step and waits for all of them to finish, running main thread
+// continuations meanwhile, so it must be called on the main thread.
+class AsyncScope {
+public:
+    AsyncScope() = default;
+    ~AsyncScope();
+
+    AsyncScope(const AsyncScope&) = delete;
+    AsyncScope& operator=(const AsyncScope&) = delete;
+
+    void Cancel();
+    bool IsCancelled() const { return cancelled; }
+
+    void Enter();
+    void Leave();
+
+private:
+    std::atomic<bool> cancelled{ false };
+    std::atomic<size_t> active{ 0 };
+    std::mutex doneMutex;
+    std::condition_variable done;
+};
+
+class AsyncJob {
+public:
+    struct promise_type {
+        AsyncScope* scope = nullptr;
+
+        AsyncJob get_return_object() { return AsyncJob(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept {
+            struct Finish {
+                bool await_ready() noexcept { return false; }
+                void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    // The frame goes first, so a scope that stops waiting owns nothing
+                    AsyncScope* scope = handle.promise().scope;
+                    handle.destroy();
+                    scope->Leave();
+                }
+                void await_resume() noexcept {}
+            };
+            return Finish{};
+        }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    AsyncJob(AsyncJob&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    AsyncJob& operator=(AsyncJob&&) = delete;
+    ~AsyncJob() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Runs the job on the calling thread up to its first hop
+    void Start(AsyncScope& scope);
+
+private:
+    explicit AsyncJob(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <typename T>
+class AsyncTask {
+public:
+    struct promise_type {
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;
+
+        AsyncTask get_return_object() { return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept {
+            struct Finish {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    return handle.promise().continuation;
+                }
+                void await_resume() noexcept {}
+            };
+            return Finish{};
+        }
+        template <typename U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    AsyncTask(AsyncTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    AsyncTask& operator=(AsyncTask&&) = delete;
+    ~AsyncTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+    T await_resume() {
+        if (handle.promise().error) {
+            std::rethrow_exception(handle.promise().error);
+        }
+        return std::move(*handle.promise().value);
+    }
+
+private:
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    std::coroutine_handle<promise_type> handle;
+};
+
+// co_await ResumeOn(pool) continues the coroutine as a task on the pool
+inline auto ResumeOn(TaskPool& pool, TaskPool::Priority priority = TaskPool::Priority::Normal) {
+    struct Hop {
+        TaskPool& pool;
+        TaskPool::Priority priority;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { pool.Submit([handle] { handle.resume(); }, priority); }
+        void await_resume() const noexcept {}
+    };
+    return Hop{ pool, priority };
+}
+
+// co_await ResumeOnMainThread() continues the coroutine in the next frame's
+// TaskPool::RunMainThreadTasks
+inline auto ResumeOnMainThread() {
+    struct Hop {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { TaskPool::PostToMain([handle] { handle.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+    return Hop{};
+}
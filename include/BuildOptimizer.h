@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "StatBlock.h"
+#include "TaskPool.h"
+
+// Searches item combinations for the best build by one metric, for one
+// champion at one level. Candidate stats are copied into per-stat columns and
+// the search is a depth-first branch and bound over combinations: every
+// top-level branch is a task, one chain of branch tasks per pool worker takes
+// them in order, and a subtree is cut as soon as its optimistic bound (the
+// partial build plus the largest remaining values of every stat) cannot beat
+// the current top results.
+// Results are published while the search runs.
+class BuildOptimizer {
+public:
+    enum class Metric : uint8_t {
+        EffectiveHealth,   // mixed effective HP, half physical half magic damage
+        DamagePerSecond,   // basic attack DPS against a target with targetArmor
+        GoldEfficiency,    // stat gold value / gold spent
+        Count
+    };
+    static const char* MetricName(Metric metric);
+
+    static constexpr int kMaxSlots = 6;
+
+    struct Request {
+        ChampionLevelStats champion;
+        Metric metric = Metric::EffectiveHealth;
+        int slots = kMaxSlots;
+        float goldBudget = 0.0f;              // 0 for no limit
+        std::vector<uint32_t> items;          // candidate item ordinals
+        std::vector<uint64_t> groups;         // unique-group bits per candidate, at most one item per bit
+        StatVector goldValues{};              // gold per stat point, for GoldEfficiency
+        float targetArmor = 100.0f;
+        size_t keep = 10;
+    };
+
+    struct Build {
+        std::array<uint32_t, kMaxSlots> items{};
+        int count = 0;
+        float score = 0.0f;
+        float cost = 0.0f;
+    };
+
+    struct Progress {
+        bool running = false;
+        uint64_t nodes = 0;
+        size_t branchesDone = 0;
+        size_t branchesTotal = 0;
+        double seconds = 0.0;
+        std::vector<Build> best;              // best first
+    };
+
+    BuildOptimizer() = default;
+    ~BuildOptimizer();
+
+    // Cancels any running search and starts a new one on the shared task pool.
+    void Start(const ItemStatTable& table, Request newRequest);
+    void Cancel();
+    Progress GetProgress() const;
+
+    // Score of a champion with the summed item stats and their total cost.
+    static float Evaluate(const Request& request, const StatVector& itemTotals, float cost);
+
+private:
+    Request request;
+    size_t candidateCount = 0;
+    std::array<std::vector<float>, kStatCount> stats;   // candidate stat columns, best single item first
+    std::vector<float> cost;
+    std::vector<uint64_t> groups;
+    std::vector<uint32_t> ordinals;
+    // suffixTop[(i * (kMaxSlots + 1) + k) * kStatCount + s]: sum of the k largest
+    // values of stat s among candidates i.. (the optimistic fill of k slots)
+    std::vector<float> suffixTop;
+    std::vector<float> suffixBestRatio;                // best value / cost among candidates i..
+    // Search tasks: the first two candidates of a build, second = UINT32_MAX
+    // for the single item build. Splitting two levels deep keeps the tasks
+    // small enough that all cores stay busy until the end.
+    std::vector<std::pair<uint32_t, uint32_t>> tasks;
+
+    TaskGroup search;
+    std::atomic<bool> stopping{ false };
+    std::atomic<size_t> nextTask{ 0 };
+    std::atomic<size_t> branchesDone{ 0 };
+    std::atomic<size_t> activeWorkers{ 0 };          // branch chains still running
+    std::atomic<uint64_t> nodes{ 0 };
+    std::atomic<float> threshold{ 0.0f };            // score to beat once best is full
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<double> finishedSeconds{ 0.0 };
+
+    mutable std::mutex resultMutex;
+    std::vector<Build> best;
+
+    void Prepare(const ItemStatTable& table);
+    void RunBranch();
+    bool Add(uint32_t candidate, int depth, Build& build, StatVector& totals, uint64_t& usedGroups, uint64_t& localNodes, bool offer = true);
+    void Expand(uint32_t candidate, int depth, Build& build, const StatVector& totals, uint64_t usedGroups, uint64_t& localNodes);
+    float Bound(size_t next, int remaining, const StatVector& totals, float spent) const;
+    void Offer(const Build& build);
+};
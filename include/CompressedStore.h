@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+
+// Texts kept deflated in memory and inflated on access. The first text
+// stored also seeds a preset zlib dictionary for all later ones, so the keys
+// and boilerplate that documents of one kind share cost next to nothing
+// after the first. Not thread-safe; the owner locks around it.
+class CompressedStore {
+public:
+    void Put(const std::string& key, std::string_view text);
+    // Inflates the text for key into text; false if there is none
+    bool Get(const std::string& key, std::string& text) const;
+    bool Contains(const std::string& key) const { return entries.count(key) > 0; }
+
+    size_t Size() const { return entries.size(); }
+    size_t StoredBytes() const { return storedBytes; }   // compressed, dictionary included
+    size_t TextBytes() const { return textBytes; }       // what it would take inflated
+
+private:
+    struct Entry {
+        uint32_t size = 0;
+        std::vector<uint8_t> compressed;
+    };
+    std::unordered_map<std::string, Entry> entries;
+    std::string dictionary;
+    size_t storedBytes = 0;
+    size_t textBytes = 0;
+};
+
+// The most recently used values by key, up to a fixed count. Not thread-safe.
+template <typename Key, typename Value>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity) : capacity(capacity) {}
+
+    // nullptr if absent; a hit becomes the most recent entry
+    const Value* Get(const Key& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        order.splice(order.begin(), order, it->second);
+        return &it->second->second;
+    }
+
+    // Keeps an existing value and returns it, so racing loaders agree on one
+    const Value& Put(const Key& key, Value value) {
+        if (const Value* existing = Get(key)) {
+            return *existing;
+        }
+        order.emplace_front(key, std::move(value));
+        index[key] = order.begin();
+        if (order.size() > capacity) {
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+        return order.front().second;
+    }
+
+    void Clear() {
+        order.clear();
+        index.clear();
+    }
+
+private:
+    size_t capacity;
+    std::list<std::pair<Key, Value>> order;   // most recent first
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> index;
+};
@@ -3,24 +3,94 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <string_view>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 #include <httplib.h>
 #include <curl/curl.h>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <filesystem>
+#include "SearchIndex.h"
+#include "TextIndex.h"
+#include "TaskPool.h"
+#include "AsyncTask.h"
+#include "FacetIndex.h"
+#include "RecipeGraph.h"
+#include "StatBlock.h"
+#include "GoldEfficiency.h"
+#include "StatCurves.h"
+#include "AbilityTable.h"
+#include "DatasetSnapshot.h"
+#include "AssetBundle.h"
+#include "PatchHistory.h"
+#include "Arena.h"
+#include "Symbols.h"
+#include "CompressedStore.h"
+#include "LocaleStrings.h"
+#include "DatasetRegistry.h"
 
+// Getters read the UI thread's view of the data (see Refresh) and may only be
+// called from that thread; other threads take a Dataset with GetDataset().
 class DataManager {
 public:
     DataManager();
+    ~DataManager();
+
+    // Parser for the items catalog and champion detail files. OnDemand reads
+    // only the fields the app uses; Nlohmann builds the whole tree and is kept
+    // to compare against. Takes effect from the next fetch. Item content
+    // hashes differ between the two, so the first item fetch after a switch
+    // counts every item as changed and drops its cached icon.
+    enum class JsonBackend { Nlohmann, OnDemand };
+    void SetJsonBackend(JsonBackend backend) { jsonBackend = backend; }
+
+    // Display language as a Data Dragon locale such as "ko_KR". Stats, ids
+    // and images are shared by every locale; switching fetches only the
+    // locale's champion and summoner spell text, cached per patch, on the I/O
+    // pool and publishes it. Items stay en_US, the only meraki catalog.
+    struct Locale {
+        const char* code;
+        const char* name;   // in its own language
+    };
+    static const std::vector<Locale>& GetLocales();
+    void SetLocale(const std::string& locale);
+    const std::string& GetLocale() const;   // of the view
+    const LocaleStrings* GetLocaleStrings() const;   // nullptr for en_US
+    bool IsLocaleLoading() const { return localeLoads.Busy(); }
+
+    // Every data domain is a dataset module (see RegisterModules) loaded on
+    // first use. RequestModule starts a load on the I/O pool and tells how
+    // far it got; LoadModule loads on the calling thread, off the UI thread.
+    // PrefetchModules loads the ones the UI will want once nothing else runs.
+    DatasetRegistry::State RequestModule(const std::string& name) const;
+    bool LoadModule(const std::string& name);
+    DatasetRegistry::State RetryModule(const std::string& name);
+    void PrefetchModules();
+    // Skips the queued loads and waits for the running ones, so nothing is
+    // downloading when the owner tears down curl. For shutdown, once the UI
+    // asks for nothing more.
+    void CancelLoads();
+
     // Champion window related functions
-    bool FetchChampionData();
     bool FetchSpecificChampionData(const std::string& championId) const;  // Now const
+    // The same details without blocking: downloaded on the I/O pool unless fetched before
+    AsyncTask<std::shared_ptr<const nlohmann::json>> FetchChampionDetailsAsync(std::string championId) const;
     const std::vector<std::string>& GetChampionNames() const;
     std::string GetChampionId(const std::string& championName) const;
+    std::string GetChampionNameById(const std::string& championId) const;
     std::string GetChampionImageUrl(const std::string& championId) const;
     std::string GetChampionIconUrl(const std::string& championId) const;
     nlohmann::json GetChampionStats(const std::string& championName) const;
+    ChampionLevelStats GetChampionLevelStats(uint32_t ordinal, int level) const;   // by index into GetChampionNames()
     std::string GetChampionTitle(const std::string& championName) const;
     std::string GetChampionLore(const std::string& championName) const;
     std::vector<std::string> GetChampionTags(const std::string& championName) const;
+    nlohmann::json GetChampionInfo(const std::string& championName) const;   // attack / defense / magic / difficulty ratings
     nlohmann::json GetChampionSpells(const std::string& championName) const;
     nlohmann::json GetChampionPassive(const std::string& championName) const;
     nlohmann::json GetChampionData(const std::string& championId) const;
@@ -28,17 +98,34 @@ public:
     std::string GetChampionSkinImageUrl(const std::string& championId, const std::string& skinNum) const;
     std::vector<std::string> GetChampionAllyTips(const std::string& championName) const;
     std::vector<std::string> GetChampionEnemyTips(const std::string& championName) const;
+    // Facets "Role" and "Resource", by index into GetChampionNames()
+    const FacetIndex& GetChampionFacets() const;
+    // Level 1-18 stat curves by index into GetChampionNames(), nullptr before champions load
+    const StatCurves::Table* GetStatCurves() const;
+    // Per-rank cooldown, cost, range and effect numbers of every champion ability,
+    // from championFull.json (cached in the cache directory per patch); the
+    // "abilities" module
+    const AbilityTable& GetAbilityTable() const;
 
     // Item window related functions
-    bool FetchItemData();
     bool FetchSpecificItemData(const std::string& itemId) const;
     const std::vector<std::string>& GetItemNames() const;
     std::vector<std::string> GetItemsByTag(const std::string& tag) const;
     std::string GetItemId(const std::string& itemName) const;
     std::string GetSpecificItemName(const std::string& itemId) const;
     std::string GetItemDescription(const std::string& itemId) const;
-    std::vector<std::string> GetItemBuildsFrom(const std::string& itemId) const;
-    std::vector<std::string> GetItemBuildsInto(const std::string& itemId) const;
+    // Direct recipe edges as item ordinals, see GetRecipeGraph for the rollups
+    RecipeGraph::Range GetItemBuildsFrom(const std::string& itemId) const;
+    RecipeGraph::Range GetItemBuildsInto(const std::string& itemId) const;
+    const RecipeGraph& GetRecipeGraph() const;
+    int GetItemOrdinal(const std::string& itemId) const;
+    const std::string& GetItemIdAt(uint32_t ordinal) const;
+    // Parsed item stats by ordinal, and the finished items the build optimizer may pick
+    const ItemStatTable& GetItemStatTable() const;
+    const std::vector<uint32_t>& GetBuildCandidates() const;
+    uint64_t GetItemGroupMask(uint32_t ordinal) const;   // unique groups, one bit each
+    // Fitted stat prices and per-item gold efficiency for the current patch, nullptr before items load
+    const GoldEfficiency::Result* GetGoldEfficiency() const;
     std::string GetItemImageUrl(const std::string& itemId) const;
     int GetItemCost(const std::string& itemId) const;
     int GetItemSellPrice(const std::string& itemId) const;
@@ -50,47 +137,271 @@ public:
     std::vector<std::string> GetAllItemIds() const;
     std::string GetItemIdFromIconUrl(const std::string& url) const;
     bool ItemExists(const std::string& itemId) const;
+    // Facets "Role", "Tag", "Price" and "Availability", by index into GetItemNames()
+    const FacetIndex& GetItemFacets() const;
+    std::vector<std::string> GetItemsMatching(const FacetIndex::Filter& filter) const;
 
     // Summoner spell window related functions
     struct GameMode {
         std::string mode;
         std::string description;
     };
-    bool FetchGameModes();
     const std::vector<GameMode>& GetGameModes() const;
     struct SummonerSpell {
         std::string id;
         std::string name;
         std::string description;
-        std::vector<std::string> modes;
+        std::vector<Symbol> modes;
         std::string cooldownBurn;
+        std::vector<float> cooldown;   // seconds, by rank
         int summonerLevel;
     };
-    bool FetchSummonerSpells();
     const std::vector<SummonerSpell>& GetSummonerSpells() const;
-    std::vector<SummonerSpell> GetSummonerSpellsForMode(const std::string& mode) const;
+    // Indices into GetSummonerSpells() of the spells usable in the mode
+    std::vector<uint32_t> GetSummonerSpellsForMode(const std::string& mode) const;
 
+    // Runes, profile icons and maps, each loaded the first time it is read
+    // and empty until then
+    struct Rune {
+        int id;
+        std::string key;
+        std::string name;
+        std::string tree;        // e.g. "Precision"
+        int slot;                // row in the tree, 0 for keystones
+        std::string icon;        // path under ddragon's cdn/img/
+        std::string shortDesc;
+    };
+    const std::vector<Rune>& GetRunes() const;
+    const Rune* FindRune(int runeId) const;
+    const std::vector<int>& GetProfileIconIds() const;
+    std::string GetProfileIconUrl(int iconId) const;
+    struct MapInfo {
+        std::string id;
+        std::string name;
+    };
+    const std::vector<MapInfo>& GetMaps() const;
+
+    // Name search across champions, items, summoner spells and game modes
+    const SearchIndex& GetSearchIndex() const;
+
+    // Full-text search over lore, abilities, tips and item descriptions
+    std::vector<TextIndex::Hit> SearchText(const std::string& query, size_t maxResults) const;
+    const TextIndex& GetTextIndex() const;
 
+    // Icons packed into the executable, keyed "champion/<id>", "item/<id>" or
+    // "spell/<id>": square RGBA pixels. False if the bundle has no such icon,
+    // or it is of another patch and the entity has changed since
+    bool GetBundledIcon(const std::string& key, std::vector<uint8_t>& pixels, int& size) const;
+
+    // Champion and item stats of every patch seen, kept in cache/history.bin
+    const PatchHistory& GetPatchHistory() const;
+
+    // Processed data of one patch. A Dataset is built off to the side and
+    // published whole; nothing changes it afterwards, so a reader holding one
+    // sees a consistent view for as long as it keeps it. A publish shares the
+    // sections it leaves alone with the previous Dataset. Ids and names are
+    // interned, and the lookups from them are symbol-keyed flat tables.
+    struct ChampionSet {
+        DatasetSnapshot snapshot;
+        std::vector<std::string> names;
+        std::vector<std::string> ids;      // parallel to names
+        SymbolMap<uint32_t> byName;        // ordinals
+        SymbolMap<uint32_t> byId;
+        FacetIndex facets;
+        StatCurves curves;
+
+        // kNoOrdinal if there is no such champion
+        uint32_t Ordinal(std::string_view championId) const;
+        const DatasetSnapshot::ChampionRecord* Find(std::string_view championId) const;
+    };
+    static constexpr uint32_t kNoOrdinal = UINT32_MAX;
+    struct ItemSet {
+        Arena arena;                       // the json cache below, freed with the set
+        DatasetSnapshot snapshot;
+        std::vector<std::string> names;
+        std::vector<std::string> ids;      // parallel to names
+        SymbolMap<uint32_t> byName;        // ordinals
+        SymbolMap<uint32_t> byId;
+        SymbolMap<uint32_t> byIcon;        // icon url, for textures that only know their url
+        FacetIndex facets;
+        RecipeGraph recipeGraph;
+        ItemStatTable stats;
+        std::vector<uint64_t> groupMasks;
+        std::vector<std::string> groupNames;
+        std::vector<uint32_t> buildCandidates;
+        std::vector<uint32_t> basicItems;
+        GoldEfficiency goldEfficiency;
+        // Raw item json, parsed from the snapshot on first use. The only part
+        // that fills in after publishing, so it has its own lock, which also
+        // covers the arena from then on.
+        mutable std::mutex jsonMutex;
+        mutable std::pmr::map<std::pmr::string, nlohmann::json, std::less<>> json{ &arena };
+
+        uint32_t Ordinal(std::string_view itemId) const;
+        const DatasetSnapshot::ItemRecord* Find(std::string_view itemId) const;
+    };
+    struct SpellSet {
+        DatasetSnapshot snapshot;
+        std::vector<SummonerSpell> spells;
+        FacetIndex facets;
+    };
+    struct RuneSet {
+        std::vector<Rune> runes;
+        std::unordered_map<int, uint32_t> byId;
+    };
+    // The strings of a locale other than en_US laid over the champion and
+    // spell sets of a dataset
+    struct LocaleSet {
+        std::string locale;
+        std::shared_ptr<const LocaleStrings> strings;
+        std::vector<std::string> championNames;   // by champion ordinal
+        SymbolMap<uint32_t> championByName;
+        std::vector<SummonerSpell> spells;        // the spell set's, with this locale's text
+    };
+    struct Dataset {
+        std::shared_ptr<const ChampionSet> champions;
+        std::shared_ptr<const AbilityTable> abilities;   // by ordinal of champions
+        std::shared_ptr<const ItemSet> items;
+        std::shared_ptr<const SpellSet> spells;
+        std::shared_ptr<const std::vector<GameMode>> gameModes;
+        std::shared_ptr<const RuneSet> runes;
+        std::shared_ptr<const std::vector<int>> profileIcons;
+        std::shared_ptr<const std::vector<MapInfo>> maps;
+        std::shared_ptr<const PatchHistory> history;
+        std::shared_ptr<const LocaleSet> locale;   // nullptr for en_US
+        SearchIndex search;
+    };
+
+    // The newest published dataset; safe from any thread
+    std::shared_ptr<const Dataset> GetDataset() const;
+    // Moves the UI thread's view to the newest dataset. The getters read the
+    // view, so the references they return stay valid until the next Refresh.
+    // Called once per frame before anything is drawn.
+    void Refresh();
+
+    // The last patch seen until versions.json has been read in the background,
+    // then the newest one; the data reloads when it changes. Any thread.
+    std::string GetPatchVersion() const;
+    std::string GetDataDragonUrl(const std::string& path) const;   // e.g. "img/spell/SummonerFlash.png"
+    // Downloaded images kept on disk across patches until their entity changes
+    bool ReadCachedImage(const std::string& url, std::string& bytes) const;
+    void StoreCachedImage(const std::string& url, const std::string& bytes) const;
 
 private:
+    // httplib serializes the requests of one client, so these may be shared
+    // by threads; long background jobs open their own connection instead
     mutable httplib::Client client;
-    nlohmann::json championData;
-    mutable std::map<std::string, nlohmann::json> specificChampionData;  // Now mutable
-    std::vector<std::string> championNames;
-    std::map<std::string, std::string> championNameToIdMap;
+    mutable httplib::Client itemClient;
 
-    void ProcessChampionData();
+    // Writers build the next Dataset from a copy of the newest one under
+    // publishMutex and swap it in with an atomic store. Readers only ever
+    // load the pointer, and an old Dataset is freed with its last reader.
+    std::atomic<std::shared_ptr<const Dataset>> published;
+    std::mutex publishMutex;
+    std::shared_ptr<const Dataset> view;   // UI thread only
+    void Publish(const std::function<void(Dataset&)>& update);
 
-    mutable httplib::Client itemClient;
-    mutable nlohmann::json itemData;
-    mutable std::map<std::string, nlohmann::json> specificItemData;
-    mutable std::vector<std::string> itemNames;
-    mutable std::map<std::string, std::string> itemNameToIdMap;
-    const std::set<std::string> validTags = { "FIGHTER", "ASSASSIN", "MARKSMAN", "MAGE", "TANK", "SUPPORT" };
+    // Champion details by id, downloaded on demand and shared by every dataset.
+    // Every one fetched is kept as deflated text, and the last few used are
+    // also kept parsed.
+    mutable std::mutex detailMutex;
+    mutable LruCache<std::string, std::shared_ptr<const nlohmann::json>> championDetails{ 8 };
+    mutable CompressedStore championDetailTexts;
+    std::shared_ptr<const nlohmann::json> FetchChampionDetails(const std::string& championId, const std::string& locale) const;
+    nlohmann::json GetChampionDetail(const std::string& championName, const char* key) const;
+    const nlohmann::json* FetchItemJson(const ItemSet& items, const std::string& itemId) const;
+
+    // Module loaders: each fetches its documents, builds its section and
+    // indices and publishes them. Only the registry calls them.
+    void RegisterModules();
+    bool FetchChampionData();
+    bool FetchAbilityData();
+    bool FetchItemData();
+    bool FetchGameModes();
+    bool FetchSummonerSpells();
+    bool FetchRunes();
+    bool FetchProfileIcons();
+    bool FetchMaps();
+    // A json document by url, kept under cache/data per patch
+    bool LoadDocument(const std::string& url, const std::string& name, std::string& body) const;
+    std::filesystem::path DocumentPath(const std::string& name) const;
+
+    void ProcessChampionData(ChampionSet& champions) const;
+    void BuildAbilityTable(AbilityTable& abilities, const ChampionSet& champions, const nlohmann::json& championFull) const;
+    void ProcessItemData(ItemSet& items) const;
+    void BuildRecipeGraph(ItemSet& items) const;
+    void BuildItemStats(ItemSet& items) const;
+    void ProcessSummonerSpells(SpellSet& spells) const;
+    void IngestHistory(Dataset& next, PatchHistory::Kind kind, const std::string& patch, const std::vector<std::string>& ids, const std::vector<float>& values);
+
+    // The locale last asked for, and the one published with its strings;
+    // publishedLocale and publishedStrings change only inside Publish
+    mutable std::mutex localeMutex;
+    std::string requestedLocale = "en_US";
+    std::map<std::string, std::shared_ptr<const LocaleStrings>> localeTables;
+    std::string publishedLocale = "en_US";
+    std::shared_ptr<const LocaleStrings> publishedStrings;
+    TaskGroup localeLoads{ TaskPool::Io() };
+    std::shared_ptr<const LocaleStrings> LoadLocaleStrings(const std::string& locale);
+    void ApplyLocale(Dataset& next) const;
+
+    // Data Dragon patch every URL and cache entry is built from
+    static constexpr const char* kDefaultPatch = "14.14.1";   // when versions.json can't be read
+    mutable std::mutex patchMutex;
+    std::string patchVersion;   // under patchMutex once the check runs
+    std::filesystem::path cacheDirectory;
+    AssetBundle bundle;
+    mutable std::once_flag iconAtlasOnce;
+    mutable AssetBundle::Atlas iconAtlas;
+    mutable std::unordered_map<std::string, uint32_t> iconCells;
+    mutable std::unordered_map<std::string, uint64_t> bundledHashes;   // content hash by icon key
+    void IndexBundledHashes() const;
+    bool IsBundledIconCurrent(const std::string& key) const;
+    // Full-text index, persisted under cache/ and keyed by the data patch
+    mutable TextIndex textIndex;
+    TaskGroup detailPrefetch{ TaskPool::Io() };
+    std::atomic<bool> detailPrefetchStarted{ false };
+    std::atomic<bool> stopDetailPrefetch{ false };
+
+    // One file per patch, so a snapshot a live set still maps is never
+    // replaced; older patches' files go once nothing maps them
+    std::filesystem::path SnapshotPath(const char* name, const std::string& patch) const;
+    std::vector<std::filesystem::path> OlderSnapshots(const char* name, const std::string& patch) const;
+    void PruneSnapshots(const char* name, const std::string& patch);
+    bool StoreSnapshot(DatasetSnapshot& snapshot, DatasetSnapshot::Kind kind, const char* name, const std::string& patch, std::vector<uint8_t> image);
+    bool RestoreBundledSnapshot(DatasetSnapshot& snapshot, DatasetSnapshot::Kind kind, const char* name, const std::string& patch);
+
+    // Patch updates: what the replaced snapshot held, and the cache entries
+    // of everything that changed since
+    struct PreviousEntity {
+        uint64_t contentHash;
+        std::string icon;
+    };
+    // Startup uses the last patch seen; CheckPatchVersion then asks
+    // versions.json in the background and reloads the loaded modules if it moved
+    void LoadCachedPatchVersion();
+    void CheckPatchVersion();
+    std::unordered_map<std::string, PreviousEntity> ReadPreviousSnapshot(DatasetSnapshot::Kind kind, const char* name, const std::string& patch, bool& known) const;
+    void InvalidateChangedImages(DatasetSnapshot::Kind kind, const DatasetSnapshot& current,
+        const std::unordered_map<std::string, PreviousEntity>& previous, bool knownPrevious);
+    std::filesystem::path ImageCachePath(const std::string& url) const;
+    std::filesystem::path DetailCachePath(const std::string& championId, const std::string& locale) const;
+    std::filesystem::path LocaleCachePath(const std::string& locale) const;
+    std::filesystem::path ChampionFullPath() const;
+    bool LoadChampionFull(httplib::Client& source, std::string& body) const;
+    void VerifyDetailCache(const nlohmann::json& champions);
+    std::atomic<bool> detailCacheVerified{ false };
+    std::atomic<bool> reindexDetails{ false };
+    // Shared by reads and writes of cached details and images, held alone
+    // by the passes that remove the ones a new patch changed
+    mutable std::shared_mutex cacheFilesMutex;
+    std::atomic<JsonBackend> jsonBackend{ JsonBackend::OnDemand };
 
-    void ProcessItemData();
+    void IndexChampionSummaries(const ChampionSet& champions);
+    void IndexItems(const ItemSet& items);
+    void StartDetailPrefetch(const ChampionSet& champions);
 
-    // Summoner spell window related
-    std::vector<GameMode> gameModes;
-    std::vector<SummonerSpell> summonerSpells;
+    // Last, so they are destroyed first: their loads use everything above
+    mutable DatasetRegistry modules{ TaskPool::Io() };
+    TaskGroup patchCheck{ TaskPool::Io() };
 };
\ No newline at end of file
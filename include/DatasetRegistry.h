@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "TaskPool.h"
+
+// Data domains as modules that load on first use. A module names the
+// documents it reads, the modules it builds on, and a loader that fetches and
+// parses them, builds its indices and publishes the result. Registering loads
+// nothing: Request queues a load, Ensure runs one on the calling thread and
+// Prefetch queues the rest behind all other work, so a new domain adds
+// nothing to startup.
+class DatasetRegistry {
+public:
+    enum class State { Idle, Queued, Loading, Ready, Failed };
+
+    struct Module {
+        std::string name;
+        // Documents read, for the log; asked for when logging, so URLs
+        // built from the patch name the one that failed
+        std::function<std::vector<std::string>()> sources;
+        std::vector<std::string> needs;     // modules loaded before this one
+        std::function<bool()> load;         // false on failure
+        bool prefetch = true;               // loaded by Prefetch
+    };
+
+    explicit DatasetRegistry(TaskPool& pool) : loads(pool) {}
+
+    // All modules are registered before the first Request
+    void Register(Module module);
+
+    // Queues the module's load if nothing has, and returns its state. A
+    // failed module stays failed until Retry. Cheap enough for every frame.
+    State Request(const std::string& name, TaskPool::Priority priority = TaskPool::Priority::High);
+    // Loads the module and what it needs on the calling thread, or waits for
+    // the thread loading it; true once it is Ready. Not on the UI thread.
+    bool Ensure(const std::string& name);
+    // Lets a failed module, and the failed ones it needs, load again
+    State Retry(const std::string& name);
+    // For a module whose data was dropped: the next Request loads it again.
+    // One loading now settles as Idle, since it read what was replaced.
+    void Invalidate(const std::string& name);
+    // After the sources moved, e.g. to a new patch: every module that loaded
+    // or failed is queued again, and one loading now once it finishes. The
+    // data published before stays until each module replaces its own.
+    void Reload();
+    State GetState(const std::string& name) const;
+
+    // Queues every prefetch module at background priority
+    void Prefetch();
+    // For shutdown: skips the queued loads and waits for the running ones
+    void Cancel() { loads.Cancel(); }
+
+private:
+    struct Entry {
+        Module module;
+        State state = State::Idle;
+        TaskPool::Priority queuedAt = TaskPool::Priority::Background;
+        bool stale = false;    // invalidated while loading
+        bool reload = false;   // and queued again once it settles
+    };
+    // Under mutex; nullptr for an unknown name
+    Entry* Find(const std::string& name);
+    void ResetFailed(const std::string& name);
+
+    std::unordered_map<std::string, Entry> entries;
+    std::vector<std::string> order;   // of registration
+    mutable std::mutex mutex;
+    std::condition_variable settled;
+    TaskGroup loads;
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+#include <type_traits>
+#include <cstdint>
+#include "MappedFile.h"
+#include "StatBlock.h"
+#include "JsonView.h"
+
+// Processed champion, item or summoner spell data as one flat binary file:
+// a header, a section table and the sections themselves (string pool, one
+// fixed-size record table, string lists and floats). Records point into the
+// other sections by offset, so a snapshot is used straight from the mapped
+// file with no parse step. Every section carries a CRC-32 and the header
+// carries the patch it was built from; a snapshot that fails either check
+// is rejected and rebuilt from the network. Little-endian only.
+class DatasetSnapshot {
+public:
+    enum class Kind : uint32_t {
+        Champions = 1,
+        Items = 2,
+        SummonerSpells = 3
+    };
+
+    struct StringRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    // A run of StringRefs in the list section
+    struct ListRef {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    struct ChampionRecord {
+        StringRef id, name, title, blurb, partype;
+        StringRef source;                    // the champion.json entry, for raw json accessors
+        uint64_t contentHash;                // of the entry without its "version", to diff patches
+        ListRef tags;
+        float info[4];                       // attack, defense, magic, difficulty
+        ChampionBaseStats stats;
+    };
+
+    enum ItemFlags : uint32_t {
+        kItemHasShop = 1,
+        kItemPurchasable = 2,
+        kItemRestricted = 4,                 // champion or ally requirement, or removed
+        kItemHasDescription = 8
+    };
+
+    struct ItemRecord {
+        StringRef id, name, description, icon;
+        StringRef source;                    // the items.json entry
+        uint64_t contentHash;
+        ListRef shopTags, ranks;
+        ListRef uniquePassives;              // names of the item's unique passives
+        ListRef components;                  // item ids it builds from
+        int32_t cost = -1;                   // -1 when the shop lists no total
+        int32_t sell = -1;
+        uint32_t flags = 0;
+        StatVector stats;
+    };
+
+    struct SpellRecord {
+        StringRef id, name, description, cooldownBurn;
+        StringRef source;
+        uint64_t contentHash;
+        ListRef modes;
+        uint32_t firstCooldown = 0;          // run of seconds by rank in the float section
+        uint32_t cooldownCount = 0;
+        int32_t summonerLevel = 0;
+    };
+
+    static_assert(std::is_trivially_copyable<ChampionRecord>::value, "records are copied as bytes");
+    static_assert(std::is_trivially_copyable<ItemRecord>::value, "records are copied as bytes");
+    static_assert(std::is_trivially_copyable<SpellRecord>::value, "records are copied as bytes");
+
+    // Collects records and produces the file image.
+    class Builder {
+    public:
+        Builder(Kind kind, const std::string& patch);
+
+        StringRef Intern(std::string_view text);   // equal strings share storage
+        ListRef AddList(const std::vector<std::string>& strings);
+        uint32_t AddFloats(const std::vector<float>& values);
+
+        void Add(const ChampionRecord& record);
+        void Add(const ItemRecord& record);
+        void Add(const SpellRecord& record);
+
+        std::vector<uint8_t> Finish() const;
+
+    private:
+        Kind kind;
+        std::string patch;
+        std::string strings;
+        struct TextHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+        };
+        std::unordered_map<std::string, StringRef, TextHash, std::equal_to<>> internedStrings;
+        std::vector<StringRef> lists;
+        std::vector<float> floats;
+        std::vector<uint8_t> records;
+        uint32_t recordCount = 0;
+    };
+
+    // Images built from the source documents: the ddragon champion.json and
+    // summoner.json, and the meraki items.json. Throws on malformed json.
+    static std::vector<uint8_t> BuildChampions(const nlohmann::json& document, const std::string& patch);
+    static std::vector<uint8_t> BuildItems(const nlohmann::json& document, const std::string& patch);
+    static std::vector<uint8_t> BuildSummonerSpells(const nlohmann::json& document, const std::string& patch);
+    // items.json read on demand: only the fields the records hold are
+    // decoded, and each record's source is its entry's text as downloaded.
+    static std::vector<uint8_t> BuildItems(std::string_view text, const std::string& patch);
+
+    // FNV-1a of a json entry without its "version", which changes every patch
+    static uint64_t ContentHash(nlohmann::json entry);
+    // The same over the entry's text as written. Hashes from the two differ,
+    // so switching parsers marks every entry changed once.
+    static uint64_t ContentHash(const JsonView& entry);
+
+    DatasetSnapshot() = default;
+    DatasetSnapshot(const DatasetSnapshot&) = delete;
+    DatasetSnapshot& operator=(const DatasetSnapshot&) = delete;
+
+    // Maps the file and validates it against the kind and patch; an empty
+    // patch accepts a snapshot of any patch, see Patch().
+    bool Open(const std::filesystem::path& path, Kind kind, const std::string& patch);
+    // Uses an in-memory image, e.g. when the file could not be written.
+    bool Adopt(std::vector<uint8_t> image, Kind kind, const std::string& patch);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+    const std::string& Patch() const { return patch; }
+
+    // Writes an image through a temporary file so a crash never leaves a torn snapshot.
+    static bool Write(const std::filesystem::path& path, const std::vector<uint8_t>& image);
+
+    size_t Size() const { return recordCount; }
+    const ChampionRecord& Champion(size_t index) const;
+    const ItemRecord& Item(size_t index) const;
+    const SpellRecord& Spell(size_t index) const;
+
+    std::string_view View(StringRef ref) const;
+    std::string String(StringRef ref) const { return std::string(View(ref)); }
+    std::string_view ListAt(ListRef list, uint32_t index) const;
+    std::vector<std::string> Strings(ListRef list) const;
+    const float* Floats(uint32_t first, uint32_t count) const;
+
+private:
+    MappedFile file;
+    std::vector<uint8_t> owned;
+    const uint8_t* base = nullptr;
+    Kind kind = Kind::Champions;
+    std::string patch;
+    size_t recordCount = 0;
+
+    const char* strings = nullptr;
+    size_t stringsSize = 0;
+    const uint8_t* records = nullptr;
+    const StringRef* lists = nullptr;
+    size_t listCount = 0;
+    const float* floats = nullptr;
+    size_t floatCount = 0;
+
+    bool Validate(const uint8_t* data, size_t size, Kind expectedKind, const std::string& expectedPatch);
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "StatBlock.h"
+#include "TaskPool.h"
+
+// Auto-attack time to kill for every ordered champion pair. Each champion is
+// reduced to the few numbers a basic attack duel needs; the matrix remembers
+// the inputs it was computed from, so an update only recomputes the rows and
+// columns of champions whose inputs changed. Rows run in parallel on a
+// TaskPool.
+class DuelMatrix {
+public:
+    struct Fighter {
+        float health = 0.0f;
+        float armor = 0.0f;
+        float healthRegen = 0.0f;       // per second
+        float attackDamage = 0.0f;
+        float attackSpeed = 0.0f;       // attacks per second, capped
+        float critChance = 0.0f;        // 0 - 1
+        float lethality = 0.0f;
+        float armorPenPercent = 0.0f;   // 0 - 1
+
+        bool operator==(const Fighter& other) const;
+        bool operator!=(const Fighter& other) const { return !(*this == other); }
+    };
+
+    // A champion at a level carrying items with the summed stats.
+    static Fighter MakeFighter(const ChampionLevelStats& champion, const StatVector& itemTotals);
+    // Seconds for attacker to kill defender with basic attacks, the first
+    // landing at 0; infinity if the defender out-regenerates the damage.
+    static float TimeToKill(const Fighter& attacker, const Fighter& defender);
+
+    // Brings the matrix up to date with fighters (by champion ordinal) and
+    // returns how many cells were recomputed.
+    size_t Update(const std::vector<Fighter>& newFighters, TaskPool& pool);
+
+    size_t Size() const { return fighters.size(); }
+    float Get(uint32_t attacker, uint32_t defender) const { return ttk[attacker * fighters.size() + defender]; }
+    // Changes with every update that recomputed anything.
+    uint64_t Version() const { return version; }
+
+private:
+    std::vector<Fighter> fighters;
+    std::vector<float> ttk;   // row = attacker, column = defender
+    uint64_t version = 0;
+};
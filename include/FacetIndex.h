@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <cstdint>
+
+// Bitmap index over one entity list (champions, items or summoner spells).
+// Every entity is addressed by its dense ordinal in the owning list and every
+// facet value ("Role" = "MAGE", "Price" = "2000 - 2499", ...) keeps one bit per
+// entity, so combined filters and per-value counts are a few word-wide ANDs,
+// ORs and popcounts instead of walking the json.
+class FacetIndex {
+public:
+    class Bitmap {
+    public:
+        Bitmap() = default;
+        explicit Bitmap(size_t bits, bool filled = false);
+
+        void Set(size_t bit) { words[bit >> 6] |= uint64_t(1) << (bit & 63); }
+        bool Test(size_t bit) const { return bit < bits && (words[bit >> 6] >> (bit & 63)) & 1; }
+        size_t Size() const { return bits; }
+        size_t Count() const;
+        std::vector<uint32_t> ToOrdinals() const;
+
+        Bitmap& operator&=(const Bitmap& other);
+        Bitmap& operator|=(const Bitmap& other);
+        static size_t CountAnd(const Bitmap& a, const Bitmap& b);
+
+    private:
+        std::vector<uint64_t> words;
+        size_t bits = 0;
+    };
+
+    // Selected values of one facet, ORed unless matchAll is set.
+    struct Selection {
+        std::set<std::string> values;
+        bool matchAll = false;
+    };
+    // Selections by facet name. Facets are always ANDed.
+    using Filter = std::map<std::string, Selection>;
+
+    // Drops every facet and sizes new bitmaps for entityCount ordinals.
+    void Reset(size_t entityCount);
+    void Add(const std::string& facet, const std::string& value, uint32_t ordinal);
+    // Registers values up front so they are listed in this order, even if empty.
+    void Declare(const std::string& facet, const std::vector<std::string>& values);
+
+    // Facets and values are listed in the order they were first added.
+    const std::vector<std::string>& GetFacets() const { return facetNames; }
+    const std::vector<std::string>& GetValues(const std::string& facet) const;
+    const Bitmap* Find(const std::string& facet, const std::string& value) const;
+    std::vector<std::string> GetValuesFor(const std::string& facet, uint32_t ordinal) const;
+
+    // Entities matching the filter. skipFacet leaves one facet's selection out.
+    Bitmap Evaluate(const Filter& filter, const std::string& skipFacet = "") const;
+    // Live count for every value of facet (in GetValues order): how many entities
+    // would match if that value were selected. For an OR facet the facet's own
+    // selection is left out of the base; for a matchAll facet it narrows it.
+    std::vector<size_t> Counts(const Filter& filter, const std::string& facet) const;
+
+    size_t Size() const { return entityCount; }
+
+private:
+    struct Facet {
+        std::vector<std::string> values;
+        std::vector<Bitmap> bitmaps;
+        std::unordered_map<std::string, uint32_t> valueIds;
+    };
+
+    size_t entityCount = 0;
+    std::vector<std::string> facetNames;
+    std::vector<Facet> facets;
+    std::unordered_map<std::string, uint32_t> facetIds;
+
+    Facet& GetOrAddFacet(const std::string& facet);
+    const Facet* FindFacet(const std::string& facet) const;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "imgui.h"
+
+// The UI face in ImGui's font atlas at a few sizes. The rasterized default
+// ranges are kept on disk, so a normal startup only reads the pixels back.
+// Glyphs outside them are rasterized with FreeType as text needs them and
+// packed into spare pages reserved in the same texture, so adding a few
+// doesn't rebuild the atlas. UI thread only, outside NewFrame/Render.
+class GlyphCache {
+public:
+    // The atlas holds one font per size, in this order
+    GlyphCache(std::string fontFile, std::vector<float> sizes);
+
+    // Fills atlas with the default ranges, from cacheFile when it was baked
+    // from the same font files, otherwise rasterized and written there.
+    // fallbacks supply glyphs the face lacks. False if the face can't be loaded.
+    bool Load(ImFontAtlas* atlas, const std::filesystem::path& cacheFile, const std::vector<std::string>& fallbacks);
+
+    // Rasterizes glyphs into the spare pages and uploads the rows they land
+    // on; ones no font file has are skipped. False when the pages are full.
+    bool Add(ImFontAtlas* atlas, const std::vector<ImWchar>& glyphs, const std::vector<std::string>& fallbacks);
+
+    // Bakes the default ranges plus glyphs with empty spare pages again, and
+    // recreates the texture
+    bool Rebuild(ImFontAtlas* atlas, const std::vector<ImWchar>& glyphs, const std::vector<std::string>& fallbacks);
+
+private:
+    struct Page {
+        int x = 0;
+        int y = 0;
+    };
+
+    bool Bake(ImFontAtlas* atlas, const ImWchar* ranges, const std::vector<std::string>& fallbacks);
+    bool ReadBaked(ImFontAtlas* atlas, const std::filesystem::path& path, uint64_t key);
+    bool WriteBaked(const ImFontAtlas* atlas, const std::filesystem::path& path, uint64_t key) const;
+    // Changes when any font file or the bake settings change
+    uint64_t SourceKey(const std::vector<std::string>& fallbacks) const;
+    // Shelf packing over the spare pages; false when none has room left
+    bool Place(int width, int height, int& x, int& y);
+
+    std::string fontFile;
+    std::vector<float> sizes;
+    std::vector<Page> pages;
+    size_t page = 0;       // being filled
+    int penX = 0;
+    int penY = 0;
+    int shelfHeight = 0;
+};
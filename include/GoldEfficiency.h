@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "StatBlock.h"
+
+// Gold efficiency of every item: the gold value of its stats at per-stat
+// prices, divided by its cost. Prices are fitted by least squares from the
+// basic component items (which are priced almost purely by their stats),
+// pulled towards BaselineGoldValues so stats no basic item carries keep a
+// sensible price. Computed once per item set, which is rebuilt on a new patch.
+class GoldEfficiency {
+public:
+    struct Result {
+        StatVector prices{};
+        std::array<bool, kStatCount> fitted{};   // price came from the basic items, not the baseline
+        std::vector<float> value;                 // gold value of each item's stats, by item ordinal
+        std::vector<float> efficiency;            // value / cost in percent, 0 for free items
+        size_t basicItemCount = 0;
+        float rmsError = 0.0f;                    // fit error over the basic items, in gold
+    };
+
+    // Fits prices and evaluates the whole table, replacing the last result.
+    const Result& Compute(const ItemStatTable& table, const std::vector<uint32_t>& basicItems);
+    // The last result, or nullptr if it was never computed.
+    const Result* Get() const { return computed ? &result : nullptr; }
+
+    static StatVector FitPrices(const ItemStatTable& table, const std::vector<uint32_t>& basicItems,
+                                std::array<bool, kStatCount>& fitted, float& rmsError);
+
+private:
+    Result result;
+    bool computed = false;
+};
@@ -7,14 +7,23 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include "DataManager.h"
+#include "BuildOptimizer.h"
+#include "DuelMatrix.h"
+#include "TeamComposer.h"
+#include "RichText.h"
+#include "AsyncTask.h"
+#include "Arena.h"
+#include "Symbols.h"
+#include "GlyphCache.h"
 #include <atomic>
-#include <thread>
 #include <mutex>
 #include <random>
 #include <algorithm>
-#include <future>
-#include <thread>
+#include <memory>
+#include <optional>
 #include <numeric>
 #include "resource1.h"
 
@@ -29,6 +38,8 @@ public:
     void Render();
     void Cleanup();
     void SetWindowOffset(float offset) { windowOffset = offset; }
+    // Before Initialize, which starts the first fetches
+    void SetJsonBackend(DataManager::JsonBackend backend) { dataManager.SetJsonBackend(backend); }
     void RandomizeChampion();
 
     void RenderItemsDetail();
@@ -43,6 +54,20 @@ private:
     ImFont* smallFont;
     ImFont* defaultFont;
 
+    // Glyphs past Latin-1 are added to the fonts only once text needs them:
+    // CoverText queues what is missing, and the next frame rasterizes just
+    // those from system fonts of the script into the atlas's spare pages.
+    GlyphCache glyphCache{ ".\\assets\\recharge bd.ttf", { 14.0f, 10.0f } };
+    std::vector<bool> coveredGlyphs = std::vector<bool>(0x10000, false);
+    std::vector<ImWchar> pendingGlyphs;
+    void CoverText(std::string_view text);
+    void AddPendingGlyphs();
+
+    // Locale of the text on screen; a newly published one resets the text caches
+    std::string shownLocale = "en_US";
+    void ApplyLocaleChange();
+    void RenderLocaleSelector();
+
     float buttonHeight;
     float windowOffset;
 
@@ -50,17 +75,21 @@ private:
         Default,
         Champions,
         Items,
-        SummonerSpells
+        SummonerSpells,
+        Tools
     };
     WindowState currentState;
 
     DataManager dataManager;  
     int selectedChampionIndex;
 
-    std::future<void> championDataFuture;
-    std::future<GLuint> championSplashFuture;
-    std::future<GLuint> championIconFuture;
-    std::vector<std::future<GLuint>> skillIconFutures;
+    // Work started from the UI: downloads on the I/O pool, the rest on the
+    // shared pool. Results come back to the main thread via PostToMain.
+    AsyncScope loaders;
+    // Labels and keys built while drawing; reset at the start of every Render
+    Arena frameArena;
+    TaskGroup dataLoads{ TaskPool::Io() };
+    TaskGroup uiTasks;
 
     void ApplyCustomStyles();
     
@@ -69,19 +98,56 @@ private:
     void RenderDefaultWindow();
     void RenderChampionsWindow();   
     void RenderItemsWindow();
+    void RenderToolsWindow();
+    void SelectChampion(int index);
+
+    // Global quick-open box (Ctrl+P) that jumps to any champion, item, spell or mode
+    void RenderQuickOpen();
+    void OpenSearchResult(const SearchIndex::Entry& entry);
+    SearchIndex::Session championSearch;
+    SearchIndex::Session itemSearch;
+    SearchIndex::Session gameModeSearch;
+    SearchIndex::Session quickOpenSearch;
+    char quickOpenBuffer[256] = "";
+    int quickOpenSelection = 0;
+    bool quickOpenFocus = false;
+    std::string quickOpenTextQuery;
+    size_t quickOpenTextDocuments = 0;
+    std::vector<TextIndex::Hit> quickOpenTextHits;
+    void OpenTextHit(const TextIndex::Hit& hit);
+    void ShowChampionTip(bool ally, size_t tipIndex);
+    std::optional<std::pair<bool, size_t>> pendingTip;   // ally and tip index, shown once the details are in
+    std::string pendingSkill;   // skill to select once the skill icons are loaded
+    FacetIndex::Filter championFilter;
+    FacetIndex::Bitmap championFilterMatches;
 
     void CleanupSkinTextures();
 
     bool isChampionSplashLoaded;
     bool LoadIconTexture(const char* filename);
-    void LoadSkillIcons(const std::string& championId);
-    void LoadSkillIcon(const std::string& iconFilename, int index);
-    GLuint LoadSkinTexture(const std::string& url);
+    bool championDetailsLoading = false;
+    AsyncJob LoadChampionDetails(std::string championId);
+    AsyncJob LoadSkillIcon(std::string iconFilename, int index);
+    AsyncJob LoadSkinTexture(Symbol skinKey, std::string url);
     void RandomizeTips(const std::vector<std::string>& tips, std::vector<size_t>& indices);
     bool isChampionIconLoaded;
-    void LoadChampionSplash(const std::string& championName);
-    void LoadChampionIcon(const std::string& championName);
+    AsyncJob LoadChampionSplash(std::string championName);
+    AsyncJob LoadChampionIcon(std::string championName);
     static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
+    bool DownloadImage(const std::string& url, std::string& imageData);
+    struct DecodedImage {
+        std::shared_ptr<unsigned char> pixels;   // RGBA, null if decoding failed
+        int width = 0;
+        int height = 0;
+    };
+    // On the I/O pool; empty if the download failed
+    AsyncTask<std::string> FetchImage(std::string url);
+    // On the shared pool
+    AsyncTask<DecodedImage> DecodeImage(std::string bytes);
+    // Fetch, decode, and create the texture on the main thread; 0 if it failed
+    AsyncTask<GLuint> LoadTextureAsync(std::string url);
+    AsyncJob LoadItemTexture(Symbol url);
+    GLuint CreateTexture(const unsigned char* pixels, int width, int height);
     bool isDragging = false;
     ImVec2 dragStartPos;
     bool isResizing = false;
@@ -91,13 +157,25 @@ private:
     GLuint iconTexture;
     bool isIconLoaded;
     std::vector<GLuint> skillTextures;
-    bool areSkillIconsLoaded;
+    bool areChampionDetailsLoaded;
     std::string selectedSkill;
     std::string skillDescription;
-    std::map<std::string, std::string> skillDescriptions;
+    SymbolMap<std::string> skillDescriptions;   // by skill key
+    const std::string& SkillDescription(std::string_view skillKey) const;
+    std::map<std::string, RichText, std::less<>> richTexts;   // parsed descriptions, lore and tips by key
+    void RenderRichText(std::string_view key, const std::string& markup);
+    // Detail panel of the selected champion, filled by LoadChampionDetails;
+    // the frame only reads these
+    std::unordered_map<std::string, float> championStats;   // base stats by Data Dragon key
+    std::string championLore;
+    struct ChampionSkin {
+        std::string name;
+        int num;
+    };
+    std::vector<ChampionSkin> championSkins;
     bool showSkins = false;
     size_t currentSkinIndex = 0;
-    std::map<std::string, GLuint> skinTextures;
+    SymbolMap<GLuint> skinTextures;             // by skin key
     std::vector<std::string> allyTips;
     std::vector<std::string> enemyTips;
     std::vector<size_t> tipIndices;
@@ -111,7 +189,6 @@ private:
     size_t currentAllyTipIndex = 0;
     size_t currentEnemyTipIndex = 0;
     std::vector<size_t> championIndices;
-    std::thread randomizationThread;
     std::atomic<bool> isRandomizing;
     std::atomic<bool> hasRandomChampion;
 
@@ -139,15 +216,35 @@ private:
     bool showTankItems = false;
     bool showSupportItems = false;
     int selectedItemIndex = -1;
-    std::map<std::string, GLuint> itemTextures;
+    SymbolMap<GLuint> itemTextures;             // by icon url
     std::vector<ItemHistoryEntry> backwardHistory;
     std::filesystem::path historyFilePath;
     std::vector<std::string> forwardHistory;
     std::vector<HistoryEntry> history;
     size_t currentHistoryIndex;
     std::string currentTag;
+    FacetIndex::Filter itemFilter;
+    void RenderItemFilters();
+    bool showItemTable = false;
+    std::vector<std::string> sortedItems;   // currentItems as last sorted by the table
+    void RenderItemTable();
+    void RenderItemLink(uint32_t ordinal, float iconSize);
+    void RenderRecipeTree(uint32_t ordinal);
+    // Buffs and nerfs from the patch history
+    static constexpr size_t kPatchChangeCount = 5;   // patches shown per champion or item
+    void RenderPatchChange(PatchHistory::Kind kind, const PatchHistory::Change& change, const char* prefix);
+    void RenderPatchChanges(PatchHistory::Kind kind, const std::string& id);
+    void RenderItemPatchDiff();
+    int itemDiffFrom = -1;   // indices into the item patch list
+    int itemDiffTo = -1;
+    bool itemDiffCostOnly = false;
+    void ApplyItemFilter();
 
+    // 0 until a downloaded icon arrives
     GLuint LoadTextureFromURL(const std::string& url);
+    // Icons from the bundle packed into the executable, 0 if it has none
+    GLuint LoadBundledIcon(const std::string& key);
+    GLuint CreateIconTexture(const std::vector<uint8_t>& pixels, int size);
     void DisplayItem(const std::string& itemId);
     void UpdateItemState(const std::string& itemId, const std::string& tag, bool isTagView, int selectedIndex, bool addToHistory);
     void InitializeHistory();
@@ -161,9 +258,64 @@ private:
     // Summoner Spells window related
     void RenderSummonerSpellsWindow();
     int selectedGameModeIndex = -1;
+    int selectedSpellIndex = -1;
+    std::vector<uint32_t> modeSpells;   // spell indices for the selected mode
+    int modeSpellsIndex = -1;
     char gameModeSearchBuffer[256] = "";
-    std::map<std::string, GLuint> summonerSpellTextures;
+    SymbolMap<GLuint> summonerSpellTextures;
     GLuint LoadSummonerSpellTexture(const std::string& spellId);
 
+    // Tools window related
+    void RenderOptimizerTab();
+    void StartOptimizer();
+    BuildOptimizer buildOptimizer;
+    int optimizerChampionIndex = -1;
+    int optimizerLevel = 18;
+    int optimizerMetric = 0;
+    int optimizerSlots = 6;
+    int optimizerBudget = 0;
+    void RenderStatCurvesTab();
+    void RenderStatCurvePlot(const StatCurves::Table& curves);
+    int statCurveLevel = 1;
+    int statCurvePlotStat = 0;
+    std::vector<uint32_t> statCurveOrder;      // champion ordinals in table order
+    int statCurveOrderLevel = 0;               // level statCurveOrder was sorted at
+    std::vector<uint32_t> statCurvePlotted;    // champions drawn in the curve plot
+    void RenderDuelTab();
+    void UpdateDuels();
+    void UpdateDuelHeatmap();
+    bool RenderItemSetEditor(const char* id, std::vector<uint32_t>& items);
+    struct DuelSetup {
+        int level = 9;
+        std::vector<uint32_t> items;   // item ordinals
+    };
+    DuelMatrix duelMatrix;
+    DuelSetup duelDefault;
+    std::map<uint32_t, DuelSetup> duelOverrides;   // custom setups by champion ordinal
+    bool duelInputsDirty = true;
+    int duelSelected = -1;
+    int duelHeatmapMode = 0;
+    size_t duelLastCells = 0;
+    double duelLastMilliseconds = 0.0;
+    GLuint duelHeatmapTexture = 0;
+    uint64_t duelHeatmapVersion = 0;           // matrix version and mode the texture shows
+    int duelHeatmapTextureMode = -1;
+    void RenderTeamTab();
+    void StartTeamSearch();
+    void UpdateTeamProfiles();
+    TeamComposer teamComposer;
+    std::vector<TeamComposer::Champion> teamProfiles;   // by champion ordinal
+    int teamProfilesLevel = 0;                          // level teamProfiles were built at
+    std::array<int, TeamComposer::kTeamSize> teamPicks = { -1, -1, -1, -1, -1 };
+    int teamLevel = 11;
+    float teamTimeBudget = 2.0f;
+    TeamComposer::Weights teamWeights;
+    void RenderAbilitiesTab();
+    int abilityHaste = 0;
+    std::vector<float> abilityCooldowns;       // haste-adjusted, in AbilityTable::Cooldowns() layout
+    int abilityCooldownsHaste = -1;            // haste abilityCooldowns was computed at
+    std::vector<uint32_t> abilityOrder;        // ability rows in table order
+    uint64_t abilityCachesGeneration = 0;      // of the table the two above were built from
+
 
 };
\ No newline at end of file
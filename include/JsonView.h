@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+// Read-only, on-demand view of json text. A value is just its span of the
+// text; objects and arrays are walked member by member, and whatever the
+// caller does not ask for is skipped by matching brackets, never parsed.
+// Reading a few fields of a large document this way costs a fraction of
+// building the nlohmann tree. Skipped values are only checked for balanced
+// brackets and closed strings; malformed json that is read throws
+// std::runtime_error like nlohmann does.
+class JsonView {
+public:
+    enum class Type { Missing, Null, Bool, Number, String, Array, Object };
+
+    JsonView() = default;
+    // The whole document, which must be exactly one value
+    explicit JsonView(std::string_view text);
+
+    Type GetType() const { return type; }
+    bool IsMissing() const { return type == Type::Missing; }
+    bool IsObject() const { return type == Type::Object; }
+    bool IsArray() const { return type == Type::Array; }
+    bool IsString() const { return type == Type::String; }
+    bool IsNumber() const { return type == Type::Number; }
+    std::string_view Raw() const { return raw; }
+
+    // Member of an object by key, Missing if there is none or this is not an object
+    JsonView Find(std::string_view key) const;
+
+    // visit(std::string_view key, JsonView value) for each member in order.
+    // Keys are passed as written, escapes and all.
+    template <typename F>
+    void ForEachMember(F&& visit) const {
+        size_t pos = 1;
+        std::string_view key;
+        JsonView value;
+        while (type == Type::Object && NextMember(pos, key, value)) {
+            visit(key, value);
+        }
+    }
+
+    // visit(JsonView value) for each element in order
+    template <typename F>
+    void ForEachElement(F&& visit) const {
+        size_t pos = 1;
+        JsonView value;
+        while (type == Type::Array && NextElement(pos, value)) {
+            visit(value);
+        }
+    }
+
+    // Fallbacks when the value has another type
+    std::string String() const;
+    double Number(double fallback = 0.0) const;
+    bool Bool(bool fallback = false) const;
+
+    // The subtree as an nlohmann value, for code that wants the full tree
+    nlohmann::json Materialize() const;
+
+private:
+    JsonView(std::string_view raw, Type type) : raw(raw), type(type) {}
+
+    std::string_view raw;
+    Type type = Type::Missing;
+
+    bool NextMember(size_t& pos, std::string_view& key, JsonView& value) const;
+    bool NextElement(size_t& pos, JsonView& value) const;
+    // The value at pos in text; moves pos past it
+    static JsonView At(std::string_view text, size_t& pos);
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include "Symbols.h"
+
+// One locale's display text for champions and summoner spells, by id.
+// Stats, ordinals and images come from the en_US data every locale shares,
+// so a locale costs one of these tables instead of a second copy of the
+// datasets.
+class LocaleStrings {
+public:
+    struct Champion {
+        std::string name;
+        std::string title;
+        std::string blurb;
+    };
+    struct Spell {
+        std::string name;
+        std::string description;
+    };
+
+    // From the locale's ddragon champion.json and summoner.json. Throws on
+    // malformed json.
+    void Build(std::string_view championJson, std::string_view summonerJson);
+
+    // Compact json for the cache directory, and back; Parse is false on a
+    // damaged file
+    std::string Serialize() const;
+    bool Parse(std::string_view text);
+
+    const Champion* FindChampion(std::string_view id) const { return champions.Find(Symbols::Find(id)); }
+    const Spell* FindSpell(std::string_view id) const { return spells.Find(Symbols::Find(id)); }
+    bool Empty() const { return champions.Size() == 0; }
+
+    // visit(std::string_view text) for every string in the table
+    template <typename F>
+    void ForEachText(F&& visit) const {
+        champions.ForEach([&visit](Symbol, const Champion& champion) {
+            visit(champion.name);
+            visit(champion.title);
+            visit(champion.blurb);
+        });
+        spells.ForEach([&visit](Symbol, const Spell& spell) {
+            visit(spell.name);
+            visit(spell.description);
+        });
+    }
+
+private:
+    SymbolMap<Champion> champions;
+    SymbolMap<Spell> spells;
+};
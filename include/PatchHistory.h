@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+#include <cstdint>
+#include "StatBlock.h"
+
+// Champion and item numbers of every patch seen, side by side. Each (entity,
+// field) column holds only the values it changed to, tagged with the first
+// patch they hold for, so a patch that leaves a value alone stores nothing
+// for it. Ingesting a patch compares it once against the newest values and
+// records its changes in a per-patch list; range queries only visit the
+// entities named in those lists.
+class PatchHistory {
+public:
+    enum class Kind : uint8_t { Champion, Item, Count };
+
+    // Champion fields are the BaseStat order, item fields the Stat order then
+    // the cost. The field after the last one records whether the entity exists.
+    static size_t FieldCount(Kind kind);
+    static uint16_t PresenceField(Kind kind) { return static_cast<uint16_t>(FieldCount(kind)); }
+    static constexpr uint16_t kItemCost = static_cast<uint16_t>(kStatCount);
+    static const char* FieldName(Kind kind, uint16_t field);
+    // +1 if a higher value is a buff, -1 if a lower one is, 0 if neither
+    static int Direction(Kind kind, uint16_t field);
+
+    struct Change {
+        uint16_t patch = 0;    // the patch with the new value
+        uint16_t field = 0;
+        uint32_t entity = 0;
+        float before = 0.0f;
+        float after = 0.0f;
+    };
+    // +1 buff, -1 nerf, 0 neither
+    static int Verdict(Kind kind, const Change& change);
+
+    // Adds the patch's values: one row of FieldCount(kind) floats per id.
+    // Patches are compared by their numbers; one that is not newer than this
+    // kind's newest, or a patch not yet seen that is older than the newest of
+    // any kind, is ignored, so history only ever moves forward.
+    bool Ingest(Kind kind, const std::string& patch, const std::vector<std::string>& ids, const std::vector<float>& values);
+
+    size_t PatchCount() const { return patches.size(); }
+    const std::string& PatchName(size_t patch) const { return patches[patch]; }
+    int FindPatch(const std::string& patch) const;
+    // Patches ingested for the kind, oldest first
+    const std::vector<uint16_t>& Patches(Kind kind) const { return stores[static_cast<size_t>(kind)].ingested; }
+    const std::string& EntityId(Kind kind, uint32_t entity) const { return stores[static_cast<size_t>(kind)].ids[entity]; }
+
+    // The value in effect at the patch, NaN before the entity first appeared
+    float ValueAt(Kind kind, uint32_t entity, uint16_t field, uint16_t patch) const;
+    // Every change to one entity in the kind's last patchCount patches, newest first
+    std::vector<Change> EntityChanges(Kind kind, const std::string& id, size_t patchCount) const;
+    // Net changes from one patch to a later one, for one field or all (field < 0)
+    std::vector<Change> ChangesBetween(Kind kind, uint16_t from, uint16_t to, int field = -1) const;
+    // The changes a patch made when it was ingested
+    const std::vector<Change>& PatchChanges(Kind kind, uint16_t patch) const;
+
+    bool Save(const std::filesystem::path& path) const;
+    bool Load(const std::filesystem::path& path);
+
+private:
+    struct Run {
+        uint16_t patch;
+        float value;
+    };
+    struct Store {
+        std::vector<std::string> ids;
+        std::unordered_map<std::string, uint32_t> entities;
+        std::vector<std::vector<Run>> columns;        // [entity * (FieldCount + 1) + field]
+        std::vector<uint16_t> ingested;
+        std::vector<std::vector<Change>> changes;     // by patch
+    };
+
+    std::vector<std::string> patches;
+    Store stores[static_cast<size_t>(Kind::Count)];
+
+    uint16_t AddPatch(const std::string& patch);
+    void RebuildChanges(Kind kind);
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Item recipe graph over dense item ordinals (the same ordinals as the item
+// facets). Edges and transitive closures are stored in CSR form, one offsets
+// array plus one flat array each, and the cost and depth rollups are computed
+// once when the graph is built, so every build-path query is an array read.
+class RecipeGraph {
+public:
+    // A view into one row of a CSR array.
+    class Range {
+    public:
+        Range() = default;
+        Range(const uint32_t* first, const uint32_t* last) : first(first), last(last) {}
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+        uint32_t operator[](size_t i) const { return first[i]; }
+
+    private:
+        const uint32_t* first = nullptr;
+        const uint32_t* last = nullptr;
+    };
+
+    // components[i] lists the direct components of item i (repeated if the
+    // recipe needs two of them); totalCost[i] is its shop price.
+    void Build(const std::vector<std::vector<uint32_t>>& components, const std::vector<int>& totalCost);
+
+    size_t Size() const { return depth.size(); }
+
+    Range Components(uint32_t item) const { return Row(componentOffsets, componentEdges, item); }
+    Range BuildsInto(uint32_t item) const { return Row(parentOffsets, parentEdges, item); }
+    // Every item this one eventually builds into, nearest first.
+    Range Upgrades(uint32_t item) const { return Row(upgradeOffsets, upgradeEdges, item); }
+    // Every distinct item anywhere in this item's recipe tree, nearest first.
+    Range TreeItems(uint32_t item) const { return Row(treeOffsets, treeEdges, item); }
+
+    // Gold paid on top of the direct components.
+    int CombineCost(uint32_t item) const { return combineCost[item]; }
+    // Combine costs of the whole tree plus the basic items at its leaves.
+    int TreeCost(uint32_t item) const { return treeCost[item]; }
+    // 0 for basic items, 1 + the deepest component otherwise.
+    int Depth(uint32_t item) const { return depth[item]; }
+
+private:
+    std::vector<uint32_t> componentOffsets, componentEdges;
+    std::vector<uint32_t> parentOffsets, parentEdges;
+    std::vector<uint32_t> upgradeOffsets, upgradeEdges;
+    std::vector<uint32_t> treeOffsets, treeEdges;
+    std::vector<int> combineCost;
+    std::vector<int> treeCost;
+    std::vector<int> depth;
+
+    static Range Row(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& edges, uint32_t item) {
+        if (item + 1 >= offsets.size()) {
+            return Range();
+        }
+        return Range(edges.data() + offsets[item], edges.data() + offsets[item + 1]);
+    }
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "imgui.h"
+
+// Text with ddragon / meraki markup (<br>, <magicDamage>, <font color=...>,
+// &nbsp; ...) parsed once into plain text plus styled spans. Wrapping is laid
+// out per (font, size, width) and kept, so drawing a long lore text is a
+// lookup and a few AddText calls for the visible lines instead of measuring
+// every word every frame.
+class RichText {
+public:
+    enum class Style : uint8_t {
+        Normal,
+        Emphasis,     // names, actives, passives, keywords
+        Physical,
+        Magic,
+        True,
+        Heal,
+        Shield,
+        Status,       // crowd control, stealth, speed
+        Scaling,
+        Muted,        // rules and flavor text
+        Count
+    };
+    static ImVec4 StyleColor(Style style);
+
+    struct Span {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        Style style = Style::Normal;
+    };
+
+    RichText() = default;
+    explicit RichText(const std::string& markup);
+
+    const std::string& Text() const { return text; }
+    const std::vector<Span>& Spans() const { return spans; }
+
+    // Draws the text wrapped to the available width at the cursor and
+    // advances the cursor past it, like ImGui::TextWrapped.
+    void Render() const;
+
+private:
+    struct Segment {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        Style style = Style::Normal;
+        float x = 0.0f;
+    };
+    struct Layout {
+        const ImFont* font = nullptr;
+        float fontSize = 0.0f;
+        float width = 0.0f;
+        std::vector<Segment> segments;
+        std::vector<uint32_t> lineStarts;   // first segment of each line, plus one past the last
+    };
+
+    std::string text;
+    std::vector<Span> spans;
+    mutable std::vector<Layout> layouts;    // most recently used first
+
+    void Parse(const std::string& markup);
+    const Layout& GetLayout(const ImFont* font, float fontSize, float width) const;
+    void BuildLayout(Layout& layout) const;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Name search shared by every tab and the quick-open box.
+// Names are normalized once when they are added (case and diacritics folded,
+// punctuation dropped) and indexed by their 1-, 2- and 3-grams, so a query only
+// touches the posting lists of its own n-grams instead of scanning every name.
+// Grams at word starts and name starts get extra posting lists, ordered by name
+// length, so short queries read their top results straight off those lists.
+class SearchIndex {
+public:
+    enum class EntityKind : uint8_t {
+        Champion,
+        Item,
+        SummonerSpell,
+        GameMode,
+        Count
+    };
+
+    static constexpr uint32_t KindBit(EntityKind kind) { return 1u << static_cast<uint32_t>(kind); }
+    static constexpr uint32_t AllKinds = (1u << static_cast<uint32_t>(EntityKind::Count)) - 1;
+
+    struct Entry {
+        EntityKind kind;
+        int ordinal;              // index into the owning list (championNames, itemNames, ...)
+        std::string display;
+    };
+
+    struct Result {
+        uint32_t entry;
+        int score;
+    };
+
+    // Per search box state. Keeps the previous query's matches so that typing
+    // more characters only narrows the previous result set.
+    struct Session {
+        std::string lastQuery;
+        uint32_t lastKinds = 0;
+        size_t lastMaxResults = 0;
+        uint64_t generation = 0;     // 0 until the first query, so a fresh session never hits the cache
+        std::vector<uint32_t> matches;   // exact substring matches of lastQuery
+        bool hasMatches = false;
+        std::vector<Result> results;     // ranked output of the last query
+        std::vector<uint16_t> scratch;   // per-entry counters for the fuzzy pass
+        std::vector<uint32_t> touched;
+
+        void Reset() { lastQuery.clear(); generation = 0; matches.clear(); hasMatches = false; results.clear(); }
+    };
+
+    // Replaces every entry of the given kind and rebuilds the postings.
+    void SetEntries(EntityKind kind, const std::vector<std::string>& names);
+    void Clear();
+
+    // Ranked search. An empty query returns every entry of the requested kinds in
+    // insertion order. Results are cached in the session until the query changes.
+    const std::vector<Result>& Query(Session& session, const std::string& query,
+                                     uint32_t kinds, size_t maxResults = 0) const;
+
+    const Entry& GetEntry(uint32_t index) const { return entries[index]; }
+    std::string_view GetNormalized(uint32_t index) const {
+        return std::string_view(pool.data() + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+    size_t Size() const { return entries.size(); }
+    uint64_t Generation() const { return generation; }
+
+    static std::string Normalize(const std::string& text);
+    static int BoundedEditDistance(const char* a, size_t aLen, const char* b, size_t bLen, int maxDistance);
+
+private:
+    std::vector<Entry> entries;
+    // Normalized names live back to back in one buffer and kinds in a parallel
+    // byte array, so scanning candidates walks contiguous memory.
+    std::string pool;
+    std::vector<uint32_t> offsets;
+    std::vector<uint8_t> kindOf;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+    uint64_t generation = 0;
+
+    void Rebuild();
+    bool Accepts(uint32_t id, uint32_t kinds) const { return (kinds & (1u << kindOf[id])) != 0; }
+    const std::vector<uint32_t>* FindPosting(const char* gram, size_t length, uint32_t tag = 0) const;
+    const std::vector<uint32_t>* ShortestPosting(const std::string& query) const;
+    void FilterExact(const std::vector<uint32_t>& candidates, const std::string& query,
+                     uint32_t kinds, bool needsVerify, std::vector<uint32_t>& out) const;
+    bool CollectTier(Session& session, const std::string& query, uint32_t kinds, size_t maxResults) const;
+    void CollectFuzzy(Session& session, const std::string& query, uint32_t kinds) const;
+    int ScoreExact(uint32_t id, const std::string& query) const;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "JsonView.h"
+
+// Stats shared by items and champions. Percent stats (attack speed, crit,
+// penetration, life steal, ...) are stored in percentage points, the way the
+// meraki item data lists them.
+enum class Stat : uint8_t {
+    Health,
+    Mana,
+    Armor,
+    MagicResist,
+    AttackDamage,
+    AbilityPower,
+    AttackSpeed,
+    CritChance,
+    Lethality,
+    ArmorPenPercent,
+    MagicPen,
+    MagicPenPercent,
+    AbilityHaste,
+    LifeSteal,
+    Omnivamp,
+    MoveSpeed,
+    MoveSpeedPercent,
+    HealthRegen,
+    ManaRegen,
+    HealShieldPower,
+    Tenacity,
+    Count
+};
+
+constexpr size_t kStatCount = static_cast<size_t>(Stat::Count);
+using StatVector = std::array<float, kStatCount>;
+
+const char* StatName(Stat stat);
+inline size_t StatIndex(Stat stat) { return static_cast<size_t>(stat); }
+
+// Reads a meraki item "stats" object.
+StatVector ParseItemStats(const nlohmann::json& stats);
+StatVector ParseItemStats(const JsonView& stats);
+
+// Champion stats at a level from ddragon base and growth values, using the
+// in-game growth curve. Attack speed is the total attacks per second with no
+// bonus attack speed; bonus attack speed from items scales the base value.
+struct ChampionLevelStats {
+    StatVector stats{};
+    float baseAttackSpeed = 0.0f;   // "attackspeed", the ratio bonus attack speed multiplies
+    float attackSpeedGrowth = 0.0f; // bonus attack speed % from levels
+    float attackRange = 0.0f;
+};
+ChampionLevelStats ChampionStatsAtLevel(const nlohmann::json& stats, int level);
+float GrowthMultiplier(int level);
+
+// The ddragon champion "stats" values in a fixed order, so they can be stored
+// in flat records and scaled without a json lookup per field.
+enum class BaseStat : uint8_t {
+    Hp, HpPerLevel,
+    Mp, MpPerLevel,
+    MoveSpeed,
+    Armor, ArmorPerLevel,
+    SpellBlock, SpellBlockPerLevel,
+    AttackRange,
+    HpRegen, HpRegenPerLevel,
+    MpRegen, MpRegenPerLevel,
+    Crit, CritPerLevel,
+    AttackDamage, AttackDamagePerLevel,
+    AttackSpeedPerLevel, AttackSpeed,
+    Count
+};
+
+constexpr size_t kBaseStatCount = static_cast<size_t>(BaseStat::Count);
+using ChampionBaseStats = std::array<float, kBaseStatCount>;
+
+const char* BaseStatKey(BaseStat stat);   // "hp", "hpperlevel", ...
+inline size_t BaseStatIndex(BaseStat stat) { return static_cast<size_t>(stat); }
+ChampionBaseStats ParseChampionBaseStats(const nlohmann::json& stats);
+ChampionLevelStats ChampionStatsAtLevel(const ChampionBaseStats& stats, int level);
+
+// Reference gold value of one point of each stat.
+const StatVector& BaselineGoldValues();
+
+// Item stats as one column per stat over item ordinals, plus the price, so
+// whole-catalog passes walk contiguous floats.
+struct ItemStatTable {
+    std::array<std::vector<float>, kStatCount> columns;
+    std::vector<float> cost;
+
+    size_t Size() const { return cost.size(); }
+    float Get(uint32_t item, Stat stat) const { return columns[StatIndex(stat)][item]; }
+    StatVector Row(uint32_t item) const;
+    void Resize(size_t count);
+    void SetRow(uint32_t item, const StatVector& stats, float itemCost);
+};
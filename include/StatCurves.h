@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include "StatBlock.h"
+
+// Level 1-18 stat curves for every champion, computed in one pass from the
+// ddragon base and per-level values. Every (stat, level) pair is one
+// contiguous row over champion ordinals, so a level is one growth multiplier
+// broadcast over flat arrays and reading a level back is a pointer offset.
+// Computed once per champion set, which is rebuilt on a new patch.
+class StatCurves {
+public:
+    static constexpr int kMaxLevel = 18;
+    static constexpr size_t kCurveCount = 9;
+
+    // The stats with curves, in column order
+    static const std::array<Stat, kCurveCount>& CurveStats();
+    // Column of a stat, -1 if it has no curve
+    static int CurveIndex(Stat stat);
+
+    struct Table {
+        size_t championCount = 0;
+        // values[(curve * kMaxLevel + level - 1) * championCount + champion]
+        std::vector<float> values;
+
+        // All champions' values of one curve at one level
+        const float* Level(size_t curve, int level) const {
+            return values.data() + (curve * kMaxLevel + (level - 1)) * championCount;
+        }
+        float Get(size_t curve, int level, uint32_t champion) const { return Level(curve, level)[champion]; }
+    };
+
+    // Builds the table from the ddragon base stats by champion ordinal,
+    // replacing the last one.
+    const Table& Compute(const std::vector<ChampionBaseStats>& championStats);
+    // The last table, or nullptr if it was never computed.
+    const Table* Get() const { return computed ? &table : nullptr; }
+
+private:
+    Table table;
+    bool computed = false;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+// Dense 32-bit id of an interned string. Entity ids, names, tags, modes and
+// icon urls are interned once at load time; after that a key is compared,
+// hashed and stored as one integer.
+using Symbol = uint32_t;
+
+// The process-wide interner. Ids are handed out in order from 0 and never
+// reused, and the text of a symbol never moves, so Name needs no lock. Names
+// are null-terminated and can go straight to C APIs.
+class Symbols {
+public:
+    static constexpr Symbol kNone = UINT32_MAX;
+
+    static Symbol Intern(std::string_view text);
+    // kNone if the text was never interned; never adds one
+    static Symbol Find(std::string_view text);
+    static std::string_view Name(Symbol symbol);
+    static size_t Count();
+};
+
+// Open-addressing table keyed by symbol: one flat array of slots probed
+// linearly from the symbol's hash. Entries are never erased one by one,
+// which keeps probing free of tombstones; Clear drops them all.
+template <typename T>
+class SymbolMap {
+public:
+    T* Find(Symbol key) {
+        return const_cast<T*>(static_cast<const SymbolMap&>(*this).Find(key));
+    }
+    const T* Find(Symbol key) const {
+        if (slots.empty() || key == Symbols::kNone) {
+            return nullptr;
+        }
+        for (size_t slot = Home(key);; slot = (slot + 1) & (slots.size() - 1)) {
+            if (slots[slot].first == key) {
+                return &slots[slot].second;
+            }
+            if (slots[slot].first == Symbols::kNone) {
+                return nullptr;
+            }
+        }
+    }
+
+    // Inserts a default value if the key is missing
+    T& operator[](Symbol key) {
+        if ((count + 1) * 4 > slots.size() * 3) {
+            Grow();
+        }
+        size_t slot = Home(key);
+        while (slots[slot].first != key && slots[slot].first != Symbols::kNone) {
+            slot = (slot + 1) & (slots.size() - 1);
+        }
+        if (slots[slot].first == Symbols::kNone) {
+            slots[slot].first = key;
+            ++count;
+        }
+        return slots[slot].second;
+    }
+
+    size_t Size() const { return count; }
+    void Clear() {
+        slots.clear();
+        count = 0;
+    }
+
+    template <typename F>
+    void ForEach(F&& visit) {
+        for (auto& [key, value] : slots) {
+            if (key != Symbols::kNone) {
+                visit(key, value);
+            }
+        }
+    }
+    template <typename F>
+    void ForEach(F&& visit) const {
+        for (const auto& [key, value] : slots) {
+            if (key != Symbols::kNone) {
+                visit(key, value);
+            }
+        }
+    }
+
+private:
+    std::vector<std::pair<Symbol, T>> slots;   // size is zero or a power of two
+    size_t count = 0;
+
+    size_t Home(Symbol key) const {
+        // Fibonacci hashing spreads consecutive ids over the table
+        return static_cast<size_t>((uint64_t(key) * 0x9E3779B97F4A7C15ull) >> 32) & (slots.size() - 1);
+    }
+
+    void Grow() {
+        std::vector<std::pair<Symbol, T>> old = std::move(slots);
+        slots.assign(old.empty() ? 16 : old.size() * 2, { Symbols::kNone, T() });
+        count = 0;
+        for (auto& [key, value] : old) {
+            if (key != Symbols::kNone) {
+                (*this)[key] = std::move(value);
+            }
+        }
+    }
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+// Fixed pool of worker threads, one per core, with one task deque per worker
+// and priority. A worker runs its own deque newest first and, when that runs
+// dry, steals the oldest task of another worker, so uneven batches still keep
+// every core busy without a single shared queue to fight over. Higher
+// priorities are drained from every deque before lower ones are looked at.
+class TaskPool {
+public:
+    enum class Priority : uint8_t {
+        High,          // work the user is waiting on: visible images, parallel loops
+        Normal,
+        Background,    // prefetching and index upkeep
+        Count
+    };
+
+    explicit TaskPool(unsigned int threadCount = 0);   // 0 for one per core
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    void Submit(std::function<void()> task, Priority priority = Priority::Normal);
+
+    // Runs body(begin, end) over [0, count) in chunks of at most grain and
+    // returns once every chunk is done. The calling thread runs chunks too but
+    // never other queued work, so the UI thread can call it, and so can a task.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    unsigned int ThreadCount() const { return static_cast<unsigned int>(threads.size()); }
+    // True on one of this pool's worker threads
+    bool IsWorkerThread() const;
+    // Runs one queued task on the calling thread; false if there was none.
+    bool RunPending();
+
+    // The process-wide pool for computation.
+    static TaskPool& Shared();
+    // A few threads for work that blocks on the network or the disk, so a
+    // slow download never holds a core the computation pool counts on.
+    static TaskPool& Io();
+
+    // Queues a task for the main thread, run by the next RunMainThreadTasks.
+    // Continuations that touch GL or UI state go through here.
+    static void PostToMain(std::function<void()> task);
+    static void RunMainThreadTasks();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks[static_cast<size_t>(Priority::Count)];
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{ 0 };
+    std::atomic<size_t> nextQueue{ 0 };
+    std::atomic<bool> stopping{ false };
+
+    // Runs one task from queue home, or stolen from another; false if all are empty.
+    bool RunOne(size_t home);
+    void WorkerLoop(size_t index);
+};
+
+// Tasks that belong together and can be waited on or cancelled as one: a
+// search, a prefetch, the loads of one screen. Cancelling skips the tasks
+// that have not started yet; running ones check IsCancelled. Destroying a
+// group cancels it and waits, so tasks may capture the group's owner.
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPool& pool = TaskPool::Shared()) : pool(pool) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(std::function<void()> task, TaskPool::Priority priority = TaskPool::Priority::Normal);
+    // Returns once every task run so far has finished. On a worker of the
+    // group's pool the caller runs queued tasks meanwhile.
+    void Wait();
+    // Skips the queued tasks, waits for the running ones and makes the group
+    // usable again.
+    void Cancel();
+
+    bool IsCancelled() const { return cancelled; }
+    bool Busy() const { return pending > 0; }
+
+private:
+    TaskPool& pool;
+    std::atomic<bool> cancelled{ false };
+    std::atomic<size_t> pending{ 0 };
+    std::mutex doneMutex;
+    std::condition_variable done;
+};
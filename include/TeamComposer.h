@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "TaskPool.h"
+
+// Scores five-champion teams for role coverage, frontline durability, the
+// physical/magic damage mix and the melee/ranged mix, and searches the
+// champion pool for the best completions of a partly picked team. Roles are
+// bit masks, so coverage is an OR and a popcount. The search is a depth-first
+// branch and bound over combinations split into tasks on a TaskPool; a branch
+// is cut as soon as the optimistic value of every term cannot beat the
+// current top results, and the search stops at a time budget with whatever
+// it has found so far.
+class TeamComposer {
+public:
+    static constexpr int kTeamSize = 5;
+    static constexpr int kRoleCount = 6;
+    static const char* RoleName(int role);
+    // Bit mask of ddragon champion tags ("Fighter", "Tank", ...)
+    static uint8_t RoleMask(const std::vector<std::string>& tags);
+
+    struct Champion {
+        uint8_t roles = 0;
+        float frontline = 0.0f;    // effective HP if the champion can front line (Tank or Fighter), else 0
+        float physical = 0.0f;     // ddragon "info" attack rating
+        float magic = 0.0f;        // ddragon "info" magic rating
+        bool ranged = false;
+    };
+
+    struct Weights {
+        float coverage = 1.0f;
+        float frontline = 1.0f;
+        float damage = 1.0f;
+        float range = 0.5f;
+    };
+
+    struct Request {
+        std::vector<Champion> champions;   // by champion ordinal
+        std::vector<uint32_t> picked;      // already on the team
+        std::vector<uint32_t> excluded;    // never suggested
+        Weights weights;
+        size_t keep = 10;
+        double timeBudget = 2.0;           // seconds
+    };
+
+    // Each term is 0 - 1; total is their weighted mean in percent.
+    struct Breakdown {
+        float coverage = 0.0f;
+        float frontline = 0.0f;
+        float damage = 0.0f;
+        float range = 0.0f;
+        float total = 0.0f;
+    };
+
+    struct Team {
+        std::array<uint32_t, kTeamSize> members{};
+        int count = 0;
+        float score = 0.0f;
+    };
+
+    struct Progress {
+        bool running = false;
+        bool timedOut = false;
+        uint64_t nodes = 0;
+        size_t tasksDone = 0;
+        size_t tasksTotal = 0;
+        double seconds = 0.0;
+        std::vector<Team> best;            // best first
+    };
+
+    TeamComposer() = default;
+    ~TeamComposer();
+
+    // Cancels any running search and starts a new one on the shared pool.
+    void Start(Request newRequest);
+    void Cancel();
+    Progress GetProgress() const;
+
+    // The largest frontline value. The frontline term is 1 - exp(-sum / reference),
+    // so the tankiest champion alone scores 0.63 and two of them 0.86.
+    static float FrontlineReference(const std::vector<Champion>& champions);
+    static Breakdown Score(const std::vector<Champion>& champions, const std::vector<uint32_t>& members,
+                           const Weights& weights, float frontlineReference);
+
+private:
+    // Running sums of a partial team
+    struct State {
+        uint8_t roles = 0;
+        int ranged = 0;
+        float frontline = 0.0f;
+        float physical = 0.0f;
+        float magic = 0.0f;
+    };
+
+    Request request;
+    float frontlineReference = 1.0f;
+    int open = 0;                                  // slots to fill
+    State base;                                    // the picked champions
+    std::vector<Champion> candidates;              // best single pick first
+    std::vector<uint32_t> ordinals;
+    // Suffix summaries of candidates i.., for the bound
+    std::vector<uint8_t> suffixRoles;
+    std::vector<float> suffixTopFrontline;         // [i * (kTeamSize + 1) + k]: k largest frontline values
+    std::vector<float> suffixMaxPhysicalLead;      // max physical - magic
+    std::vector<float> suffixMaxMagicLead;         // max magic - physical
+    std::vector<float> suffixMaxDamage;            // max physical + magic
+    std::vector<std::pair<uint32_t, uint32_t>> tasks;
+
+    std::atomic<bool> stopping{ false };
+    std::atomic<bool> timedOut{ false };
+    std::atomic<size_t> tasksDone{ 0 };
+    std::atomic<uint64_t> nodes{ 0 };
+    std::atomic<float> threshold{ 0.0f };
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point deadline;
+    std::atomic<double> finishedSeconds{ 0.0 };
+
+    TaskGroup search;
+    std::atomic<size_t> pendingTasks{ 0 };
+
+    mutable std::mutex resultMutex;
+    std::vector<Team> best;
+
+    void Prepare();
+    State Add(const State& state, const Champion& champion) const;
+    float Evaluate(const State& state) const;
+    float Bound(size_t next, int remaining, const State& state) const;
+    void Expand(uint32_t candidate, int depth, Team& team, const State& state, uint64_t& localNodes);
+    void RunTask(size_t task);
+    void Offer(const Team& team);
+    bool ShouldStop();
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <filesystem>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "SearchIndex.h"
+#include "TaskPool.h"
+
+// Full-text index over lore, abilities, tips and item descriptions.
+// Documents are queued from the data thread and tokenized by a background
+// task on the shared pool (markup stripped, case and diacritics folded, light suffix stemming),
+// then ranked with BM25. The index is saved to disk so that details fetched in
+// earlier sessions are searchable immediately.
+class TextIndex {
+public:
+    enum class Field : uint8_t {
+        Summary,
+        Lore,
+        Passive,
+        Spell,
+        AllyTip,
+        EnemyTip,
+        ItemDescription,
+        ItemPassive,
+        ItemActive
+    };
+
+    // How complete an owner's documents are. A later batch only replaces the
+    // documents of an owner if it is at least as deep.
+    enum class Depth : uint8_t {
+        Summary,
+        Detail
+    };
+
+    struct Document {
+        Field field;
+        uint8_t slot = 0;        // spell index or tip index within the owner
+        std::string label;       // e.g. "Q - Rocket Grab"
+        std::string text;        // raw text, markup allowed
+    };
+
+    struct Hit {
+        SearchIndex::EntityKind kind;
+        std::string key;         // champion id or item id
+        Field field;
+        uint8_t slot;
+        std::string label;
+        std::string snippet;
+        float score;
+    };
+
+    TextIndex();
+    ~TextIndex();
+
+    // Queues the documents of one champion or item for indexing, replacing
+    // any previous documents of that owner of the same or lower depth.
+    void Enqueue(SearchIndex::EntityKind kind, const std::string& key, Depth depth, std::vector<Document> documents);
+    bool HasOwner(SearchIndex::EntityKind kind, const std::string& key, Depth minDepth) const;
+
+    // BM25 ranked search. With onePerOwner set, only the best document of each
+    // champion or item is returned.
+    std::vector<Hit> Search(const std::string& query, size_t maxResults, bool onePerOwner = true) const;
+
+    bool Save(const std::filesystem::path& path, const std::string& version) const;
+    bool Load(const std::filesystem::path& path, const std::string& version);
+
+    size_t PendingCount() const;
+    // Returns once every batch queued so far is applied
+    void WaitUntilIdle() { drainTasks.Wait(); }
+    size_t DocumentCount() const;
+    bool IsDirty() const { return dirty.load(); }
+
+    static std::string StripMarkup(const std::string& text);
+    static std::vector<std::string> Tokenize(const std::string& text);
+
+private:
+    struct StoredDocument {
+        uint32_t owner;
+        Field field;
+        uint8_t slot;
+        std::string label;
+        std::string text;        // markup stripped, used for snippets
+        uint32_t length;         // token count
+        bool live;
+    };
+    struct Owner {
+        SearchIndex::EntityKind kind;
+        std::string key;
+        Depth depth;
+        std::vector<uint32_t> documents;
+    };
+    struct Posting {
+        uint32_t document;
+        uint32_t frequency;
+    };
+    struct Batch {
+        SearchIndex::EntityKind kind;
+        std::string key;
+        Depth depth;
+        std::vector<Document> documents;
+    };
+
+    mutable std::mutex indexMutex;
+    std::vector<StoredDocument> documents;
+    std::vector<Owner> owners;
+    std::unordered_map<std::string, uint32_t> ownerIds;     // "<kind>:<key>" -> owner
+    std::unordered_map<std::string, uint32_t> termIds;
+    std::vector<std::vector<Posting>> postings;
+    uint64_t liveDocuments = 0;
+    uint64_t liveTokens = 0;
+
+    mutable std::mutex queueMutex;
+    std::deque<Batch> queue;
+    bool draining = false;                      // a Drain task owns the queue
+    bool stopping = false;
+    TaskGroup drainTasks;
+    mutable std::atomic<bool> dirty{ false };   // cleared by Save
+
+    void Drain();
+    void Apply(Batch& batch);
+    uint32_t GetOwner(SearchIndex::EntityKind kind, const std::string& key);
+    static std::string OwnerKey(SearchIndex::EntityKind kind, const std::string& key);
+    static std::string MakeSnippet(const std::string& text, const std::vector<std::string>& terms);
+};
@@ -0,0 +1,90 @@
+#include "AbilityTable.h"
+#include <algorithm>
+#include <sstream>
+
+namespace {
+    const char* kSlotKeys[AbilityTable::kSlots] = { "Q", "W", "E", "R" };
+
+    // Copies a ddragon per-rank number array into a fixed-width row; missing
+    // ranks repeat the last value so a max-rank read is always valid.
+    void CopyRanks(const nlohmann::json& values, float* out, int maxRank) {
+        float last = 0.0f;
+        for (int rank = 0; rank < AbilityTable::kMaxRanks; ++rank) {
+            if (values.is_array() && rank < static_cast<int>(values.size()) && values[rank].is_number()) {
+                last = values[rank].get<float>();
+            }
+            out[rank] = rank < maxRank ? last : 0.0f;
+        }
+    }
+}
+
+const char* AbilityTable::SlotKey(int slot) {
+    return slot >= 0 && slot < kSlots ? kSlotKeys[slot] : "";
+}
+
+std::atomic<uint64_t> AbilityTable::nextGeneration{ 1 };
+
+void AbilityTable::Reset() {
+    generation = nextGeneration++;
+    abilities.clear();
+    cooldown.clear();
+    cost.clear();
+    range.clear();
+    effect.clear();
+}
+
+bool AbilityTable::Add(uint32_t champion, int slot, const nlohmann::json& spell) {
+    int maxRank = std::min(kMaxRanks, spell.value("maxrank", 0));
+    if (maxRank <= 0) {
+        return false;
+    }
+
+    Ability ability;
+    ability.champion = champion;
+    ability.slot = static_cast<uint8_t>(slot);
+    ability.maxRank = static_cast<uint8_t>(maxRank);
+    ability.name = spell.value("name", "");
+    abilities.push_back(ability);
+
+    size_t row = abilities.size() - 1;
+    cooldown.resize(abilities.size() * kMaxRanks);
+    cost.resize(abilities.size() * kMaxRanks);
+    range.resize(abilities.size() * kMaxRanks);
+    effect.resize(abilities.size() * kMaxEffects * kMaxRanks);
+    CopyRanks(spell.value("cooldown", nlohmann::json()), &cooldown[row * kMaxRanks], maxRank);
+    CopyRanks(spell.value("cost", nlohmann::json()), &cost[row * kMaxRanks], maxRank);
+    CopyRanks(spell.value("range", nlohmann::json()), &range[row * kMaxRanks], maxRank);
+
+    // effect[0] is always null in ddragon, e1 is effect[1]
+    const nlohmann::json effects = spell.value("effect", nlohmann::json());
+    for (int e = 1; e <= kMaxEffects; ++e) {
+        nlohmann::json values = effects.is_array() && e < static_cast<int>(effects.size()) ? effects[e] : nlohmann::json();
+        CopyRanks(values, &effect[(row * kMaxEffects + (e - 1)) * kMaxRanks], maxRank);
+    }
+    return true;
+}
+
+void AbilityTable::HasteCooldowns(float abilityHaste, std::vector<float>& out) const {
+    float scale = 100.0f / (100.0f + std::max(0.0f, abilityHaste));
+    out.resize(cooldown.size());
+    const float* in = cooldown.data();
+    float* result = out.data();
+    for (size_t i = 0; i < cooldown.size(); ++i) {
+        result[i] = in[i] * scale;
+    }
+}
+
+std::vector<float> AbilityTable::ParseBurn(const std::string& burn) {
+    std::vector<float> values;
+    std::stringstream stream(burn);
+    std::string part;
+    while (std::getline(stream, part, '/')) {
+        try {
+            values.push_back(std::stof(part));
+        }
+        catch (const std::exception&) {
+            values.push_back(0.0f);
+        }
+    }
+    return values;
+}
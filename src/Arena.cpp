@@ -0,0 +1,68 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+Arena::Arena(size_t blockSize) : blockSize(blockSize) {
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+    if (!blocks.empty()) {
+        Block& block = blocks.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+        if (aligned + size <= block.size) {
+            offset = aligned + size;
+            return block.data.get() + aligned;
+        }
+        used += offset;
+    }
+
+    // A new block; oversized requests get a block of their own size
+    size_t capacity = std::max(blockSize, size + alignment);
+    blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[capacity]), capacity });
+    uintptr_t base = reinterpret_cast<uintptr_t>(blocks.back().data.get());
+    size_t aligned = ((base + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+    offset = aligned + size;
+    return blocks.back().data.get() + aligned;
+}
+
+std::string_view Arena::Store(std::string_view text) {
+    char* copy = static_cast<char*>(Allocate(text.size() + 1, 1));
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+    return std::string_view(copy, text.size());
+}
+
+const char* Arena::Format(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list measure;
+    va_copy(measure, args);
+    int length = std::vsnprintf(nullptr, 0, format, measure);
+    va_end(measure);
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+    char* text = static_cast<char*>(Allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, format, args);
+    va_end(args);
+    return text;
+}
+
+void Arena::Reset() {
+    // Everything in one block next time round
+    if (blocks.size() > 1) {
+        size_t total = 0;
+        for (const auto& block : blocks) {
+            total += block.size;
+        }
+        blocks.clear();
+        blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[total]), total });
+    }
+    offset = 0;
+    used = 0;
+}
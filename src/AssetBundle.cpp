@@ -0,0 +1,237 @@
+#include "AssetBundle.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <zlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+namespace {
+    constexpr char kMagic[4] = { 'L', 'B', 'D', 'L' };
+    constexpr uint32_t kFormat = 1;
+    constexpr size_t kPatchLength = 32;
+    constexpr size_t kNameLength = 48;
+
+    // magic, format, patch, entry count, then per entry a name and four u32s
+    constexpr size_t kHeaderSize = 4 + 4 + kPatchLength + 4;
+    constexpr size_t kEntrySize = kNameLength + 4 * 4;
+
+    void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void PutText(std::vector<uint8_t>& out, const std::string& text, size_t width) {
+        size_t length = std::min(text.size(), width - 1);
+        out.insert(out.end(), text.begin(), text.begin() + length);
+        out.insert(out.end(), width - length, 0);
+    }
+
+    uint32_t GetU32(const uint8_t* bytes) {
+        return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+    }
+
+    std::string GetText(const uint8_t* bytes, size_t width) {
+        return std::string(reinterpret_cast<const char*>(bytes), strnlen(reinterpret_cast<const char*>(bytes), width));
+    }
+
+    uint32_t Checksum(const std::vector<uint8_t>& bytes) {
+        return static_cast<uint32_t>(crc32(0L, bytes.data(), static_cast<uInt>(bytes.size())));
+    }
+}
+
+std::vector<uint8_t> AssetBundle::Atlas::Cell(size_t index) const {
+    std::vector<uint8_t> cell(static_cast<size_t>(cellSize) * cellSize * 4);
+    if (columns <= 0 || index >= static_cast<size_t>(columns) * rows) {
+        return cell;
+    }
+    size_t x = (index % columns) * cellSize;
+    size_t y = (index / columns) * cellSize;
+    size_t rowBytes = static_cast<size_t>(cellSize) * 4;
+    for (int row = 0; row < cellSize; ++row) {
+        const uint8_t* source = pixels.data() + ((y + row) * Width() + x) * 4;
+        std::memcpy(cell.data() + row * rowBytes, source, rowBytes);
+    }
+    return cell;
+}
+
+AssetBundle::Writer::Writer(const std::string& patch) : patch(patch) {
+}
+
+void AssetBundle::Writer::Add(const std::string& name, const std::vector<uint8_t>& bytes) {
+    uLongf bound = compressBound(static_cast<uLong>(bytes.size()));
+    Pending entry{ name, static_cast<uint32_t>(bytes.size()), Checksum(bytes), std::vector<uint8_t>(bound) };
+    if (compress2(entry.compressed.data(), &bound, bytes.data(), static_cast<uLong>(bytes.size()), Z_BEST_COMPRESSION) != Z_OK) {
+        std::cerr << "Failed to compress " << name << std::endl;
+        return;
+    }
+    entry.compressed.resize(bound);
+    entries.push_back(std::move(entry));
+}
+
+void AssetBundle::Writer::AddAtlas(const std::string& name, const Atlas& atlas) {
+    std::vector<uint8_t> bytes;
+    PutU32(bytes, static_cast<uint32_t>(atlas.cellSize));
+    PutU32(bytes, static_cast<uint32_t>(atlas.columns));
+    PutU32(bytes, static_cast<uint32_t>(atlas.rows));
+    PutU32(bytes, static_cast<uint32_t>(atlas.keys.size()));
+    for (const auto& key : atlas.keys) {
+        PutU32(bytes, static_cast<uint32_t>(key.size()));
+        bytes.insert(bytes.end(), key.begin(), key.end());
+    }
+    bytes.insert(bytes.end(), atlas.pixels.begin(), atlas.pixels.end());
+    Add(name, bytes);
+}
+
+bool AssetBundle::Writer::Save(const std::filesystem::path& path) const {
+    std::vector<uint8_t> header;
+    header.insert(header.end(), kMagic, kMagic + sizeof(kMagic));
+    PutU32(header, kFormat);
+    PutText(header, patch, kPatchLength);
+    PutU32(header, static_cast<uint32_t>(entries.size()));
+
+    uint32_t offset = static_cast<uint32_t>(kHeaderSize + entries.size() * kEntrySize);
+    for (const auto& entry : entries) {
+        PutText(header, entry.name, kNameLength);
+        PutU32(header, offset);
+        PutU32(header, static_cast<uint32_t>(entry.compressed.size()));
+        PutU32(header, entry.size);
+        PutU32(header, entry.crc);
+        offset += static_cast<uint32_t>(entry.compressed.size());
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    for (const auto& entry : entries) {
+        out.write(reinterpret_cast<const char*>(entry.compressed.data()), static_cast<std::streamsize>(entry.compressed.size()));
+    }
+    return static_cast<bool>(out);
+}
+
+bool AssetBundle::Load(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    owned = std::move(bytes);
+    if (!Parse(owned.data(), owned.size())) {
+        owned.clear();
+        return false;
+    }
+    return true;
+}
+
+bool AssetBundle::LoadEmbedded(int resourceId) {
+#ifdef _WIN32
+    HRSRC resource = FindResourceW(nullptr, MAKEINTRESOURCEW(resourceId), MAKEINTRESOURCEW(10));   // RT_RCDATA
+    if (!resource) {
+        return false;
+    }
+    HGLOBAL handle = LoadResource(nullptr, resource);
+    const void* bytes = handle ? LockResource(handle) : nullptr;
+    if (!bytes) {
+        return false;
+    }
+    return Parse(static_cast<const uint8_t*>(bytes), SizeofResource(nullptr, resource));
+#else
+    (void)resourceId;
+    return false;
+#endif
+}
+
+bool AssetBundle::Parse(const uint8_t* bytes, size_t length) {
+    data = nullptr;
+    size = 0;
+    entries.clear();
+    if (length < kHeaderSize || std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0 || GetU32(bytes + 4) != kFormat) {
+        return false;
+    }
+    uint32_t count = GetU32(bytes + 8 + kPatchLength);
+    if (count > (length - kHeaderSize) / kEntrySize) {
+        return false;
+    }
+    std::vector<Entry> parsed;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t* record = bytes + kHeaderSize + i * kEntrySize;
+        Entry entry{ GetText(record, kNameLength), GetU32(record + kNameLength), GetU32(record + kNameLength + 4),
+            GetU32(record + kNameLength + 8), GetU32(record + kNameLength + 12) };
+        if (entry.offset > length || entry.compressedSize > length - entry.offset) {
+            return false;
+        }
+        parsed.push_back(std::move(entry));
+    }
+    patch = GetText(bytes + 8, kPatchLength);
+    entries = std::move(parsed);
+    data = bytes;
+    size = length;
+    return true;
+}
+
+bool AssetBundle::Has(const std::string& name) const {
+    for (const auto& entry : entries) {
+        if (entry.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetBundle::Extract(const std::string& name, std::vector<uint8_t>& out) const {
+    for (const auto& entry : entries) {
+        if (entry.name != name) {
+            continue;
+        }
+        out.assign(entry.size, 0);
+        uLongf length = entry.size;
+        if (uncompress(out.data(), &length, data + entry.offset, entry.compressedSize) != Z_OK ||
+            length != entry.size || Checksum(out) != entry.crc) {
+            std::cerr << "Bundled " << name << " is corrupt" << std::endl;
+            out.clear();
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool AssetBundle::ExtractAtlas(const std::string& name, Atlas& atlas) const {
+    std::vector<uint8_t> bytes;
+    if (!Extract(name, bytes) || bytes.size() < 16) {
+        return false;
+    }
+    size_t position = 16;
+    atlas.cellSize = static_cast<int>(GetU32(bytes.data()));
+    atlas.columns = static_cast<int>(GetU32(bytes.data() + 4));
+    atlas.rows = static_cast<int>(GetU32(bytes.data() + 8));
+    uint32_t keyCount = GetU32(bytes.data() + 12);
+    atlas.keys.clear();
+    for (uint32_t i = 0; i < keyCount; ++i) {
+        if (bytes.size() - position < 4) {
+            return false;
+        }
+        uint32_t length = GetU32(bytes.data() + position);
+        position += 4;
+        if (bytes.size() - position < length) {
+            return false;
+        }
+        atlas.keys.emplace_back(reinterpret_cast<const char*>(bytes.data() + position), length);
+        position += length;
+    }
+    size_t pixelBytes = static_cast<size_t>(atlas.Width()) * atlas.rows * atlas.cellSize * 4;
+    if (bytes.size() - position != pixelBytes || keyCount > static_cast<size_t>(atlas.columns) * atlas.rows) {
+        return false;
+    }
+    atlas.pixels.assign(bytes.begin() + position, bytes.end());
+    return true;
+}
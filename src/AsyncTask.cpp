@@ -0,0 +1,49 @@
+#include "AsyncTask.h"
+#include <iostream>
+#include <chrono>
+
+AsyncScope::~AsyncScope() {
+    Cancel();
+}
+
+void AsyncScope::Cancel() {
+    cancelled = true;
+    // Jobs waiting for the main thread only finish if their hop is run here
+    while (active > 0) {
+        TaskPool::RunMainThreadTasks();
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait_for(lock, std::chrono::milliseconds(1), [this] { return active == 0; });
+    }
+    std::lock_guard<std::mutex> lock(doneMutex);
+    cancelled = false;
+}
+
+void AsyncScope::Enter() {
+    ++active;
+}
+
+void AsyncScope::Leave() {
+    // Under the lock, so Cancel cannot return and free the scope before notify
+    std::lock_guard<std::mutex> lock(doneMutex);
+    --active;
+    done.notify_all();
+}
+
+void AsyncJob::promise_type::unhandled_exception() {
+    try {
+        throw;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception in background job: " << e.what() << std::endl;
+    }
+    catch (...) {
+        std::cerr << "Unknown exception in background job" << std::endl;
+    }
+}
+
+void AsyncJob::Start(AsyncScope& scope) {
+    scope.Enter();
+    auto job = std::exchange(handle, nullptr);
+    job.promise().scope = &scope;
+    job.resume();
+}
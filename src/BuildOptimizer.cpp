@@ -0,0 +1,294 @@
+#include "BuildOptimizer.h"
+#include <algorithm>
+#include <numeric>
+#include <cfloat>
+
+namespace {
+    constexpr float kCritDamageBonus = 0.75f;   // crits deal 175%
+    constexpr float kAttackSpeedCap = 2.5f;
+    constexpr uint64_t kNodeFlushInterval = 4096;
+}
+
+const char* BuildOptimizer::MetricName(Metric metric) {
+    switch (metric) {
+    case Metric::EffectiveHealth: return "Effective HP";
+    case Metric::DamagePerSecond: return "Attack DPS";
+    case Metric::GoldEfficiency: return "Gold Efficiency";
+    default: return "";
+    }
+}
+
+BuildOptimizer::~BuildOptimizer() {
+    Cancel();
+}
+
+float BuildOptimizer::Evaluate(const Request& request, const StatVector& itemTotals, float cost) {
+    const StatVector& base = request.champion.stats;
+    auto total = [&base, &itemTotals](Stat stat) { return base[StatIndex(stat)] + itemTotals[StatIndex(stat)]; };
+
+    switch (request.metric) {
+    case Metric::EffectiveHealth: {
+        float armor = std::max(0.0f, total(Stat::Armor));
+        float magicResist = std::max(0.0f, total(Stat::MagicResist));
+        float damageTaken = 0.5f * 100.0f / (100.0f + armor) + 0.5f * 100.0f / (100.0f + magicResist);
+        return total(Stat::Health) / damageTaken;
+    }
+    case Metric::DamagePerSecond: {
+        const auto& champion = request.champion;
+        float bonusAttackSpeed = champion.attackSpeedGrowth + itemTotals[StatIndex(Stat::AttackSpeed)];
+        float attackSpeed = champion.baseAttackSpeed > 0.0f
+            ? champion.baseAttackSpeed * (1.0f + bonusAttackSpeed / 100.0f)
+            : total(Stat::AttackSpeed);
+        attackSpeed = std::min(attackSpeed, kAttackSpeedCap);
+        float crit = std::min(100.0f, total(Stat::CritChance)) / 100.0f;
+        float armor = request.targetArmor * (1.0f - std::min(100.0f, itemTotals[StatIndex(Stat::ArmorPenPercent)]) / 100.0f)
+            - itemTotals[StatIndex(Stat::Lethality)];
+        armor = std::max(0.0f, armor);
+        return total(Stat::AttackDamage) * attackSpeed * (1.0f + kCritDamageBonus * crit) * 100.0f / (100.0f + armor);
+    }
+    case Metric::GoldEfficiency: {
+        if (cost <= 0.0f) {
+            return 0.0f;
+        }
+        float value = 0.0f;
+        for (size_t stat = 0; stat < kStatCount; ++stat) {
+            value += request.goldValues[stat] * itemTotals[stat];
+        }
+        return 100.0f * value / cost;
+    }
+    default:
+        return 0.0f;
+    }
+}
+
+void BuildOptimizer::Prepare(const ItemStatTable& table) {
+    // Order candidates by their score as a single item so good builds are
+    // found early and the threshold rises quickly.
+    std::vector<uint32_t> order;
+    std::vector<float> single;
+    for (uint32_t i = 0; i < request.items.size(); ++i) {
+        if (request.items[i] < table.Size()) {
+            order.push_back(i);
+        }
+    }
+    single.resize(request.items.size(), 0.0f);
+    for (uint32_t i : order) {
+        uint32_t item = request.items[i];
+        single[i] = Evaluate(request, table.Row(item), table.cost[item]);
+    }
+    std::stable_sort(order.begin(), order.end(), [&single](uint32_t a, uint32_t b) { return single[a] > single[b]; });
+
+    candidateCount = order.size();
+    for (auto& column : stats) {
+        column.assign(candidateCount, 0.0f);
+    }
+    cost.assign(candidateCount, 0.0f);
+    groups.assign(candidateCount, 0);
+    ordinals.assign(candidateCount, 0);
+    for (size_t c = 0; c < candidateCount; ++c) {
+        uint32_t i = order[c];
+        uint32_t item = request.items[i];
+        for (size_t stat = 0; stat < kStatCount; ++stat) {
+            stats[stat][c] = table.columns[stat][item];
+        }
+        cost[c] = table.cost[item];
+        groups[c] = i < request.groups.size() ? request.groups[i] : 0;
+        ordinals[c] = item;
+    }
+
+    // Optimistic fills: keep the largest kMaxSlots values of every stat seen so
+    // far while walking the candidates backwards.
+    const size_t stride = (kMaxSlots + 1) * kStatCount;
+    suffixTop.assign((candidateCount + 1) * stride, 0.0f);
+    suffixBestRatio.assign(candidateCount + 1, 0.0f);
+    std::array<std::array<float, kMaxSlots>, kStatCount> top{};
+    for (size_t c = candidateCount; c-- > 0;) {
+        float value = 0.0f;
+        for (size_t stat = 0; stat < kStatCount; ++stat) {
+            auto& largest = top[stat];
+            float v = std::max(0.0f, stats[stat][c]);
+            value += request.goldValues[stat] * stats[stat][c];
+            if (v > largest[kMaxSlots - 1]) {
+                size_t slot = kMaxSlots - 1;
+                while (slot > 0 && largest[slot - 1] < v) {
+                    largest[slot] = largest[slot - 1];
+                    --slot;
+                }
+                largest[slot] = v;
+            }
+            float sum = 0.0f;
+            for (size_t k = 1; k <= kMaxSlots; ++k) {
+                sum += largest[k - 1];
+                suffixTop[c * stride + k * kStatCount + stat] = sum;
+            }
+        }
+        float ratio = cost[c] > 0.0f ? 100.0f * value / cost[c] : 0.0f;
+        suffixBestRatio[c] = std::max(suffixBestRatio[c + 1], ratio);
+    }
+
+    tasks.clear();
+    for (uint32_t first = 0; first < candidateCount; ++first) {
+        tasks.push_back({ first, UINT32_MAX });
+        if (request.slots > 1) {
+            for (uint32_t second = first + 1; second < candidateCount; ++second) {
+                tasks.push_back({ first, second });
+            }
+        }
+    }
+}
+
+float BuildOptimizer::Bound(size_t next, int remaining, const StatVector& totals, float spent) const {
+    float current = Evaluate(request, totals, spent);
+    if (remaining <= 0 || next >= candidateCount) {
+        return current;
+    }
+    if (request.metric == Metric::GoldEfficiency) {
+        // A ratio of sums never exceeds the best of its parts
+        return std::max(current, suffixBestRatio[next]);
+    }
+    // Every other metric only grows with each stat, so the largest values
+    // still available are an upper bound
+    const float* fill = &suffixTop[(next * (kMaxSlots + 1) + remaining) * kStatCount];
+    StatVector optimistic = totals;
+    for (size_t stat = 0; stat < kStatCount; ++stat) {
+        optimistic[stat] += fill[stat];
+    }
+    return Evaluate(request, optimistic, spent);
+}
+
+void BuildOptimizer::Offer(const Build& build) {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    if (best.size() >= request.keep && build.score <= best.back().score) {
+        return;
+    }
+    auto position = std::upper_bound(best.begin(), best.end(), build.score,
+        [](float score, const Build& other) { return score > other.score; });
+    best.insert(position, build);
+    if (best.size() > request.keep) {
+        best.pop_back();
+    }
+    if (best.size() >= request.keep) {
+        threshold = best.back().score;
+    }
+}
+
+bool BuildOptimizer::Add(uint32_t candidate, int depth, Build& build, StatVector& totals, uint64_t& usedGroups, uint64_t& localNodes, bool offer) {
+    if ((groups[candidate] & usedGroups) != 0) {
+        return false;
+    }
+    float newCost = build.cost + cost[candidate];
+    if (request.goldBudget > 0.0f && newCost > request.goldBudget) {
+        return false;
+    }
+    for (size_t stat = 0; stat < kStatCount; ++stat) {
+        totals[stat] += stats[stat][candidate];
+    }
+    usedGroups |= groups[candidate];
+    build.items[depth] = ordinals[candidate];
+    build.count = depth + 1;
+    build.cost = newCost;
+    build.score = Evaluate(request, totals, newCost);
+
+    if (!offer) {
+        return true;
+    }
+    if (++localNodes >= kNodeFlushInterval) {
+        nodes += localNodes;
+        localNodes = 0;
+    }
+    if (build.score > threshold.load(std::memory_order_relaxed)) {
+        Offer(build);
+    }
+    return true;
+}
+
+void BuildOptimizer::Expand(uint32_t candidate, int depth, Build& build, const StatVector& totals, uint64_t usedGroups, uint64_t& localNodes) {
+    Build saved = build;
+    StatVector current = totals;
+    if (!Add(candidate, depth, build, current, usedGroups, localNodes)) {
+        return;
+    }
+
+    int remaining = request.slots - depth - 1;
+    if (remaining > 0 && Bound(candidate + 1, remaining, current, build.cost) > threshold.load(std::memory_order_relaxed)) {
+        for (uint32_t next = candidate + 1; next < candidateCount && !stopping; ++next) {
+            Expand(next, depth + 1, build, current, usedGroups, localNodes);
+        }
+    }
+    build = saved;
+}
+
+void BuildOptimizer::RunBranch() {
+    size_t task = nextTask++;
+    if (task >= tasks.size() || stopping) {
+        if (--activeWorkers == 0) {
+            finishedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        }
+        return;
+    }
+
+    uint64_t localNodes = 0;
+    auto [first, second] = tasks[task];
+    Build build;
+    StatVector totals{};
+    uint64_t usedGroups = 0;
+    if (second == UINT32_MAX) {
+        Add(first, 0, build, totals, usedGroups, localNodes);
+    }
+    // The single item build has its own task, so the first item is only added here
+    else if (Add(first, 0, build, totals, usedGroups, localNodes, false) &&
+             Bound(second, request.slots - 1, totals, build.cost) > threshold.load(std::memory_order_relaxed)) {
+        Expand(second, 1, build, totals, usedGroups, localNodes);
+    }
+    nodes += localNodes;
+    ++branchesDone;
+
+    // One branch per task, so other work on the pool gets a turn between
+    // branches; branches are still taken in order, best candidates first.
+    search.Run([this] { RunBranch(); });
+}
+
+void BuildOptimizer::Start(const ItemStatTable& table, Request newRequest) {
+    Cancel();
+    request = std::move(newRequest);
+    request.slots = std::clamp(request.slots, 1, kMaxSlots);
+    request.keep = std::max<size_t>(1, request.keep);
+    Prepare(table);
+
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        best.clear();
+    }
+    threshold = -FLT_MAX;
+    nextTask = 0;
+    branchesDone = 0;
+    nodes = 0;
+    finishedSeconds = 0.0;
+    startTime = std::chrono::steady_clock::now();
+
+    unsigned int chains = TaskPool::Shared().ThreadCount();
+    activeWorkers = chains;
+    for (unsigned int i = 0; i < chains; ++i) {
+        search.Run([this] { RunBranch(); });
+    }
+}
+
+void BuildOptimizer::Cancel() {
+    stopping = true;
+    search.Wait();
+    stopping = false;
+}
+
+BuildOptimizer::Progress BuildOptimizer::GetProgress() const {
+    Progress progress;
+    progress.running = activeWorkers > 0;
+    progress.nodes = nodes;
+    progress.branchesDone = branchesDone;
+    progress.branchesTotal = tasks.size();
+    progress.seconds = progress.running
+        ? std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count()
+        : finishedSeconds.load();
+    std::lock_guard<std::mutex> lock(resultMutex);
+    progress.best = best;
+    return progress;
+}
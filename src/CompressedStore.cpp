@@ -0,0 +1,80 @@
+#include "CompressedStore.h"
+#include <iostream>
+#include <zlib.h>
+
+namespace {
+    // zlib only looks back 32 KB, so a longer dictionary is wasted
+    constexpr size_t kDictionarySize = 32 * 1024;
+}
+
+void CompressedStore::Put(const std::string& key, std::string_view text) {
+    if (dictionary.empty() && !text.empty()) {
+        // The tail of the seed text, since the end of a dictionary is matched best
+        dictionary.assign(text.substr(text.size() > kDictionarySize ? text.size() - kDictionarySize : 0));
+        storedBytes += dictionary.size();
+    }
+
+    z_stream stream{};
+    if (deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+        std::cerr << "Failed to start compressing " << key << std::endl;
+        return;
+    }
+    if (!dictionary.empty()) {
+        deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.data()), static_cast<uInt>(dictionary.size()));
+    }
+
+    Entry entry;
+    entry.size = static_cast<uint32_t>(text.size());
+    entry.compressed.resize(deflateBound(&stream, static_cast<uLong>(text.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    stream.avail_in = static_cast<uInt>(text.size());
+    stream.next_out = entry.compressed.data();
+    stream.avail_out = static_cast<uInt>(entry.compressed.size());
+    int result = deflate(&stream, Z_FINISH);
+    entry.compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        std::cerr << "Failed to compress " << key << std::endl;
+        return;
+    }
+    entry.compressed.shrink_to_fit();
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        storedBytes -= it->second.compressed.size();
+        textBytes -= it->second.size;
+    }
+    storedBytes += entry.compressed.size();
+    textBytes += entry.size;
+    entries[key] = std::move(entry);
+}
+
+bool CompressedStore::Get(const std::string& key, std::string& text) const {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+    const Entry& entry = it->second;
+
+    z_stream stream{};
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    text.resize(entry.size);
+    stream.next_in = const_cast<Bytef*>(entry.compressed.data());
+    stream.avail_in = static_cast<uInt>(entry.compressed.size());
+    stream.next_out = reinterpret_cast<Bytef*>(text.data());
+    stream.avail_out = static_cast<uInt>(text.size());
+    int result = inflate(&stream, Z_FINISH);
+    if (result == Z_NEED_DICT) {
+        inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.data()), static_cast<uInt>(dictionary.size()));
+        result = inflate(&stream, Z_FINISH);
+    }
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END || stream.total_out != entry.size) {
+        std::cerr << "Stored text for " << key << " is corrupt" << std::endl;
+        text.clear();
+        return false;
+    }
+    return true;
+}
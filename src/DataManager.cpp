@@ -1,106 +1,1116 @@
 #include "DataManager.h"
+#include "resource1.h"
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
 
-DataManager::DataManager() : client("ddragon.leagueoflegends.com"), itemClient("cdn.merakianalytics.com") {}
+namespace {
+    std::string StringField(const nlohmann::json& object, const char* key) {
+        auto it = object.find(key);
+        return (it != object.end() && it->is_string()) ? it->get<std::string>() : std::string();
+    }
+
+    // Lore, passive, spells and tips of one champion from its detail json
+    std::vector<TextIndex::Document> BuildChampionDocuments(const nlohmann::json& champion) {
+        std::vector<TextIndex::Document> documents;
+        documents.push_back({ TextIndex::Field::Lore, 0, "Lore", StringField(champion, "lore") });
+
+        if (champion.contains("passive")) {
+            const auto& passive = champion["passive"];
+            documents.push_back({ TextIndex::Field::Passive, 0, "Passive - " + StringField(passive, "name"),
+                StringField(passive, "description") });
+        }
+
+        const char* keys[] = { "Q", "W", "E", "R" };
+        if (champion.contains("spells")) {
+            const auto& spells = champion["spells"];
+            for (uint8_t i = 0; i < spells.size() && i < 4; ++i) {
+                documents.push_back({ TextIndex::Field::Spell, i, std::string(keys[i]) + " - " + StringField(spells[i], "name"),
+                    StringField(spells[i], "description") });
+            }
+        }
+
+        auto addTips = [&documents, &champion](const char* key, TextIndex::Field field, const char* label) {
+            if (!champion.contains(key)) {
+                return;
+            }
+            const auto& tips = champion[key];
+            for (uint8_t i = 0; i < tips.size() && i < 255; ++i) {
+                if (tips[i].is_string()) {
+                    documents.push_back({ field, i, label, tips[i].get<std::string>() });
+                }
+            }
+        };
+        addTips("allytips", TextIndex::Field::AllyTip, "Ally tip");
+        addTips("enemytips", TextIndex::Field::EnemyTip, "Enemy tip");
+        return documents;
+    }
+
+    // What the champion accessors read from a detail file, in the same
+    // {"data": {id: {...}}} shape as the whole document
+    nlohmann::json ProjectChampionDetails(std::string_view body, const std::string& championId) {
+        static const std::string_view kFields[] = { "stats", "lore", "spells", "passive", "skins", "allytips", "enemytips" };
+        nlohmann::json champion = nlohmann::json::object();
+        JsonView(body).Find("data").Find(championId).ForEachMember([&champion](std::string_view key, const JsonView& value) {
+            if (std::find(std::begin(kFields), std::end(kFields), key) != std::end(kFields)) {
+                champion[std::string(key)] = value.Materialize();
+            }
+        });
+        nlohmann::json details;
+        details["data"][championId] = std::move(champion);
+        return details;
+    }
+
+    nlohmann::json ParseSource(std::string_view source) {
+        return nlohmann::json::parse(source.begin(), source.end());
+    }
+
+    bool ReadFile(const std::filesystem::path& path, std::string& contents) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        contents = buffer.str();
+        return true;
+    }
+
+    // Through a temporary file, named per thread since the prefetch thread
+    // and the UI can write the same cache entry
+    bool WriteFileAtomically(const std::filesystem::path& path, const std::string& contents) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+        std::filesystem::path temporary = path;
+        temporary += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+                return false;
+            }
+        }
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+    // Removes the files in a directory whose names start with the prefix
+    void RemoveFilesWithPrefix(const std::filesystem::path& directory, const std::string& prefix) {
+        std::error_code error;
+        std::vector<std::filesystem::path> matches;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.path().filename().string().compare(0, prefix.size(), prefix) == 0) {
+                matches.push_back(entry.path());
+            }
+        }
+        for (const auto& path : matches) {
+            std::filesystem::remove(path, error);
+        }
+    }
+
+    constexpr const char* kGameModesUrl = "https://static.developer.riotgames.com/docs/lol/gameModes.json";
+}
+
+DataManager::DataManager() : client("ddragon.leagueoflegends.com"), itemClient("cdn.merakianalytics.com") {
+    cacheDirectory = std::filesystem::current_path() / "cache";
+    // Only the entry table is read here, entries are inflated on first use
+    bundle.LoadEmbedded(IDR_BUNDLE1);
+    LoadCachedPatchVersion();
+    textIndex.Load(cacheDirectory / "fulltext.bin", patchVersion);
+
+    // Empty sections until the fetches publish theirs, so readers never see null
+    auto initial = std::make_shared<Dataset>();
+    initial->champions = std::make_shared<ChampionSet>();
+    initial->abilities = std::make_shared<AbilityTable>();
+    initial->items = std::make_shared<ItemSet>();
+    initial->spells = std::make_shared<SpellSet>();
+    initial->gameModes = std::make_shared<std::vector<GameMode>>();
+    initial->runes = std::make_shared<RuneSet>();
+    initial->profileIcons = std::make_shared<std::vector<int>>();
+    initial->maps = std::make_shared<std::vector<MapInfo>>();
+    auto history = std::make_shared<PatchHistory>();
+    history->Load(cacheDirectory / "history.bin");
+    initial->history = std::move(history);
+    published.store(initial);
+    view = std::move(initial);
+    RegisterModules();
+    // Loads start on the patch above; a newer live one reloads them
+    patchCheck.Run([this] { CheckPatchVersion(); }, TaskPool::Priority::High);
+}
+
+DataManager::~DataManager() {
+    CancelLoads();
+    if (textIndex.IsDirty()) {
+        textIndex.Save(cacheDirectory / "fulltext.bin", GetPatchVersion());
+    }
+}
+
+std::shared_ptr<const DataManager::Dataset> DataManager::GetDataset() const {
+    return published.load();
+}
+
+void DataManager::Refresh() {
+    view = published.load();
+}
+
+void DataManager::Publish(const std::function<void(Dataset&)>& update) {
+    // Copying a Dataset copies section pointers and the name index, nothing more
+    std::lock_guard<std::mutex> lock(publishMutex);
+    auto next = std::make_shared<Dataset>(*published.load());
+    update(*next);
+    published.store(std::move(next));
+}
+
+void DataManager::RegisterModules() {
+    // Champions and items are loaded at startup, the other modules on first
+    // use; the prefetch ones also once the UI is idle. Data Dragon sources
+    // are resolved against the patch current when a failure is logged.
+    auto dataDragon = [this](std::string path) {
+        return [this, path] { return std::vector<std::string>{ GetDataDragonUrl(path) }; };
+    };
+    auto fixed = [](std::string url) {
+        return [url] { return std::vector<std::string>{ url }; };
+    };
+    modules.Register({ "champions", dataDragon("data/en_US/champion.json"), {},
+        [this] { return FetchChampionData(); } });
+    modules.Register({ "items", fixed("https://cdn.merakianalytics.com/riot/lol/resources/latest/en-US/items.json"), {},
+        [this] { return FetchItemData(); } });
+    modules.Register({ "abilities", dataDragon("data/en_US/championFull.json"), { "champions" },
+        [this] { return FetchAbilityData(); } });
+    modules.Register({ "gameModes", fixed(kGameModesUrl), {},
+        [this] { return FetchGameModes(); } });
+    // The spells window filters by game mode, so it needs both
+    modules.Register({ "summonerSpells", dataDragon("data/en_US/summoner.json"), { "gameModes" },
+        [this] { return FetchSummonerSpells(); } });
+    // Nothing shows these yet, so they wait for their first reader
+    modules.Register({ "runes", dataDragon("data/en_US/runesReforged.json"), {},
+        [this] { return FetchRunes(); }, false });
+    modules.Register({ "profileIcons", dataDragon("data/en_US/profileicon.json"), {},
+        [this] { return FetchProfileIcons(); }, false });
+    modules.Register({ "maps", dataDragon("data/en_US/map.json"), {},
+        [this] { return FetchMaps(); }, false });
+}
+
+DatasetRegistry::State DataManager::RequestModule(const std::string& name) const {
+    return modules.Request(name);
+}
+
+bool DataManager::LoadModule(const std::string& name) {
+    return modules.Ensure(name);
+}
+
+DatasetRegistry::State DataManager::RetryModule(const std::string& name) {
+    return modules.Retry(name);
+}
+
+void DataManager::PrefetchModules() {
+    modules.Prefetch();
+}
+
+void DataManager::CancelLoads() {
+    patchCheck.Cancel();
+    modules.Cancel();
+    stopDetailPrefetch = true;
+    detailPrefetch.Wait();
+    localeLoads.Wait();
+}
+
+const std::vector<DataManager::Locale>& DataManager::GetLocales() {
+    // Native names as UTF-8 bytes; the sources are not compiled with /utf-8
+    static const std::vector<Locale> locales = {
+        { "en_US", "English" }, { "de_DE", "Deutsch" }, { "es_ES", "Espa\xc3\xb1ol" }, { "fr_FR", "Fran\xc3\xa7" "ais" },
+        { "it_IT", "Italiano" }, { "pl_PL", "Polski" }, { "pt_BR", "Portugu\xc3\xaas" },
+        { "ru_RU", "\xd0\xa0\xd1\x83\xd1\x81\xd1\x81\xd0\xba\xd0\xb8\xd0\xb9" }, { "tr_TR", "T\xc3\xbcrk\xc3\xa7" "e" },
+        { "vi_VN", "Ti\xe1\xba\xbfng Vi\xe1\xbb\x87t" }, { "ja_JP", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e" }, { "ko_KR", "\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4" },
+        { "zh_CN", "\xe7\xae\x80\xe4\xbd\x93\xe4\xb8\xad\xe6\x96\x87" }, { "zh_TW", "\xe7\xb9\x81\xe9\xab\x94\xe4\xb8\xad\xe6\x96\x87" }
+    };
+    return locales;
+}
+
+const std::string& DataManager::GetLocale() const {
+    static const std::string english = "en_US";
+    return view->locale ? view->locale->locale : english;
+}
+
+const LocaleStrings* DataManager::GetLocaleStrings() const {
+    return view->locale ? view->locale->strings.get() : nullptr;
+}
+
+void DataManager::SetLocale(const std::string& locale) {
+    {
+        std::lock_guard<std::mutex> lock(localeMutex);
+        requestedLocale = locale;
+    }
+    localeLoads.Run([this, locale] {
+        std::shared_ptr<const LocaleStrings> strings;
+        if (locale != "en_US") {
+            strings = LoadLocaleStrings(locale);
+            if (!strings) {
+                return;
+            }
+        }
+        Publish([&](Dataset& next) {
+            // A later request wins even if its table arrived first
+            {
+                std::lock_guard<std::mutex> lock(localeMutex);
+                if (locale != requestedLocale) {
+                    return;
+                }
+            }
+            publishedLocale = locale;
+            publishedStrings = strings;
+            ApplyLocale(next);
+        });
+    }, TaskPool::Priority::High);
+}
+
+std::shared_ptr<const LocaleStrings> DataManager::LoadLocaleStrings(const std::string& locale) {
+    {
+        std::lock_guard<std::mutex> lock(localeMutex);
+        auto it = localeTables.find(locale);
+        if (it != localeTables.end()) {
+            return it->second;
+        }
+    }
+
+    auto strings = std::make_shared<LocaleStrings>();
+    std::filesystem::path cachePath = LocaleCachePath(locale);
+    std::string cached;
+    if (!ReadFile(cachePath, cached) || !strings->Parse(cached)) {
+        // Only the two text documents of the locale; everything else is shared
+        httplib::Client localeClient("ddragon.leagueoflegends.com");
+        std::string base = "/cdn/" + GetPatchVersion() + "/data/" + locale + "/";
+        auto champions = localeClient.Get((base + "champion.json").c_str());
+        auto spells = localeClient.Get((base + "summoner.json").c_str());
+        if (!champions || champions->status != 200 || !spells || spells->status != 200) {
+            std::cerr << "Failed to fetch " << locale << " strings" << std::endl;
+            return nullptr;
+        }
+        try {
+            strings->Build(champions->body, spells->body);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing " << locale << " strings: " << e.what() << std::endl;
+            return nullptr;
+        }
+        WriteFileAtomically(cachePath, strings->Serialize());
+    }
+
+    std::lock_guard<std::mutex> lock(localeMutex);
+    return localeTables.emplace(locale, std::move(strings)).first->second;
+}
+
+void DataManager::ApplyLocale(Dataset& next) const {
+    // Called under publishMutex, from every publish that replaces champions or spells
+    if (!publishedStrings || !next.champions) {
+        next.locale = nullptr;
+        if (next.champions) {
+            next.search.SetEntries(SearchIndex::EntityKind::Champion, next.champions->names);
+        }
+        if (next.spells) {
+            std::vector<std::string> spellNames;
+            for (const auto& spell : next.spells->spells) {
+                spellNames.push_back(spell.name);
+            }
+            next.search.SetEntries(SearchIndex::EntityKind::SummonerSpell, spellNames);
+        }
+        return;
+    }
+
+    auto locale = std::make_shared<LocaleSet>();
+    locale->locale = publishedLocale;
+    locale->strings = publishedStrings;
+    const ChampionSet& champions = *next.champions;
+    for (uint32_t ordinal = 0; ordinal < champions.names.size(); ++ordinal) {
+        // A champion newer than the table keeps its en_US name
+        const LocaleStrings::Champion* localized = publishedStrings->FindChampion(champions.ids[ordinal]);
+        const std::string& name = localized && !localized->name.empty() ? localized->name : champions.names[ordinal];
+        locale->championNames.push_back(name);
+        locale->championByName[Symbols::Intern(name)] = ordinal;
+    }
+    std::vector<std::string> spellNames;
+    if (next.spells) {
+        locale->spells = next.spells->spells;
+        for (auto& spell : locale->spells) {
+            if (const LocaleStrings::Spell* localized = publishedStrings->FindSpell(spell.id)) {
+                spell.name = localized->name;
+                spell.description = localized->description;
+            }
+            spellNames.push_back(spell.name);
+        }
+        next.search.SetEntries(SearchIndex::EntityKind::SummonerSpell, spellNames);
+    }
+    next.search.SetEntries(SearchIndex::EntityKind::Champion, locale->championNames);
+    next.locale = std::move(locale);
+}
+
+void DataManager::IngestHistory(Dataset& next, PatchHistory::Kind kind, const std::string& patch, const std::vector<std::string>& ids, const std::vector<float>& values) {
+    // A patch seen for the first time is added to the history with its changes
+    auto history = std::make_shared<PatchHistory>(*next.history);
+    if (history->Ingest(kind, patch, ids, values)) {
+        history->Save(cacheDirectory / "history.bin");
+        next.history = std::move(history);
+    }
+}
+
+void DataManager::LoadCachedPatchVersion() {
+    // versions.json lists every patch, newest first. The last good copy is
+    // kept so an offline start stays on the patch it last saw.
+    std::string body;
+    if (ReadFile(cacheDirectory / "versions.json", body)) {
+        auto versions = nlohmann::json::parse(body, nullptr, false);
+        if (versions.is_array() && !versions.empty() && versions[0].is_string()) {
+            patchVersion = versions[0].get<std::string>();
+            return;
+        }
+    }
+    // First launch: the bundled patch, else the one this build knows
+    patchVersion = !bundle.Patch().empty() ? bundle.Patch() : kDefaultPatch;
+}
+
+void DataManager::CheckPatchVersion() {
+    httplib::Client versionsClient("ddragon.leagueoflegends.com");
+    versionsClient.set_connection_timeout(3);
+    versionsClient.set_read_timeout(5);
+    auto res = versionsClient.Get("/api/versions.json");
+    if (!res || res->status != 200) {
+        std::cerr << "Failed to resolve the current patch, staying on " << GetPatchVersion() << std::endl;
+        return;
+    }
+    auto versions = nlohmann::json::parse(res->body, nullptr, false);
+    if (!versions.is_array() || versions.empty() || !versions[0].is_string()) {
+        return;
+    }
+    WriteFileAtomically(cacheDirectory / "versions.json", res->body);
+    std::string live = versions[0].get<std::string>();
+    if (live == GetPatchVersion()) {
+        return;
+    }
+    std::cout << "Patch " << GetPatchVersion() << " -> " << live << ", reloading" << std::endl;
+
+    // The prefetch diffs the detail cache against one patch, so it is stopped
+    // before the patch moves and started again by the champion reload
+    stopDetailPrefetch = true;
+    detailPrefetch.Cancel();
+    stopDetailPrefetch = false;
+    {
+        std::lock_guard<std::mutex> lock(patchMutex);
+        patchVersion = live;
+    }
+    detailCacheVerified = false;
+    detailPrefetchStarted = false;
+    reindexDetails = true;
+    {
+        std::lock_guard<std::mutex> lock(detailMutex);
+        championDetails.Clear();
+        championDetailTexts = CompressedStore();
+    }
+    std::string locale;
+    {
+        std::lock_guard<std::mutex> lock(localeMutex);
+        localeTables.clear();
+        locale = requestedLocale;
+    }
+    modules.Reload();
+    if (locale != "en_US") {
+        SetLocale(locale);
+    }
+}
+
+std::string DataManager::GetPatchVersion() const {
+    std::lock_guard<std::mutex> lock(patchMutex);
+    return patchVersion;
+}
+
+std::string DataManager::GetDataDragonUrl(const std::string& path) const {
+    return "https://ddragon.leagueoflegends.com/cdn/" + GetPatchVersion() + "/" + path;
+}
+
+std::filesystem::path DataManager::ImageCachePath(const std::string& url) const {
+    // Data Dragon paths lose their /cdn/<patch> prefix, so an image that did
+    // not change keeps one file across patches
+    size_t scheme = url.find("://");
+    std::string path = scheme == std::string::npos ? url : url.substr(scheme + 3);
+    const std::string cdn = "ddragon.leagueoflegends.com/cdn/";
+    if (path.compare(0, cdn.size(), cdn) == 0) {
+        std::string rest = path.substr(cdn.size());
+        if (!rest.empty() && std::isdigit(static_cast<unsigned char>(rest[0]))) {
+            size_t slash = rest.find('/');
+            rest = slash == std::string::npos ? std::string() : rest.substr(slash + 1);
+        }
+        path = "ddragon/" + rest;
+    }
+    return cacheDirectory / "images" / std::filesystem::path(path).relative_path();
+}
+
+bool DataManager::ReadCachedImage(const std::string& url, std::string& bytes) const {
+    // Champion images wait until the new patch's changes are known
+    if (!detailCacheVerified && url.find("ddragon.leagueoflegends.com") != std::string::npos) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(cacheFilesMutex);
+    return ReadFile(ImageCachePath(url), bytes);
+}
+
+void DataManager::StoreCachedImage(const std::string& url, const std::string& bytes) const {
+    std::shared_lock<std::shared_mutex> lock(cacheFilesMutex);
+    WriteFileAtomically(ImageCachePath(url), bytes);
+}
+
+std::filesystem::path DataManager::DetailCachePath(const std::string& championId, const std::string& locale) const {
+    // en_US details are checked against every new patch; other locales are
+    // kept per patch instead
+    if (locale == "en_US") {
+        return cacheDirectory / "champions" / (championId + ".json");
+    }
+    return cacheDirectory / "locales" / locale / GetPatchVersion() / (championId + ".json");
+}
+
+std::filesystem::path DataManager::LocaleCachePath(const std::string& locale) const {
+    return cacheDirectory / "locales" / locale / GetPatchVersion() / "strings.json";
+}
 
 bool DataManager::FetchChampionData() {
-    auto res = client.Get("/cdn/14.14.1/data/en_US/champion.json");
-    if (res && res->status == 200) {
-        championData = nlohmann::json::parse(res->body);
-        ProcessChampionData();
+    auto champions = std::make_shared<ChampionSet>();
+    std::string patch = GetPatchVersion();
+    // A snapshot of this patch replaces the download and the parse
+    if (!champions->snapshot.Open(SnapshotPath("champions", patch), DatasetSnapshot::Kind::Champions, patch) &&
+        !RestoreBundledSnapshot(champions->snapshot, DatasetSnapshot::Kind::Champions, "champions", patch)) {
+        auto res = client.Get(("/cdn/" + patch + "/data/en_US/champion.json").c_str());
+        if (!res || res->status != 200) {
+            std::cerr << "Failed to fetch champion data" << std::endl;
+            return false;
+        }
+        try {
+            auto image = DatasetSnapshot::BuildChampions(nlohmann::json::parse(res->body), patch);
+            if (!StoreSnapshot(champions->snapshot, DatasetSnapshot::Kind::Champions, "champions", patch, std::move(image))) {
+                return false;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing champion data: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    PruneSnapshots("champions", patch);
+    ProcessChampionData(*champions);
+
+    std::vector<std::string> ids;
+    std::vector<float> values;
+    for (uint32_t ordinal = 0; ordinal < champions->snapshot.Size(); ++ordinal) {
+        const auto& champion = champions->snapshot.Champion(ordinal);
+        ids.push_back(champions->snapshot.String(champion.id));
+        values.insert(values.end(), champion.stats.begin(), champion.stats.end());
+    }
+    Publish([&](Dataset& next) {
+        next.champions = champions;
+        // The ability table is by champion ordinal, so it is rebuilt for the new set
+        next.abilities = std::make_shared<AbilityTable>();
+        next.search.SetEntries(SearchIndex::EntityKind::Champion, champions->names);
+        IngestHistory(next, PatchHistory::Kind::Champion, champions->snapshot.Patch(), ids, values);
+        ApplyLocale(next);
+    });
+    modules.Invalidate("abilities");
+    IndexChampionSummaries(*champions);
+    StartDetailPrefetch(*champions);
+    return true;
+}
+
+std::filesystem::path DataManager::SnapshotPath(const char* name, const std::string& patch) const {
+    return cacheDirectory / (std::string(name) + "-" + patch + ".snapshot");
+}
+
+std::vector<std::filesystem::path> DataManager::OlderSnapshots(const char* name, const std::string& patch) const {
+    // Newest first; a bare name.snapshot is from before files were per patch
+    std::error_code error;
+    std::filesystem::path current = SnapshotPath(name, patch);
+    std::string prefix = std::string(name) + "-";
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> found;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory, error)) {
+        std::string stem = entry.path().stem().string();
+        if (entry.path().extension() != ".snapshot" || entry.path() == current ||
+            (stem != name && stem.compare(0, prefix.size(), prefix) != 0)) {
+            continue;
+        }
+        found.emplace_back(std::filesystem::last_write_time(entry.path(), error), entry.path());
+    }
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<std::filesystem::path> older;
+    for (auto& [written, path] : found) {
+        older.push_back(std::move(path));
+    }
+    return older;
+}
+
+void DataManager::PruneSnapshots(const char* name, const std::string& patch) {
+    // Windows refuses to delete a mapped file; a set of the old patch that
+    // is still being read keeps its file until the next load finds it unmapped
+    std::error_code error;
+    for (const auto& path : OlderSnapshots(name, patch)) {
+        std::filesystem::remove(path, error);
+    }
+}
+
+bool DataManager::StoreSnapshot(DatasetSnapshot& snapshot, DatasetSnapshot::Kind kind, const char* name, const std::string& patch, std::vector<uint8_t> image) {
+    // The snapshot being replaced tells which cached images are still current
+    bool knownPrevious = false;
+    auto previous = ReadPreviousSnapshot(kind, name, patch, knownPrevious);
+
+    // Reading back through the mapping keeps one code path for fresh and
+    // cached data; if the cache can't be written the image is used in memory
+    std::filesystem::path path = SnapshotPath(name, patch);
+    bool stored = (DatasetSnapshot::Write(path, image) && snapshot.Open(path, kind, patch)) ||
+        snapshot.Adopt(std::move(image), kind, patch);
+    if (stored) {
+        InvalidateChangedImages(kind, snapshot, previous, knownPrevious);
+    }
+    return stored;
+}
+
+std::unordered_map<std::string, DataManager::PreviousEntity> DataManager::ReadPreviousSnapshot(DatasetSnapshot::Kind kind, const char* name, const std::string& patch, bool& known) const {
+    std::unordered_map<std::string, PreviousEntity> previous;
+    DatasetSnapshot old;
+    known = false;
+    for (const auto& path : OlderSnapshots(name, patch)) {
+        if (old.Open(path, kind, "")) {
+            known = true;
+            break;
+        }
+    }
+    if (!known) {
+        return previous;
+    }
+    for (uint32_t i = 0; i < old.Size(); ++i) {
+        switch (kind) {
+        case DatasetSnapshot::Kind::Champions:
+            previous[old.String(old.Champion(i).id)] = { old.Champion(i).contentHash, std::string() };
+            break;
+        case DatasetSnapshot::Kind::Items:
+            previous[old.String(old.Item(i).id)] = { old.Item(i).contentHash, old.String(old.Item(i).icon) };
+            break;
+        case DatasetSnapshot::Kind::SummonerSpells:
+            previous[old.String(old.Spell(i).id)] = { old.Spell(i).contentHash, std::string() };
+            break;
+        }
+    }
+    return previous;
+}
+
+void DataManager::InvalidateChangedImages(DatasetSnapshot::Kind kind, const DatasetSnapshot& current,
+    const std::unordered_map<std::string, PreviousEntity>& previous, bool knownPrevious) {
+    // Champion images follow the championFull diff in VerifyDetailCache
+    if (kind == DatasetSnapshot::Kind::Champions) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(cacheFilesMutex);
+    std::error_code error;
+    if (!knownPrevious) {
+        // Nothing to compare with, so none of the cached images can be trusted
+        if (kind == DatasetSnapshot::Kind::Items) {
+            std::filesystem::remove_all(cacheDirectory / "images" / "cdn.merakianalytics.com", error);
+        }
+        else {
+            RemoveFilesWithPrefix(cacheDirectory / "images" / "ddragon" / "img" / "spell", "Summoner");
+        }
+        return;
+    }
+
+    size_t changed = 0;
+    for (uint32_t i = 0; i < current.Size(); ++i) {
+        bool items = kind == DatasetSnapshot::Kind::Items;
+        std::string id = current.String(items ? current.Item(i).id : current.Spell(i).id);
+        uint64_t hash = items ? current.Item(i).contentHash : current.Spell(i).contentHash;
+        auto it = previous.find(id);
+        if (it != previous.end() && it->second.contentHash == hash) {
+            continue;
+        }
+        ++changed;
+        std::string url = items ? current.String(current.Item(i).icon) : GetDataDragonUrl("img/spell/" + id + ".png");
+        std::filesystem::remove(ImageCachePath(url), error);
+        if (it != previous.end() && !it->second.icon.empty() && it->second.icon != url) {
+            std::filesystem::remove(ImageCachePath(it->second.icon), error);
+        }
+    }
+    std::cout << "Patch " << current.Patch() << ": " << changed << " of " << current.Size()
+        << (kind == DatasetSnapshot::Kind::Items ? " items" : " summoner spells") << " changed" << std::endl;
+}
+
+bool DataManager::RestoreBundledSnapshot(DatasetSnapshot& snapshot, DatasetSnapshot::Kind kind, const char* name, const std::string& patch) {
+    // The executable's bundle stands in for the first download of its patch
+    std::vector<uint8_t> image;
+    if (bundle.Patch() != patch || !bundle.Extract(std::string(name) + ".snapshot", image)) {
+        return false;
+    }
+    return StoreSnapshot(snapshot, kind, name, patch, std::move(image));
+}
+
+bool DataManager::GetBundledIcon(const std::string& key, std::vector<uint8_t>& pixels, int& size) const {
+    std::call_once(iconAtlasOnce, [this]() {
+        if (bundle.ExtractAtlas("icons.atlas", iconAtlas)) {
+            for (uint32_t cell = 0; cell < iconAtlas.keys.size(); ++cell) {
+                iconCells[iconAtlas.keys[cell]] = cell;
+            }
+        }
+        IndexBundledHashes();
+    });
+    auto it = iconCells.find(key);
+    if (it == iconCells.end() || !IsBundledIconCurrent(key)) {
+        return false;
+    }
+    pixels = iconAtlas.Cell(it->second);
+    size = iconAtlas.cellSize;
+    return true;
+}
+
+void DataManager::IndexBundledHashes() const {
+    std::vector<uint8_t> image;
+    DatasetSnapshot snapshot;
+    if (bundle.Extract("champions.snapshot", image) &&
+        snapshot.Adopt(std::move(image), DatasetSnapshot::Kind::Champions, bundle.Patch())) {
+        for (size_t i = 0; i < snapshot.Size(); ++i) {
+            bundledHashes["champion/" + snapshot.String(snapshot.Champion(i).id)] = snapshot.Champion(i).contentHash;
+        }
+    }
+    if (bundle.Extract("items.snapshot", image) &&
+        snapshot.Adopt(std::move(image), DatasetSnapshot::Kind::Items, bundle.Patch())) {
+        for (size_t i = 0; i < snapshot.Size(); ++i) {
+            bundledHashes["item/" + snapshot.String(snapshot.Item(i).id)] = snapshot.Item(i).contentHash;
+        }
+    }
+    if (bundle.Extract("summoners.snapshot", image) &&
+        snapshot.Adopt(std::move(image), DatasetSnapshot::Kind::SummonerSpells, bundle.Patch())) {
+        for (size_t i = 0; i < snapshot.Size(); ++i) {
+            bundledHashes["spell/" + snapshot.String(snapshot.Spell(i).id)] = snapshot.Spell(i).contentHash;
+        }
+    }
+}
+
+bool DataManager::IsBundledIconCurrent(const std::string& key) const {
+    if (bundle.Patch() == GetPatchVersion()) {
         return true;
     }
-    std::cerr << "Failed to fetch champion data" << std::endl;
+    // From another patch the icon is only used if its entity is unchanged,
+    // which can't be told until the entity's data has loaded
+    auto bundled = bundledHashes.find(key);
+    if (bundled == bundledHashes.end()) {
+        return false;
+    }
+    size_t slash = key.find('/');
+    std::string_view kind = std::string_view(key).substr(0, slash);
+    std::string_view id = std::string_view(key).substr(slash + 1);
+    auto current = GetDataset();
+    if (kind == "champion") {
+        const auto* record = current->champions->Find(id);
+        return record != nullptr && record->contentHash == bundled->second;
+    }
+    if (kind == "item") {
+        const auto* record = current->items->Find(id);
+        return record != nullptr && record->contentHash == bundled->second;
+    }
+    const DatasetSnapshot& spells = current->spells->snapshot;
+    for (size_t i = 0; i < spells.Size(); ++i) {
+        if (spells.View(spells.Spell(i).id) == id) {
+            return spells.Spell(i).contentHash == bundled->second;
+        }
+    }
     return false;
 }
 
+uint32_t DataManager::ChampionSet::Ordinal(std::string_view championId) const {
+    const uint32_t* ordinal = byId.Find(Symbols::Find(championId));
+    return ordinal ? *ordinal : kNoOrdinal;
+}
+
+const DatasetSnapshot::ChampionRecord* DataManager::ChampionSet::Find(std::string_view championId) const {
+    uint32_t ordinal = Ordinal(championId);
+    return ordinal != kNoOrdinal ? &snapshot.Champion(ordinal) : nullptr;
+}
+
+uint32_t DataManager::ItemSet::Ordinal(std::string_view itemId) const {
+    const uint32_t* ordinal = byId.Find(Symbols::Find(itemId));
+    return ordinal ? *ordinal : kNoOrdinal;
+}
+
+const DatasetSnapshot::ItemRecord* DataManager::ItemSet::Find(std::string_view itemId) const {
+    uint32_t ordinal = Ordinal(itemId);
+    return ordinal != kNoOrdinal ? &snapshot.Item(ordinal) : nullptr;
+}
+
 bool DataManager::FetchSpecificChampionData(const std::string& championId) const {
-    if (specificChampionData.find(championId) != specificChampionData.end()) {
-        return true;  // Data already fetched
+    return FetchChampionDetails(championId, GetLocale()) != nullptr;
+}
+
+AsyncTask<std::shared_ptr<const nlohmann::json>> DataManager::FetchChampionDetailsAsync(std::string championId) const {
+    // The locale is the view's, read before leaving the UI thread
+    std::string locale = GetLocale();
+    std::string key = locale == "en_US" ? championId : locale + "/" + championId;
+    {
+        std::lock_guard<std::mutex> lock(detailMutex);
+        if (const auto* details = championDetails.Get(key)) {
+            co_return *details;
+        }
     }
+    co_await ResumeOn(TaskPool::Io(), TaskPool::Priority::High);
+    co_return FetchChampionDetails(championId, locale);
+}
+
+std::shared_ptr<const nlohmann::json> DataManager::FetchChampionDetails(const std::string& championId, const std::string& locale) const {
+    bool english = locale == "en_US";
+    std::string key = english ? championId : locale + "/" + championId;
+    std::string stored;
+    {
+        std::lock_guard<std::mutex> lock(detailMutex);
+        if (const auto* details = championDetails.Get(key)) {
+            return *details;  // Data already fetched
+        }
+        championDetailTexts.Get(key, stored);
+    }
+    if (!stored.empty()) {
+        // Fetched before and since dropped from the parsed ones
+        auto details = std::make_shared<const nlohmann::json>(nlohmann::json::parse(stored, nullptr, false));
+        if (!details->is_discarded()) {
+            std::lock_guard<std::mutex> lock(detailMutex);
+            return championDetails.Put(key, details);
+        }
+    }
+
+    // Details of champions the last patches left alone are read from disk.
+    // The lock is not held over the download; if two threads race, the first
+    // result is kept.
+    std::filesystem::path cachePath = DetailCachePath(championId, locale);
+    std::string body;
+    bool cached = false;
+    if (!english || detailCacheVerified) {
+        std::shared_lock<std::shared_mutex> lock(cacheFilesMutex);
+        cached = ReadFile(cachePath, body);
+    }
+    if (!cached) {
+        auto res = client.Get(("/cdn/" + GetPatchVersion() + "/data/" + locale + "/champion/" + championId + ".json").c_str());
+        if (!res || res->status != 200) {
+            std::cerr << "Failed to fetch specific champion data for " << championId << std::endl;
+            return nullptr;
+        }
+        body = res->body;
+        std::shared_lock<std::shared_mutex> lock(cacheFilesMutex);
+        WriteFileAtomically(cachePath, body);
+    }
+
+    std::shared_ptr<const nlohmann::json> details;
+    try {
+        details = std::make_shared<const nlohmann::json>(jsonBackend == JsonBackend::OnDemand ?
+            ProjectChampionDetails(body, championId) : nlohmann::json::parse(body));
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception parsing champion details for " << championId << ": " << e.what() << std::endl;
+        std::error_code error;
+        std::filesystem::remove(cachePath, error);
+        return nullptr;
+    }
+    std::string text = details->dump();
+    {
+        std::lock_guard<std::mutex> lock(detailMutex);
+        if (!championDetailTexts.Contains(key)) {
+            championDetailTexts.Put(key, text);
+        }
+        details = championDetails.Put(key, details);
+    }
+    // The full-text index is of the en_US text
+    if (english && !textIndex.HasOwner(SearchIndex::EntityKind::Champion, championId, TextIndex::Depth::Detail)) {
+        textIndex.Enqueue(SearchIndex::EntityKind::Champion, championId, TextIndex::Depth::Detail,
+            BuildChampionDocuments(details->value(nlohmann::json::json_pointer("/data/" + championId), nlohmann::json())));
+    }
+    return details;
+}
+
+nlohmann::json DataManager::GetChampionDetail(const std::string& championName, const char* key) const {
+    std::string championId = GetChampionId(championName);
+    auto details = FetchChampionDetails(championId, GetLocale());
+    if (!details) {
+        return nlohmann::json();
+    }
+    return details->value(nlohmann::json::json_pointer("/data/" + championId + "/" + key), nlohmann::json());
+}
+
+
+void DataManager::ProcessChampionData(ChampionSet& champions) const {
+    const DatasetSnapshot& championSnapshot = champions.snapshot;
+    for (uint32_t ordinal = 0; ordinal < championSnapshot.Size(); ++ordinal) {
+        const auto& champion = championSnapshot.Champion(ordinal);
+        std::string_view name = championSnapshot.View(champion.name);
+        std::string_view id = championSnapshot.View(champion.id);
+        champions.names.emplace_back(name);
+        champions.ids.emplace_back(id);
+        champions.byName[Symbols::Intern(name)] = ordinal;
+        champions.byId[Symbols::Intern(id)] = ordinal;
+    }
+
+    champions.facets.Reset(champions.names.size());
+    champions.facets.Declare("Role", { "Fighter", "Tank", "Mage", "Assassin", "Marksman", "Support" });
+    // The summary list already carries every champion's stats
+    std::vector<ChampionBaseStats> championStats;
+    championStats.reserve(champions.names.size());
+    for (uint32_t ordinal = 0; ordinal < champions.names.size(); ++ordinal) {
+        const auto& champion = championSnapshot.Champion(ordinal);
+        for (uint32_t i = 0; i < champion.tags.count; ++i) {
+            champions.facets.Add("Role", std::string(championSnapshot.ListAt(champion.tags, i)), ordinal);
+        }
+        std::string resource = championSnapshot.String(champion.partype);
+        champions.facets.Add("Resource", resource.empty() ? "None" : resource, ordinal);
+        championStats.push_back(champion.stats);
+    }
+    champions.curves.Compute(championStats);
+}
+
+const StatCurves::Table* DataManager::GetStatCurves() const {
+    return view->champions->curves.Get();
+}
+
+bool DataManager::FetchAbilityData() {
+    auto current = GetDataset();
+    if (current->abilities->Size() > 0) {
+        return true;
+    }
+
+    std::string body;
+    if (!LoadChampionFull(client, body)) {
+        std::cerr << "Failed to fetch ability data" << std::endl;
+        return false;
+    }
+
+    auto abilities = std::make_shared<AbilityTable>();
+    try {
+        BuildAbilityTable(*abilities, *current->champions, nlohmann::json::parse(body));
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception parsing ability data: " << e.what() << std::endl;
+        std::error_code error;
+        std::filesystem::remove(ChampionFullPath(), error);
+        return false;
+    }
+    if (abilities->Size() == 0) {
+        return false;
+    }
+    // Dropped if the champions were replaced meanwhile, since their ordinals
+    // differ; that invalidated the module, so the next request builds it again
+    Publish([&](Dataset& next) {
+        if (next.champions == current->champions) {
+            next.abilities = abilities;
+        }
+    });
+    return true;
+}
 
-    auto res = client.Get(("/cdn/14.14.1/data/en_US/champion/" + championId + ".json").c_str());
-    if (res && res->status == 200) {
-        specificChampionData[championId] = nlohmann::json::parse(res->body);
+std::filesystem::path DataManager::ChampionFullPath() const {
+    return cacheDirectory / ("championFull-" + GetPatchVersion() + ".json");
+}
+
+bool DataManager::LoadChampionFull(httplib::Client& source, std::string& body) const {
+    // championFull is a few megabytes, so it is kept on disk per patch
+    if (ReadFile(ChampionFullPath(), body)) {
         return true;
     }
-    std::cerr << "Failed to fetch specific champion data for " << championId << std::endl;
-    return false;
+    auto res = source.Get(("/cdn/" + GetPatchVersion() + "/data/en_US/championFull.json").c_str());
+    if (!res || res->status != 200) {
+        return false;
+    }
+    body = res->body;
+    WriteFileAtomically(ChampionFullPath(), body);
+    return true;
+}
+
+void DataManager::VerifyDetailCache(const nlohmann::json& champions) {
+    // Every champion's full entry is hashed without its version; a champion
+    // whose hash moved has its cached details and images dropped, the rest
+    // are kept for this patch too. Readers and writers of those files wait
+    // for the whole pass, so none sees it half done or has a fresh file removed.
+    std::unique_lock<std::shared_mutex> lock(cacheFilesMutex);
+    std::string patch = GetPatchVersion();
+    std::filesystem::path hashesPath = cacheDirectory / "champions" / "hashes.json";
+    nlohmann::json previous;
+    std::string body;
+    if (ReadFile(hashesPath, body)) {
+        previous = nlohmann::json::parse(body, nullptr, false);
+    }
+    const nlohmann::json previousHashes = previous.is_object() ? previous.value("hashes", nlohmann::json::object()) : nlohmann::json::object();
+
+    nlohmann::json hashes = nlohmann::json::object();
+    size_t changed = 0;
+    std::error_code error;
+    for (const auto& [id, champion] : champions.items()) {
+        uint64_t hash = DatasetSnapshot::ContentHash(champion);
+        hashes[id] = hash;
+        auto old = previousHashes.find(id);
+        if (old != previousHashes.end() && old->is_number_unsigned() && old->get<uint64_t>() == hash) {
+            continue;
+        }
+        ++changed;
+
+        // Ability images are named in the details; the old and new names both go
+        std::vector<std::string> images = { "img/champion/" + id + ".png" };
+        auto addAbilityImages = [&images](const nlohmann::json& details) {
+            if (details.contains("passive")) {
+                images.push_back("img/passive/" + details["passive"]["image"].value("full", std::string()));
+            }
+            for (const auto& spell : details.value("spells", nlohmann::json::array())) {
+                images.push_back("img/spell/" + spell["image"].value("full", std::string()));
+            }
+        };
+        addAbilityImages(champion);
+        std::string cached;
+        if (ReadFile(DetailCachePath(id, "en_US"), cached)) {
+            nlohmann::json details = nlohmann::json::parse(cached, nullptr, false);
+            if (details.is_object() && details.contains("data") && details["data"].contains(id)) {
+                addAbilityImages(details["data"][id]);
+            }
+        }
+        for (const auto& image : images) {
+            std::filesystem::remove(ImageCachePath(GetDataDragonUrl(image)), error);
+        }
+        RemoveFilesWithPrefix(cacheDirectory / "images" / "ddragon" / "img" / "champion" / "splash", id + "_");
+        std::filesystem::remove(DetailCachePath(id, "en_US"), error);
+    }
+
+    // championFull of earlier patches is not read again
+    RemoveFilesWithPrefix(cacheDirectory, "championFull-");
+    WriteFileAtomically(hashesPath, nlohmann::json{ { "patch", patch }, { "hashes", hashes } }.dump());
+    detailCacheVerified = true;
+    std::cout << "Patch " << previous.value("patch", std::string("(none)")) << " -> " << patch << ": "
+        << changed << " of " << champions.size() << " champions changed" << std::endl;
+}
+
+void DataManager::BuildAbilityTable(AbilityTable& abilities, const ChampionSet& champions, const nlohmann::json& championFull) const {
+    abilities.Reset();
+    if (!championFull.contains("data")) {
+        return;
+    }
+    const auto& data = championFull["data"];
+    for (uint32_t ordinal = 0; ordinal < champions.names.size(); ++ordinal) {
+        auto champion = data.find(champions.snapshot.String(champions.snapshot.Champion(ordinal).id));
+        if (champion == data.end() || !champion->contains("spells")) {
+            continue;
+        }
+        const auto& spells = (*champion)["spells"];
+        for (int slot = 0; slot < AbilityTable::kSlots && slot < static_cast<int>(spells.size()); ++slot) {
+            abilities.Add(ordinal, slot, spells[slot]);
+        }
+    }
 }
 
+const AbilityTable& DataManager::GetAbilityTable() const {
+    return *view->abilities;
+}
 
-void DataManager::ProcessChampionData() {
-    championNames.clear();
-    championNameToIdMap.clear();
-    for (auto& [key, value] : championData["data"].items()) {
-        std::string name = value["name"];
-        championNames.push_back(name);
-        championNameToIdMap[name] = key;
-    }
+const FacetIndex& DataManager::GetChampionFacets() const {
+    return view->champions->facets;
 }
 
 const std::vector<std::string>& DataManager::GetChampionNames() const {
-    return championNames;
+    return view->locale ? view->locale->championNames : view->champions->names;
 }
 
 std::string DataManager::GetChampionId(const std::string& championName) const {
-    auto it = championNameToIdMap.find(championName);
-    if (it != championNameToIdMap.end()) {
-        return it->second;
+    const ChampionSet& champions = *view->champions;
+    // en_US names still resolve under another locale
+    const uint32_t* ordinal = view->locale ? view->locale->championByName.Find(Symbols::Find(championName)) : nullptr;
+    if (!ordinal) {
+        ordinal = champions.byName.Find(Symbols::Find(championName));
+    }
+    if (ordinal) {
+        return champions.ids[*ordinal];
     }
     return championName; // Fallback to the name if ID is not found
 }
 
+std::string DataManager::GetChampionNameById(const std::string& championId) const {
+    if (view->locale) {
+        const LocaleStrings::Champion* localized = view->locale->strings->FindChampion(championId);
+        if (localized) {
+            return localized->name;
+        }
+    }
+    const ChampionSet& champions = *view->champions;
+    const DatasetSnapshot::ChampionRecord* champion = champions.Find(championId);
+    return champion ? champions.snapshot.String(champion->name) : std::string();
+}
+
 std::string DataManager::GetChampionImageUrl(const std::string& championId) const {
     return "https://ddragon.leagueoflegends.com/cdn/img/champion/splash/" + championId + "_0.jpg";
 }
 
 std::string DataManager::GetChampionIconUrl(const std::string& championId) const {
-    return "http://ddragon.leagueoflegends.com/cdn/14.14.1/img/champion/" + championId + ".png";
+    return GetDataDragonUrl("img/champion/" + championId + ".png");
 }
 
 nlohmann::json DataManager::GetChampionStats(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["stats"];
+    return GetChampionDetail(championName, "stats");
+}
+
+ChampionLevelStats DataManager::GetChampionLevelStats(uint32_t ordinal, int level) const {
+    const ChampionSet& champions = *view->champions;
+    if (ordinal >= champions.names.size()) {
+        return ChampionLevelStats();
+    }
+    // Summary stats, so this never waits on a detail download
+    return ChampionStatsAtLevel(champions.snapshot.Champion(ordinal).stats, level);
 }
 
 std::string DataManager::GetChampionTitle(const std::string& championName) const {
     std::string championId = GetChampionId(championName);
-    return championData["data"][championId]["title"];
+    if (view->locale) {
+        const LocaleStrings::Champion* localized = view->locale->strings->FindChampion(championId);
+        if (localized) {
+            return localized->title;
+        }
+    }
+    const ChampionSet& champions = *view->champions;
+    const DatasetSnapshot::ChampionRecord* champion = champions.Find(championId);
+    return champion ? champions.snapshot.String(champion->title) : std::string();
 }
 
 std::string DataManager::GetChampionLore(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["lore"];
+    nlohmann::json lore = GetChampionDetail(championName, "lore");
+    return lore.is_string() ? lore.get<std::string>() : std::string();
 }
 
 std::vector<std::string> DataManager::GetChampionTags(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    return championData["data"][championId]["tags"].get<std::vector<std::string>>();
+    const ChampionSet& champions = *view->champions;
+    const DatasetSnapshot::ChampionRecord* champion = champions.Find(GetChampionId(championName));
+    return champion ? champions.snapshot.Strings(champion->tags) : std::vector<std::string>();
+}
+
+nlohmann::json DataManager::GetChampionInfo(const std::string& championName) const {
+    nlohmann::json info = nlohmann::json::object();
+    const DatasetSnapshot::ChampionRecord* champion = view->champions->Find(GetChampionId(championName));
+    if (champion) {
+        info["attack"] = champion->info[0];
+        info["defense"] = champion->info[1];
+        info["magic"] = champion->info[2];
+        info["difficulty"] = champion->info[3];
+    }
+    return info;
 }
 
 nlohmann::json DataManager::GetChampionSpells(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["spells"];
+    return GetChampionDetail(championName, "spells");
 }
 
 nlohmann::json DataManager::GetChampionPassive(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["passive"];
+    return GetChampionDetail(championName, "passive");
 }
 
 nlohmann::json DataManager::GetChampionData(const std::string& championId) const {
-    return championData["data"][championId];
+    const ChampionSet& champions = *view->champions;
+    const DatasetSnapshot::ChampionRecord* champion = champions.Find(championId);
+    return champion ? ParseSource(champions.snapshot.View(champion->source)) : nlohmann::json();
 }
 
 nlohmann::json DataManager::GetChampionSkins(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["skins"];
+    return GetChampionDetail(championName, "skins");
 }
 
 std::string DataManager::GetChampionSkinImageUrl(const std::string& championId, const std::string& skinNum) const {
@@ -108,243 +1118,376 @@ std::string DataManager::GetChampionSkinImageUrl(const std::string& championId,
 }
 
 std::vector<std::string> DataManager::GetChampionAllyTips(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["allytips"].get<std::vector<std::string>>();
+    nlohmann::json tips = GetChampionDetail(championName, "allytips");
+    return tips.is_array() ? tips.get<std::vector<std::string>>() : std::vector<std::string>();
 }
 
 std::vector<std::string> DataManager::GetChampionEnemyTips(const std::string& championName) const {
-    std::string championId = GetChampionId(championName);
-    FetchSpecificChampionData(championId);
-    return specificChampionData.at(championId)["data"][championId]["enemytips"].get<std::vector<std::string>>();
+    nlohmann::json tips = GetChampionDetail(championName, "enemytips");
+    return tips.is_array() ? tips.get<std::vector<std::string>>() : std::vector<std::string>();
 }
 
 // item window functions
 bool DataManager::FetchItemData() {
-    auto res = itemClient.Get("/riot/lol/resources/latest/en-US/items.json");
-    if (res && res->status == 200) {
+    auto items = std::make_shared<ItemSet>();
+    // A snapshot of this patch replaces the download and the parse
+    std::string patch = GetPatchVersion();
+    if (!items->snapshot.Open(SnapshotPath("items", patch), DatasetSnapshot::Kind::Items, patch) &&
+        !RestoreBundledSnapshot(items->snapshot, DatasetSnapshot::Kind::Items, "items", patch)) {
+        auto res = itemClient.Get("/riot/lol/resources/latest/en-US/items.json");
+        if (!res || res->status != 200) {
+            std::cerr << "Failed to fetch item data" << std::endl;
+            return false;
+        }
         try {
-            itemData = nlohmann::json::parse(res->body);
-            ProcessItemData();
-            //std::cout << "Loaded " << itemData.size() << " items" << std::endl;
-            return true;
+            bool onDemand = jsonBackend == JsonBackend::OnDemand;
+            auto started = std::chrono::steady_clock::now();
+            auto image = onDemand ? DatasetSnapshot::BuildItems(std::string_view(res->body), patch) :
+                DatasetSnapshot::BuildItems(nlohmann::json::parse(res->body), patch);
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+            std::cout << "Built the item snapshot in " << elapsed.count() << " ms ("
+                << (onDemand ? "on-demand" : "nlohmann") << " json)" << std::endl;
+            if (!StoreSnapshot(items->snapshot, DatasetSnapshot::Kind::Items, "items", patch, std::move(image))) {
+                return false;
+            }
         }
         catch (const std::exception& e) {
             std::cerr << "Exception parsing item data: " << e.what() << std::endl;
+            return false;
         }
     }
-    std::cerr << "Failed to fetch item data" << std::endl;
-    return false;
+    PruneSnapshots("items", patch);
+    ProcessItemData(*items);
+
+    std::vector<float> values;
+    values.reserve(items->ids.size() * PatchHistory::FieldCount(PatchHistory::Kind::Item));
+    for (uint32_t ordinal = 0; ordinal < items->ids.size(); ++ordinal) {
+        StatVector row = items->stats.Row(ordinal);
+        values.insert(values.end(), row.begin(), row.end());
+        values.push_back(items->stats.cost[ordinal]);
+    }
+    Publish([&](Dataset& next) {
+        next.items = items;
+        next.search.SetEntries(SearchIndex::EntityKind::Item, items->names);
+        IngestHistory(next, PatchHistory::Kind::Item, items->snapshot.Patch(), items->ids, values);
+    });
+    IndexItems(*items);
+    return true;
 }
 
 bool DataManager::FetchSpecificItemData(const std::string& itemId) const {
-    // Check if we already have this item's data
-    if (specificItemData.find(itemId) != specificItemData.end()) {
-        return true;  // Data already fetched
+    return FetchItemJson(*view->items, itemId) != nullptr;
+}
+
+const nlohmann::json* DataManager::FetchItemJson(const ItemSet& items, const std::string& itemId) const {
+    // Entries are never changed or erased once added, so the pointer outlives the lock
+    std::lock_guard<std::mutex> lock(items.jsonMutex);
+    auto it = items.json.find(std::string_view(itemId));
+    if (it != items.json.end()) {
+        return &it->second;  // Data already fetched
     }
-    // Check if we have already loaded the entire item data
-    if (itemData.empty()) {
-        // If not, fetch the entire item data
-        auto res = itemClient.Get("/riot/lol/resources/latest/en-US/items.json");
-        if (!res || res->status != 200) {
-            std::cerr << "Failed to fetch item data" << std::endl;
-            return false;
-        }
-        itemData = nlohmann::json::parse(res->body);
+    // Only this item's slice of the snapshot is parsed
+    const DatasetSnapshot::ItemRecord* item = items.Find(itemId);
+    if (!item) {
+        std::cerr << "Item ID " << itemId << " not found in item data" << std::endl;
+        return nullptr;
     }
-    // Search for the specific item in the itemData
-    auto it = itemData.find(itemId);
-    if (it != itemData.end()) {
-        // Store the specific item data
-        specificItemData[itemId] = *it;
-        // Update itemNames and itemNameToIdMap if not already present
-        std::string itemName = (*it)["name"];
-        if (std::find(itemNames.begin(), itemNames.end(), itemName) == itemNames.end()) {
-            itemNames.push_back(itemName);
-            itemNameToIdMap[itemName] = itemId;
-        }
-        return true;
+    try {
+        return &items.json.emplace(itemId, ParseSource(items.snapshot.View(item->source))).first->second;
     }
-    else {
-        std::cerr << "Item ID " << itemId << " not found in item data" << std::endl;
-        return false;
+    catch (const std::exception& e) {
+        std::cerr << "Exception parsing item " << itemId << ": " << e.what() << std::endl;
+        return nullptr;
     }
 }
 
-void DataManager::ProcessItemData() {
-    itemNames.clear();
-    itemNameToIdMap.clear();
-    for (auto& [key, value] : itemData.items()) {
-        std::string name = value["name"];
-        itemNames.push_back(name);
-        itemNameToIdMap[name] = key;
+void DataManager::ProcessItemData(ItemSet& items) const {
+    static const std::vector<std::string> roles = { "FIGHTER", "MARKSMAN", "ASSASSIN", "MAGE", "TANK", "SUPPORT" };
+    static const std::vector<std::string> priceBuckets = {
+        "Free", "Under 500", "500 - 999", "1000 - 1499", "1500 - 1999", "2000 - 2499", "2500 - 2999", "3000+"
+    };
+
+    const DatasetSnapshot& itemSnapshot = items.snapshot;
+    for (uint32_t ordinal = 0; ordinal < itemSnapshot.Size(); ++ordinal) {
+        const auto& item = itemSnapshot.Item(ordinal);
+        std::string_view id = itemSnapshot.View(item.id);
+        std::string_view name = itemSnapshot.View(item.name);
+        items.names.emplace_back(name);
+        items.ids.emplace_back(id);
+        items.byName[Symbols::Intern(name)] = ordinal;
+        items.byId[Symbols::Intern(id)] = ordinal;
+        items.byIcon[Symbols::Intern(itemSnapshot.View(item.icon))] = ordinal;
+    }
+    BuildRecipeGraph(items);
+
+    items.facets.Reset(items.ids.size());
+    items.facets.Declare("Role", roles);
+    items.facets.Declare("Price", priceBuckets);
+    items.facets.Declare("Availability", { "Purchasable", "Not purchasable" });
+    for (uint32_t ordinal = 0; ordinal < items.ids.size(); ++ordinal) {
+        const auto& item = itemSnapshot.Item(ordinal);
+        if (!(item.flags & DatasetSnapshot::kItemHasShop)) {
+            continue;
+        }
+        for (uint32_t i = 0; i < item.shopTags.count; ++i) {
+            std::string tagStr(itemSnapshot.ListAt(item.shopTags, i));
+            bool isRole = std::find(roles.begin(), roles.end(), tagStr) != roles.end();
+            items.facets.Add(isRole ? "Role" : "Tag", tagStr, ordinal);
+        }
+        bool purchasable = (item.flags & DatasetSnapshot::kItemPurchasable) != 0;
+        items.facets.Add("Availability", purchasable ? "Purchasable" : "Not purchasable", ordinal);
+        if (item.cost >= 0) {
+            int total = item.cost;
+            size_t bucket = total <= 0 ? 0 : std::min<size_t>(priceBuckets.size() - 1, 1 + total / 500);
+            items.facets.Add("Price", priceBuckets[bucket], ordinal);
+        }
     }
+
+    BuildItemStats(items);
 }
 
 const std::vector<std::string>& DataManager::GetItemNames() const {
-    return itemNames;
+    return view->items->names;
 }
 
 std::vector<std::string> DataManager::GetItemsByTag(const std::string& tag) const {
+    const ItemSet& items = *view->items;
     std::vector<std::string> itemsWithTag;
-    try {
-        for (const auto& [itemId, itemData] : itemData.items()) {
-            if (itemData.contains("shop") && itemData["shop"].contains("tags")) {
-                const auto& tags = itemData["shop"]["tags"];
-                if (std::find(tags.begin(), tags.end(), tag) != tags.end()) {
-                    itemsWithTag.push_back(itemId);
-                }
-            }
-        }
-        std::cout << "Found " << itemsWithTag.size() << " items with tag: " << tag << std::endl;
+    const FacetIndex::Bitmap* bitmap = items.facets.Find("Role", tag);
+    if (!bitmap) {
+        bitmap = items.facets.Find("Tag", tag);
     }
-    catch (const std::exception& e) {
-        std::cerr << "Exception in GetItemsByTag: " << e.what() << std::endl;
+    if (bitmap) {
+        for (uint32_t ordinal : bitmap->ToOrdinals()) {
+            itemsWithTag.push_back(items.ids[ordinal]);
+        }
     }
     return itemsWithTag;
 }
 
+RecipeGraph::Range DataManager::GetItemBuildsFrom(const std::string& itemId) const {
+    int ordinal = GetItemOrdinal(itemId);
+    return ordinal >= 0 ? view->items->recipeGraph.Components(ordinal) : RecipeGraph::Range();
+}
+
+RecipeGraph::Range DataManager::GetItemBuildsInto(const std::string& itemId) const {
+    int ordinal = GetItemOrdinal(itemId);
+    return ordinal >= 0 ? view->items->recipeGraph.BuildsInto(ordinal) : RecipeGraph::Range();
+}
+
+const RecipeGraph& DataManager::GetRecipeGraph() const {
+    return view->items->recipeGraph;
+}
+
+int DataManager::GetItemOrdinal(const std::string& itemId) const {
+    uint32_t ordinal = view->items->Ordinal(itemId);
+    return ordinal != kNoOrdinal ? static_cast<int>(ordinal) : -1;
+}
+
+const std::string& DataManager::GetItemIdAt(uint32_t ordinal) const {
+    return view->items->ids[ordinal];
+}
+
 std::string DataManager::GetItemImageUrl(const std::string& itemId) const {
-    return itemData[itemId]["icon"];
+    const ItemSet& items = *view->items;
+    const DatasetSnapshot::ItemRecord* item = items.Find(itemId);
+    return item ? items.snapshot.String(item->icon) : std::string();
 }
 
 std::string DataManager::GetItemId(const std::string& itemName) const {
-    auto it = itemNameToIdMap.find(itemName);
-    if (it != itemNameToIdMap.end()) {
-        return it->second;
+    const ItemSet& items = *view->items;
+    const uint32_t* ordinal = items.byName.Find(Symbols::Find(itemName));
+    if (ordinal) {
+        return items.ids[*ordinal];
     }
     return itemName; // Fallback to the name if ID is not found
 }
 
 std::string DataManager::GetSpecificItemName(const std::string& itemId) const {
-    if (itemData.contains(itemId)) {
-        return itemData[itemId]["name"];
-    }
-    return "Unknown Item";
+    const ItemSet& items = *view->items;
+    const DatasetSnapshot::ItemRecord* item = items.Find(itemId);
+    return item ? items.snapshot.String(item->name) : "Unknown Item";
 }
 
 std::string DataManager::GetItemDescription(const std::string& itemId) const {
-    if (itemData.contains(itemId) && itemData[itemId].contains("simpleDescription")) {
-        if (itemData[itemId].at("simpleDescription") != nullptr )
-            return itemData[itemId]["simpleDescription"];
+    const ItemSet& items = *view->items;
+    const DatasetSnapshot::ItemRecord* item = items.Find(itemId);
+    if (item && (item->flags & DatasetSnapshot::kItemHasDescription)) {
+        return items.snapshot.String(item->description);
     }
     return "No description available";
 }
 
-std::vector<std::string> DataManager::GetItemBuildsFrom(const std::string& itemId) const {
-    FetchSpecificItemData(itemId);
-    std::vector<std::string> buildsFrom;
-    if (specificItemData.at(itemId).contains("buildsFrom")) {
-        for (const auto& item : specificItemData.at(itemId)["buildsFrom"]) {
-            buildsFrom.push_back(item.get<std::string>());
-        }
-    }
-    return buildsFrom;
-}
 
-std::vector<std::string> DataManager::GetItemBuildsInto(const std::string& itemId) const {
-    std::vector<std::string> buildsInto;
-    try {
-        FetchSpecificItemData(itemId);
-        if (specificItemData.at(itemId).contains("buildsInto") &&
-            specificItemData.at(itemId)["buildsInto"].is_array()) {
-            for (const auto& buildItem : specificItemData.at(itemId)["buildsInto"]) {
-                if (buildItem.is_string()) {
-                    buildsInto.push_back(buildItem.get<std::string>());
-                }
-                else if (buildItem.is_number()) {
-                    // Convert number to string
-                    buildsInto.push_back(std::to_string(buildItem.get<int>()));
-                }
-            }
-        }
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Error in GetItemBuildsInto for item " << itemId << ": " << e.what() << std::endl;
-    }
-    return buildsInto;
-}
 
 int DataManager::GetItemCost(const std::string& itemId) const {
-    if (itemData.contains(itemId) && itemData[itemId].contains("shop") &&
-        itemData[itemId]["shop"].contains("prices") &&
-        itemData[itemId]["shop"]["prices"].contains("total")) {
-        return itemData[itemId]["shop"]["prices"]["total"];
-    }
-    return -1;
+    const DatasetSnapshot::ItemRecord* item = view->items->Find(itemId);
+    return item ? item->cost : -1;
 }
 
 int DataManager::GetItemSellPrice(const std::string& itemId) const {
-    FetchSpecificItemData(itemId);
-    if (specificItemData.at(itemId).contains("shop") && specificItemData.at(itemId)["shop"].contains("prices")) {
-        return specificItemData.at(itemId)["shop"]["prices"]["sell"].get<int>();
-    }
-    return -1;  // Return a default value or handle the case where the sell price is not available
+    const DatasetSnapshot::ItemRecord* item = view->items->Find(itemId);
+    return item ? item->sell : -1;  // -1 when the sell price is not available
 }
 
 bool DataManager::IsItemPurchasable(const std::string& itemId) const {
-    FetchSpecificItemData(itemId);
-    if (specificItemData.at(itemId).contains("shop")) {
-        return specificItemData.at(itemId)["shop"]["purchasable"].get<bool>();
-    }
-    return false;  // Default value if the key is not found
+    const DatasetSnapshot::ItemRecord* item = view->items->Find(itemId);
+    return item && (item->flags & DatasetSnapshot::kItemPurchasable);
 }
 
 std::vector<std::string> DataManager::GetItemTags(const std::string& itemId) const {
-    std::vector<std::string> tags;
-    if (itemData.contains(itemId) && itemData[itemId].contains("shop") &&
-        itemData[itemId]["shop"].contains("tags")) {
-        for (const auto& tag : itemData[itemId]["shop"]["tags"]) {
-            std::string tagStr = tag.get<std::string>();
-            if (validTags.find(tagStr) != validTags.end()) {
-                tags.push_back(tagStr);
-            }
-        }
+    const ItemSet& items = *view->items;
+    uint32_t ordinal = items.Ordinal(itemId);
+    if (ordinal == kNoOrdinal) {
+        return {};
     }
-    return tags;
+    return items.facets.GetValuesFor("Role", ordinal);
 }
 
 nlohmann::json DataManager::GetItemStats(const std::string& itemId) const {
-    if (itemData.contains(itemId) && itemData[itemId].contains("stats")) {
-        return itemData[itemId]["stats"];
+    const nlohmann::json* item = FetchItemJson(*view->items, itemId);
+    if (item && item->contains("stats")) {
+        return (*item)["stats"];
     }
     return nlohmann::json::object();
 }
 
 nlohmann::json DataManager::GetItemData(const std::string& itemId) const {
-    if (itemData.contains(itemId)) {
-        return itemData[itemId];
+    const nlohmann::json* item = FetchItemJson(*view->items, itemId);
+    if (item) {
+        return *item;
     }
     return nlohmann::json::object();
 }
 
 nlohmann::json DataManager::GetItemShopInfo(const std::string& itemId) const {
-    FetchSpecificItemData(itemId);
-    if (specificItemData.at(itemId).contains("shop")) {
-        return specificItemData.at(itemId)["shop"];
+    const nlohmann::json* item = FetchItemJson(*view->items, itemId);
+    if (item && item->contains("shop")) {
+        return (*item)["shop"];
     }
     return {};  // Return an empty JSON object if the shop info is not found
 }
 
 std::vector<std::string> DataManager::GetAllItemIds() const {
-    std::vector<std::string> ids;
-    for (const auto& [id, item] : itemData.items()) {
-        ids.push_back(id);
-    }
-    return ids;
+    return view->items->ids;
 }
 
 std::string DataManager::GetItemIdFromIconUrl(const std::string& url) const {
-    for (const auto& [id, item] : itemData.items()) {
-        if (item["icon"] == url) {
-            return id;
+    const ItemSet& items = *view->items;
+    const uint32_t* ordinal = items.byIcon.Find(Symbols::Find(url));
+    return ordinal ? items.ids[*ordinal] : std::string();
+}
+
+void DataManager::BuildRecipeGraph(ItemSet& items) const {
+    std::vector<std::vector<uint32_t>> components(items.ids.size());
+    std::vector<int> totalCost(items.ids.size(), 0);
+    for (uint32_t ordinal = 0; ordinal < items.ids.size(); ++ordinal) {
+        const auto& item = items.snapshot.Item(ordinal);
+        totalCost[ordinal] = item.cost;
+        for (uint32_t i = 0; i < item.components.count; ++i) {
+            uint32_t component = items.Ordinal(items.snapshot.ListAt(item.components, i));
+            if (component != kNoOrdinal) {
+                components[ordinal].push_back(component);
+            }
         }
     }
-    return "";
+    items.recipeGraph.Build(components, totalCost);
+}
+
+void DataManager::BuildItemStats(ItemSet& items) const {
+    const DatasetSnapshot& itemSnapshot = items.snapshot;
+    size_t count = items.ids.size();
+    items.stats.Resize(count);
+    items.groupMasks.assign(count, 0);
+
+    // Unique groups: boots, and items sharing a unique passive, can't be stacked
+    std::map<std::string, std::vector<uint32_t>> groupMembers;
+    const FacetIndex::Bitmap* purchasable = items.facets.Find("Availability", "Purchasable");
+    for (uint32_t ordinal = 0; ordinal < count; ++ordinal) {
+        const auto& item = itemSnapshot.Item(ordinal);
+        items.stats.SetRow(ordinal, item.stats, static_cast<float>(std::max(0, item.cost)));
+
+        auto hasRank = [&itemSnapshot, &item](const char* rank) {
+            for (uint32_t i = 0; i < item.ranks.count; ++i) {
+                if (itemSnapshot.ListAt(item.ranks, i) == rank) return true;
+            }
+            return false;
+        };
+        if (hasRank("BOOTS")) {
+            groupMembers["Boots"].push_back(ordinal);
+        }
+        if (hasRank("MYTHIC")) {
+            groupMembers["Mythic"].push_back(ordinal);
+        }
+        for (uint32_t i = 0; i < item.uniquePassives.count; ++i) {
+            groupMembers["Unique - " + std::string(itemSnapshot.ListAt(item.uniquePassives, i))].push_back(ordinal);
+        }
+
+        // Finished items anyone can buy are the optimizer's candidates
+        bool finished = items.recipeGraph.Upgrades(ordinal).empty() && !hasRank("CONSUMABLE") && !hasRank("STARTER");
+        bool restricted = (item.flags & DatasetSnapshot::kItemRestricted) != 0;
+        StatVector row = items.stats.Row(ordinal);
+        bool hasStats = std::any_of(row.begin(), row.end(), [](float value) { return value != 0.0f; });
+        bool buyable = purchasable && purchasable->Test(ordinal) && !restricted && hasStats && items.stats.cost[ordinal] > 0.0f;
+        if (buyable && finished) {
+            items.buildCandidates.push_back(ordinal);
+        }
+        // Basic components are priced by their stats alone; they set the gold value of each stat
+        if (buyable && items.recipeGraph.Components(ordinal).empty() && !items.recipeGraph.Upgrades(ordinal).empty()) {
+            items.basicItems.push_back(ordinal);
+        }
+    }
+
+    for (const auto& [name, members] : groupMembers) {
+        if (members.size() < 2 || items.groupNames.size() >= 64) {
+            continue;
+        }
+        uint64_t bit = uint64_t(1) << items.groupNames.size();
+        items.groupNames.push_back(name);
+        for (uint32_t ordinal : members) {
+            items.groupMasks[ordinal] |= bit;
+        }
+    }
+
+    items.goldEfficiency.Compute(items.stats, items.basicItems);
+}
+
+const PatchHistory& DataManager::GetPatchHistory() const {
+    return *view->history;
+}
+
+const ItemStatTable& DataManager::GetItemStatTable() const {
+    return view->items->stats;
+}
+
+const std::vector<uint32_t>& DataManager::GetBuildCandidates() const {
+    return view->items->buildCandidates;
+}
+
+uint64_t DataManager::GetItemGroupMask(uint32_t ordinal) const {
+    const auto& groupMasks = view->items->groupMasks;
+    return ordinal < groupMasks.size() ? groupMasks[ordinal] : 0;
+}
+
+const GoldEfficiency::Result* DataManager::GetGoldEfficiency() const {
+    return view->items->goldEfficiency.Get();
+}
+
+const FacetIndex& DataManager::GetItemFacets() const {
+    return view->items->facets;
+}
+
+std::vector<std::string> DataManager::GetItemsMatching(const FacetIndex::Filter& filter) const {
+    const ItemSet& items = *view->items;
+    std::vector<std::string> matching;
+    for (uint32_t ordinal : items.facets.Evaluate(filter).ToOrdinals()) {
+        matching.push_back(items.ids[ordinal]);
+    }
+    return matching;
 }
 
 bool DataManager::ItemExists(const std::string& itemId) const {
-    return itemData.contains(itemId);
+    return view->items->Ordinal(itemId) != kNoOrdinal;
 }
 
 
@@ -355,53 +1498,88 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
     return totalSize;
 }
 
-bool DataManager::FetchGameModes() {
+std::filesystem::path DataManager::DocumentPath(const std::string& name) const {
+    return cacheDirectory / "data" / (name + "-" + GetPatchVersion() + ".json");
+}
+
+bool DataManager::LoadDocument(const std::string& url, const std::string& name, std::string& body) const {
+    if (ReadFile(DocumentPath(name), body)) {
+        return true;
+    }
+
     CURL* curl = curl_easy_init();
     if (!curl) {
         std::cerr << "Failed to initialize curl" << std::endl;
         return false;
     }
-
-    std::string response;
-    curl_easy_setopt(curl, CURLOPT_URL, "https://static.developer.riotgames.com/docs/lol/gameModes.json");
+    body.clear();
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
     CURLcode res = curl_easy_perform(curl);
     curl_easy_cleanup(curl);
-
     if (res != CURLE_OK) {
-        std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
+        std::cerr << "Failed to fetch " << url << ": " << curl_easy_strerror(res) << std::endl;
+        return false;
+    }
+
+    // Copies of earlier patches are not read again
+    RemoveFilesWithPrefix(cacheDirectory / "data", name + "-");
+    WriteFileAtomically(DocumentPath(name), body);
+    return true;
+}
+
+bool DataManager::FetchGameModes() {
+    std::string response;
+    if (!LoadDocument(kGameModesUrl, "gameModes", response)) {
         return false;
     }
 
     try {
         auto json = nlohmann::json::parse(response);
-        gameModes.clear();
-        gameModes.push_back({ "All Game Modes", "Showing all Summoner's Spells from all game modes." });
+        auto gameModes = std::make_shared<std::vector<GameMode>>();
+        gameModes->push_back({ "All Game Modes", "Showing all Summoner's Spells from all game modes." });
         for (const auto& mode : json) {
-            gameModes.push_back({
+            gameModes->push_back({
                 mode["gameMode"].get<std::string>(),
                 mode["description"].get<std::string>()
                 });
         }
-        std::cout << "Successfully fetched " << gameModes.size() << " game modes" << std::endl;
+        std::vector<std::string> modeNames;
+        for (const auto& gameMode : *gameModes) {
+            modeNames.push_back(gameMode.mode);
+        }
+        std::cout << "Successfully fetched " << gameModes->size() << " game modes" << std::endl;
+        Publish([&](Dataset& next) {
+            next.gameModes = gameModes;
+            next.search.SetEntries(SearchIndex::EntityKind::GameMode, modeNames);
+        });
         return true;
     }
     catch (const std::exception& e) {
         std::cerr << "Exception in parsing JSON: " << e.what() << std::endl;
+        std::error_code error;
+        std::filesystem::remove(DocumentPath("gameModes"), error);
         return false;
     }
 }
 
 const std::vector<DataManager::GameMode>& DataManager::GetGameModes() const {
-    return gameModes;
+    return *view->gameModes;
 }
 
 bool DataManager::FetchSummonerSpells() {
-    CURL* curl = curl_easy_init();
-    if (curl) {
-        std::string url = "https://ddragon.leagueoflegends.com/cdn/14.14.1/data/en_US/summoner.json";
+    auto spells = std::make_shared<SpellSet>();
+    std::string patch = GetPatchVersion();
+    if (!spells->snapshot.Open(SnapshotPath("summoners", patch), DatasetSnapshot::Kind::SummonerSpells, patch) &&
+        !RestoreBundledSnapshot(spells->snapshot, DatasetSnapshot::Kind::SummonerSpells, "summoners", patch)) {
+        CURL* curl = curl_easy_init();
+        if (!curl) {
+            std::cerr << "Failed to fetch summoner spells" << std::endl;
+            return false;
+        }
+        std::string url = "https://ddragon.leagueoflegends.com/cdn/" + patch + "/data/en_US/summoner.json";
         std::string response;
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
@@ -409,40 +1587,322 @@ bool DataManager::FetchSummonerSpells() {
 
         CURLcode res = curl_easy_perform(curl);
         curl_easy_cleanup(curl);
+        if (res != CURLE_OK) {
+            std::cerr << "Failed to fetch summoner spells" << std::endl;
+            return false;
+        }
 
-        if (res == CURLE_OK) {
-            auto json = nlohmann::json::parse(response);
-            summonerSpells.clear();
-            for (const auto& [key, value] : json["data"].items()) {
-                SummonerSpell spell;
-                spell.id = value["id"];
-                spell.name = value["name"];
-                spell.description = value["description"];
-                spell.modes = value["modes"].get<std::vector<std::string>>();
-                spell.cooldownBurn = value["cooldownBurn"];
-                spell.summonerLevel = value["summonerLevel"];
-                summonerSpells.push_back(spell);
+        try {
+            auto image = DatasetSnapshot::BuildSummonerSpells(nlohmann::json::parse(response), patch);
+            if (!StoreSnapshot(spells->snapshot, DatasetSnapshot::Kind::SummonerSpells, "summoners", patch, std::move(image))) {
+                return false;
             }
-            return true;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing summoner spells: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    PruneSnapshots("summoners", patch);
+    ProcessSummonerSpells(*spells);
+
+    std::vector<std::string> spellNames;
+    for (const auto& spell : spells->spells) {
+        spellNames.push_back(spell.name);
+    }
+    Publish([&](Dataset& next) {
+        next.spells = spells;
+        next.search.SetEntries(SearchIndex::EntityKind::SummonerSpell, spellNames);
+        ApplyLocale(next);
+    });
+    return true;
+}
+
+void DataManager::ProcessSummonerSpells(SpellSet& spells) const {
+    const DatasetSnapshot& spellSnapshot = spells.snapshot;
+    for (uint32_t ordinal = 0; ordinal < spellSnapshot.Size(); ++ordinal) {
+        const auto& record = spellSnapshot.Spell(ordinal);
+        SummonerSpell spell;
+        spell.id = spellSnapshot.String(record.id);
+        spell.name = spellSnapshot.String(record.name);
+        spell.description = spellSnapshot.String(record.description);
+        for (const auto& mode : spellSnapshot.Strings(record.modes)) {
+            spell.modes.push_back(Symbols::Intern(mode));
+        }
+        spell.cooldownBurn = spellSnapshot.String(record.cooldownBurn);
+        if (const float* cooldown = spellSnapshot.Floats(record.firstCooldown, record.cooldownCount)) {
+            spell.cooldown.assign(cooldown, cooldown + record.cooldownCount);
+        }
+        spell.summonerLevel = record.summonerLevel;
+        spells.spells.push_back(spell);
+    }
+
+    spells.facets.Reset(spells.spells.size());
+    for (uint32_t ordinal = 0; ordinal < spells.spells.size(); ++ordinal) {
+        for (Symbol mode : spells.spells[ordinal].modes) {
+            spells.facets.Add("Mode", std::string(Symbols::Name(mode)), ordinal);
         }
     }
-    std::cerr << "Failed to fetch summoner spells" << std::endl;
-    return false;
 }
 
 const std::vector<DataManager::SummonerSpell>& DataManager::GetSummonerSpells() const {
-    return summonerSpells;
+    return view->locale ? view->locale->spells : view->spells->spells;
+}
+
+bool DataManager::FetchRunes() {
+    std::string body;
+    if (!LoadDocument(GetDataDragonUrl("data/en_US/runesReforged.json"), "runesReforged", body)) {
+        return false;
+    }
+
+    // An array of trees, each with rows of runes
+    auto runes = std::make_shared<RuneSet>();
+    try {
+        JsonView(body).ForEachElement([&runes](const JsonView& tree) {
+            std::string treeName = tree.Find("name").String();
+            int slot = 0;
+            tree.Find("slots").ForEachElement([&runes, &treeName, &slot](const JsonView& row) {
+                row.Find("runes").ForEachElement([&runes, &treeName, slot](const JsonView& rune) {
+                    runes->runes.push_back({ static_cast<int>(rune.Find("id").Number()), rune.Find("key").String(),
+                        rune.Find("name").String(), treeName, slot, rune.Find("icon").String(), rune.Find("shortDesc").String() });
+                });
+                ++slot;
+            });
+        });
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception parsing runes: " << e.what() << std::endl;
+        std::error_code error;
+        std::filesystem::remove(DocumentPath("runesReforged"), error);
+        return false;
+    }
+    for (uint32_t ordinal = 0; ordinal < runes->runes.size(); ++ordinal) {
+        runes->byId[runes->runes[ordinal].id] = ordinal;
+    }
+    Publish([&](Dataset& next) {
+        next.runes = runes;
+    });
+    return true;
+}
+
+const std::vector<DataManager::Rune>& DataManager::GetRunes() const {
+    RequestModule("runes");
+    return view->runes->runes;
+}
+
+const DataManager::Rune* DataManager::FindRune(int runeId) const {
+    RequestModule("runes");
+    const RuneSet& runes = *view->runes;
+    auto it = runes.byId.find(runeId);
+    return it != runes.byId.end() ? &runes.runes[it->second] : nullptr;
+}
+
+bool DataManager::FetchProfileIcons() {
+    std::string body;
+    if (!LoadDocument(GetDataDragonUrl("data/en_US/profileicon.json"), "profileicon", body)) {
+        return false;
+    }
+
+    auto icons = std::make_shared<std::vector<int>>();
+    try {
+        JsonView(body).Find("data").ForEachMember([&icons](std::string_view, const JsonView& icon) {
+            icons->push_back(static_cast<int>(icon.Find("id").Number()));
+        });
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception parsing profile icons: " << e.what() << std::endl;
+        std::error_code error;
+        std::filesystem::remove(DocumentPath("profileicon"), error);
+        return false;
+    }
+    std::sort(icons->begin(), icons->end());
+    Publish([&](Dataset& next) {
+        next.profileIcons = icons;
+    });
+    return true;
+}
+
+const std::vector<int>& DataManager::GetProfileIconIds() const {
+    RequestModule("profileIcons");
+    return *view->profileIcons;
+}
+
+std::string DataManager::GetProfileIconUrl(int iconId) const {
+    return GetDataDragonUrl("img/profileicon/" + std::to_string(iconId) + ".png");
+}
+
+bool DataManager::FetchMaps() {
+    std::string body;
+    if (!LoadDocument(GetDataDragonUrl("data/en_US/map.json"), "map", body)) {
+        return false;
+    }
+
+    auto maps = std::make_shared<std::vector<MapInfo>>();
+    try {
+        JsonView(body).Find("data").ForEachMember([&maps](std::string_view, const JsonView& map) {
+            maps->push_back({ map.Find("MapId").String(), map.Find("MapName").String() });
+        });
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception parsing maps: " << e.what() << std::endl;
+        std::error_code error;
+        std::filesystem::remove(DocumentPath("map"), error);
+        return false;
+    }
+    Publish([&](Dataset& next) {
+        next.maps = maps;
+    });
+    return true;
+}
+
+const std::vector<DataManager::MapInfo>& DataManager::GetMaps() const {
+    RequestModule("maps");
+    return *view->maps;
 }
 
-std::vector<DataManager::SummonerSpell> DataManager::GetSummonerSpellsForMode(const std::string& mode) const {
+std::vector<uint32_t> DataManager::GetSummonerSpellsForMode(const std::string& mode) const {
+    const SpellSet& spells = *view->spells;
     if (mode == "All Game Modes") {
-        return summonerSpells;
+        return FacetIndex::Bitmap(spells.spells.size(), true).ToOrdinals();
+    }
+    const FacetIndex::Bitmap* bitmap = spells.facets.Find("Mode", mode);
+    return bitmap ? bitmap->ToOrdinals() : std::vector<uint32_t>();
+}
+
+const SearchIndex& DataManager::GetSearchIndex() const {
+    return view->search;
+}
+
+std::vector<TextIndex::Hit> DataManager::SearchText(const std::string& query, size_t maxResults) const {
+    return textIndex.Search(query, maxResults);
+}
+
+const TextIndex& DataManager::GetTextIndex() const {
+    return textIndex;
+}
+
+void DataManager::IndexChampionSummaries(const ChampionSet& champions) {
+    const DatasetSnapshot& championSnapshot = champions.snapshot;
+    // Blurbs make every champion searchable before its details are fetched;
+    // they are replaced once the detail documents arrive.
+    for (uint32_t ordinal = 0; ordinal < championSnapshot.Size(); ++ordinal) {
+        const auto& champion = championSnapshot.Champion(ordinal);
+        std::string key = championSnapshot.String(champion.id);
+        if (textIndex.HasOwner(SearchIndex::EntityKind::Champion, key, TextIndex::Depth::Summary)) {
+            continue;
+        }
+        textIndex.Enqueue(SearchIndex::EntityKind::Champion, key, TextIndex::Depth::Summary,
+            { { TextIndex::Field::Summary, 0, "Summary", championSnapshot.String(champion.blurb) } });
+    }
+}
+
+void DataManager::IndexItems(const ItemSet& items) {
+    const DatasetSnapshot& itemSnapshot = items.snapshot;
+    for (uint32_t ordinal = 0; ordinal < itemSnapshot.Size(); ++ordinal) {
+        const std::string& key = items.ids[ordinal];
+        if (textIndex.HasOwner(SearchIndex::EntityKind::Item, key, TextIndex::Depth::Detail)) {
+            continue;
+        }
+        // Items already in the saved index are skipped without touching their json
+        nlohmann::json value;
+        try {
+            value = ParseSource(itemSnapshot.View(itemSnapshot.Item(ordinal).source));
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing item " << key << ": " << e.what() << std::endl;
+            continue;
+        }
+        std::vector<TextIndex::Document> documents;
+        std::string description = StringField(value, "simpleDescription");
+        if (description.empty()) {
+            description = StringField(value, "description");
+        }
+        if (!description.empty()) {
+            documents.push_back({ TextIndex::Field::ItemDescription, 0, "Description", description });
+        }
+
+        auto addEffects = [&documents](const nlohmann::json& list, TextIndex::Field field, const char* kind) {
+            if (!list.is_array()) {
+                return;
+            }
+            for (uint8_t i = 0; i < list.size() && i < 255; ++i) {
+                std::string effects = StringField(list[i], "effects");
+                if (effects.empty()) {
+                    continue;
+                }
+                std::string name = StringField(list[i], "name");
+                documents.push_back({ field, i, name.empty() ? std::string(kind) : std::string(kind) + " - " + name, effects });
+            }
+        };
+        addEffects(value.value("passives", nlohmann::json()), TextIndex::Field::ItemPassive, "Passive");
+        addEffects(value.value("active", nlohmann::json()), TextIndex::Field::ItemActive, "Active");
+
+        if (!documents.empty()) {
+            textIndex.Enqueue(SearchIndex::EntityKind::Item, key, TextIndex::Depth::Detail, std::move(documents));
+        }
+    }
+}
+
+void DataManager::StartDetailPrefetch(const ChampionSet& champions) {
+    if (detailPrefetchStarted.exchange(true)) {
+        return;
+    }
+
+    // The cached details were checked against this patch in an earlier session
+    std::string body;
+    if (ReadFile(cacheDirectory / "champions" / "hashes.json", body)) {
+        nlohmann::json hashes = nlohmann::json::parse(body, nullptr, false);
+        detailCacheVerified = hashes.is_object() && hashes.value("patch", std::string()) == GetPatchVersion();
     }
-    std::vector<SummonerSpell> filteredSpells;
-    for (const auto& spell : summonerSpells) {
-        if (std::find(spell.modes.begin(), spell.modes.end(), mode) != spell.modes.end()) {
-            filteredSpells.push_back(spell);
+
+    std::vector<std::string> missing;
+    // After a patch change every champion is indexed again, changed or not
+    bool reindex = reindexDetails.exchange(false);
+    for (const auto& id : champions.ids) {
+        if (reindex || !textIndex.HasOwner(SearchIndex::EntityKind::Champion, id, TextIndex::Depth::Detail)) {
+            missing.push_back(id);
         }
     }
-    return filteredSpells;
-}
\ No newline at end of file
+    if (missing.empty() && detailCacheVerified) {
+        return;
+    }
+
+    // One championFull download both diffs the patch against the cached
+    // details and feeds the index every champion's details, instead of one
+    // request per champion. It uses its own connection and touches no dataset.
+    detailPrefetch.Run([this, missing = std::move(missing)]() {
+        httplib::Client prefetchClient("ddragon.leagueoflegends.com");
+        std::string full;
+        if (!LoadChampionFull(prefetchClient, full)) {
+            std::cerr << "Failed to prefetch champion details" << std::endl;
+            return;
+        }
+        nlohmann::json champions;
+        try {
+            champions = nlohmann::json::parse(full).at("data");
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing champion details: " << e.what() << std::endl;
+            return;
+        }
+
+        if (!detailCacheVerified) {
+            VerifyDetailCache(champions);
+        }
+        for (const auto& championId : missing) {
+            if (stopDetailPrefetch) {
+                return;
+            }
+            auto it = champions.find(championId);
+            if (it != champions.end()) {
+                textIndex.Enqueue(SearchIndex::EntityKind::Champion, championId, TextIndex::Depth::Detail,
+                    BuildChampionDocuments(*it));
+            }
+        }
+
+        textIndex.WaitUntilIdle();
+        if (!stopDetailPrefetch) {
+            textIndex.Save(cacheDirectory / "fulltext.bin", GetPatchVersion());
+        }
+    }, TaskPool::Priority::Background);
+}
@@ -0,0 +1,163 @@
+#include "DatasetRegistry.h"
+#include <iostream>
+#include <chrono>
+
+void DatasetRegistry::Register(Module module) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string name = module.name;
+    if (entries.count(name) == 0) {
+        order.push_back(name);
+    }
+    entries[name].module = std::move(module);
+}
+
+DatasetRegistry::Entry* DatasetRegistry::Find(const std::string& name) {
+    auto it = entries.find(name);
+    return it != entries.end() ? &it->second : nullptr;
+}
+
+DatasetRegistry::State DatasetRegistry::Request(const std::string& name, TaskPool::Priority priority) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = Find(name);
+    if (entry == nullptr) {
+        return State::Failed;
+    }
+    // A prefetched module asked for in earnest is queued again ahead of the
+    // background work; whichever task starts first loads it
+    bool sooner = entry->state == State::Queued && priority < entry->queuedAt;
+    if (entry->state == State::Idle || sooner) {
+        entry->state = State::Queued;
+        entry->queuedAt = priority;
+        loads.Run([this, name] { Ensure(name); }, priority);
+    }
+    return entry->state;
+}
+
+bool DatasetRegistry::Ensure(const std::string& name) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Entry* entry = Find(name);
+    if (entry == nullptr) {
+        std::cerr << "No dataset module named " << name << std::endl;
+        return false;
+    }
+    // Modules only wait on the ones they need, which never wait back
+    settled.wait(lock, [entry] { return entry->state != State::Loading; });
+    if (entry->state == State::Ready || entry->state == State::Failed) {
+        return entry->state == State::Ready;
+    }
+    entry->state = State::Loading;
+    lock.unlock();
+
+    bool loaded = true;
+    for (const auto& need : entry->module.needs) {
+        if (!Ensure(need)) {
+            std::cerr << "Failed to load " << name << ": it needs " << need << std::endl;
+            loaded = false;
+            break;
+        }
+    }
+    if (loaded) {
+        auto started = std::chrono::steady_clock::now();
+        loaded = entry->module.load();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        if (loaded) {
+            std::cout << "Loaded " << name << " in " << elapsed.count() << " ms" << std::endl;
+        }
+        else {
+            std::cerr << "Failed to load " << name << " from";
+            if (entry->module.sources) {
+                for (const auto& source : entry->module.sources()) {
+                    std::cerr << " " << source;
+                }
+            }
+            std::cerr << std::endl;
+        }
+    }
+
+    lock.lock();
+    bool again = entry->stale && entry->reload;
+    entry->state = entry->stale ? State::Idle : loaded ? State::Ready : State::Failed;
+    entry->stale = entry->reload = false;
+    settled.notify_all();
+    lock.unlock();
+    if (again) {
+        Request(name, TaskPool::Priority::Normal);
+    }
+    return loaded;
+}
+
+void DatasetRegistry::ResetFailed(const std::string& name) {
+    Entry* entry = Find(name);
+    if (entry == nullptr) {
+        return;
+    }
+    if (entry->state == State::Failed) {
+        entry->state = State::Idle;
+    }
+    for (const auto& need : entry->module.needs) {
+        ResetFailed(need);
+    }
+}
+
+DatasetRegistry::State DatasetRegistry::Retry(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ResetFailed(name);
+    }
+    return Request(name);
+}
+
+void DatasetRegistry::Invalidate(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = Find(name);
+    if (entry == nullptr) {
+        return;
+    }
+    if (entry->state == State::Loading) {
+        entry->stale = true;
+    }
+    else if (entry->state != State::Queued) {
+        entry->state = State::Idle;
+    }
+}
+
+void DatasetRegistry::Reload() {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& name : order) {
+            Entry& entry = entries[name];
+            if (entry.state == State::Loading) {
+                entry.stale = entry.reload = true;
+            }
+            else if (entry.state == State::Ready || entry.state == State::Failed) {
+                entry.state = State::Idle;
+                names.push_back(name);
+            }
+        }
+    }
+    for (const auto& name : names) {
+        Request(name, TaskPool::Priority::Normal);
+    }
+}
+
+DatasetRegistry::State DatasetRegistry::GetState(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(name);
+    return it != entries.end() ? it->second.state : State::Failed;
+}
+
+void DatasetRegistry::Prefetch() {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& name : order) {
+            if (entries[name].module.prefetch) {
+                names.push_back(name);
+            }
+        }
+    }
+    for (const auto& name : names) {
+        Request(name, TaskPool::Priority::Background);
+    }
+}
@@ -0,0 +1,592 @@
+#include "DatasetSnapshot.h"
+#include "AbilityTable.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    constexpr char kMagic[4] = { 'L', 'D', 'S', 'N' };
+    constexpr uint32_t kFormat = 2;
+    constexpr size_t kPatchLength = 32;
+
+    enum Section : uint32_t {
+        kStrings,
+        kRecords,
+        kLists,
+        kFloats,
+        kSectionCount
+    };
+
+    struct SectionEntry {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t crc;
+        uint32_t reserved;
+    };
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t format;
+        uint32_t kind;
+        uint32_t recordSize;     // catches a record layout change without a format bump
+        uint32_t recordCount;
+        char patch[kPatchLength];
+        SectionEntry sections[kSectionCount];
+        uint32_t headerCrc;      // of every byte above
+    };
+
+    uint32_t Crc32(const uint8_t* data, size_t size) {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                t[i] = c;
+            }
+            return t;
+        }();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    uint32_t RecordSize(DatasetSnapshot::Kind kind) {
+        switch (kind) {
+        case DatasetSnapshot::Kind::Champions: return sizeof(DatasetSnapshot::ChampionRecord);
+        case DatasetSnapshot::Kind::Items: return sizeof(DatasetSnapshot::ItemRecord);
+        case DatasetSnapshot::Kind::SummonerSpells: return sizeof(DatasetSnapshot::SpellRecord);
+        }
+        return 0;
+    }
+
+    size_t Align(size_t offset) {
+        return (offset + 7) & ~size_t(7);
+    }
+
+    std::string StringField(const nlohmann::json& object, const char* key) {
+        auto it = object.find(key);
+        return (it != object.end() && it->is_string()) ? it->get<std::string>() : std::string();
+    }
+
+    std::vector<std::string> StringList(const nlohmann::json& list) {
+        std::vector<std::string> out;
+        if (list.is_array()) {
+            for (const auto& value : list) {
+                if (value.is_string()) out.push_back(value.get<std::string>());
+            }
+        }
+        return out;
+    }
+
+    int IntField(const nlohmann::json& object, const char* key, int fallback) {
+        auto it = object.find(key);
+        return (it != object.end() && it->is_number()) ? it->get<int>() : fallback;
+    }
+
+    // champion.json summary entry
+    DatasetSnapshot::ChampionRecord MakeChampionRecord(DatasetSnapshot::Builder& builder, const std::string& id, const nlohmann::json& champion) {
+        DatasetSnapshot::ChampionRecord record{};
+        record.id = builder.Intern(id);
+        record.name = builder.Intern(StringField(champion, "name"));
+        record.title = builder.Intern(StringField(champion, "title"));
+        record.blurb = builder.Intern(StringField(champion, "blurb"));
+        record.partype = builder.Intern(StringField(champion, "partype"));
+        record.tags = builder.AddList(StringList(champion.value("tags", nlohmann::json())));
+        const char* infoKeys[] = { "attack", "defense", "magic", "difficulty" };
+        auto info = champion.find("info");
+        for (int i = 0; i < 4; ++i) {
+            bool known = info != champion.end() && info->is_object() && info->contains(infoKeys[i]) && (*info)[infoKeys[i]].is_number();
+            record.info[i] = known ? (*info)[infoKeys[i]].get<float>() : 0.0f;
+        }
+        record.stats = ParseChampionBaseStats(champion.value("stats", nlohmann::json()));
+        record.source = builder.Intern(champion.dump());
+        record.contentHash = DatasetSnapshot::ContentHash(champion);
+        return record;
+    }
+
+    // items.json entry
+    DatasetSnapshot::ItemRecord MakeItemRecord(DatasetSnapshot::Builder& builder, const std::string& id, const nlohmann::json& item) {
+        DatasetSnapshot::ItemRecord record{};
+        record.id = builder.Intern(id);
+        record.name = builder.Intern(StringField(item, "name"));
+        record.icon = builder.Intern(StringField(item, "icon"));
+        auto description = item.find("simpleDescription");
+        if (description != item.end() && description->is_string()) {
+            record.description = builder.Intern(description->get<std::string>());
+            record.flags |= DatasetSnapshot::kItemHasDescription;
+        }
+
+        record.cost = -1;
+        record.sell = -1;
+        auto shop = item.find("shop");
+        if (shop != item.end() && shop->is_object()) {
+            record.flags |= DatasetSnapshot::kItemHasShop;
+            if (shop->value("purchasable", false)) {
+                record.flags |= DatasetSnapshot::kItemPurchasable;
+            }
+            record.shopTags = builder.AddList(StringList(shop->value("tags", nlohmann::json())));
+            auto prices = shop->find("prices");
+            if (prices != shop->end() && prices->is_object()) {
+                record.cost = IntField(*prices, "total", -1);
+                record.sell = IntField(*prices, "sell", -1);
+            }
+        }
+
+        record.ranks = builder.AddList(StringList(item.value("rank", nlohmann::json())));
+        std::vector<std::string> uniquePassives;
+        auto passives = item.find("passives");
+        if (passives != item.end() && passives->is_array()) {
+            for (const auto& passive : *passives) {
+                std::string name = StringField(passive, "name");
+                if (passive.value("unique", false) && !name.empty()) {
+                    uniquePassives.push_back(name);
+                }
+            }
+        }
+        record.uniquePassives = builder.AddList(uniquePassives);
+
+        std::vector<std::string> components;
+        auto buildsFrom = item.find("buildsFrom");
+        if (buildsFrom != item.end() && buildsFrom->is_array()) {
+            for (const auto& component : *buildsFrom) {
+                if (component.is_number()) components.push_back(std::to_string(component.get<int>()));
+                else if (component.is_string()) components.push_back(component.get<std::string>());
+            }
+        }
+        record.components = builder.AddList(components);
+
+        if (!StringField(item, "requiredChampion").empty() || !StringField(item, "requiredAlly").empty() ||
+            item.value("removed", false)) {
+            record.flags |= DatasetSnapshot::kItemRestricted;
+        }
+        record.stats = ParseItemStats(item.value("stats", nlohmann::json()));
+        record.source = builder.Intern(item.dump());
+        record.contentHash = DatasetSnapshot::ContentHash(item);
+        return record;
+    }
+
+    std::vector<std::string> StringList(const JsonView& list) {
+        std::vector<std::string> out;
+        list.ForEachElement([&out](const JsonView& value) {
+            if (value.IsString()) out.push_back(value.String());
+        });
+        return out;
+    }
+
+    // items.json entry, reading only what the record keeps
+    DatasetSnapshot::ItemRecord MakeItemRecord(DatasetSnapshot::Builder& builder, std::string_view id, const JsonView& item) {
+        DatasetSnapshot::ItemRecord record{};
+        record.id = builder.Intern(id);
+        record.cost = -1;
+        record.sell = -1;
+        bool restricted = false;
+        std::vector<std::string> uniquePassives;
+        std::vector<std::string> components;
+
+        // One pass over the members; everything not named here is skipped unread
+        item.ForEachMember([&](std::string_view key, const JsonView& value) {
+            if (key == "name") {
+                record.name = builder.Intern(value.String());
+            }
+            else if (key == "icon") {
+                record.icon = builder.Intern(value.String());
+            }
+            else if (key == "simpleDescription" && value.IsString()) {
+                record.description = builder.Intern(value.String());
+                record.flags |= DatasetSnapshot::kItemHasDescription;
+            }
+            else if (key == "shop" && value.IsObject()) {
+                record.flags |= DatasetSnapshot::kItemHasShop;
+                if (value.Find("purchasable").Bool()) {
+                    record.flags |= DatasetSnapshot::kItemPurchasable;
+                }
+                record.shopTags = builder.AddList(StringList(value.Find("tags")));
+                JsonView prices = value.Find("prices");
+                if (prices.IsObject()) {
+                    record.cost = static_cast<int32_t>(prices.Find("total").Number(-1));
+                    record.sell = static_cast<int32_t>(prices.Find("sell").Number(-1));
+                }
+            }
+            else if (key == "rank") {
+                record.ranks = builder.AddList(StringList(value));
+            }
+            else if (key == "passives") {
+                value.ForEachElement([&uniquePassives](const JsonView& passive) {
+                    std::string name = passive.Find("name").String();
+                    if (passive.Find("unique").Bool() && !name.empty()) {
+                        uniquePassives.push_back(name);
+                    }
+                });
+            }
+            else if (key == "buildsFrom") {
+                value.ForEachElement([&components](const JsonView& component) {
+                    if (component.IsNumber()) components.push_back(std::to_string(static_cast<int>(component.Number())));
+                    else if (component.IsString()) components.push_back(component.String());
+                });
+            }
+            else if (key == "requiredChampion" || key == "requiredAlly") {
+                restricted |= !value.String().empty();
+            }
+            else if (key == "removed") {
+                restricted |= value.Bool();
+            }
+            else if (key == "stats") {
+                record.stats = ParseItemStats(value);
+            }
+        });
+
+        record.uniquePassives = builder.AddList(uniquePassives);
+        record.components = builder.AddList(components);
+        if (restricted) {
+            record.flags |= DatasetSnapshot::kItemRestricted;
+        }
+        record.source = builder.Intern(item.Raw());
+        record.contentHash = DatasetSnapshot::ContentHash(item);
+        return record;
+    }
+
+    // summoner.json entry
+    DatasetSnapshot::SpellRecord MakeSpellRecord(DatasetSnapshot::Builder& builder, const nlohmann::json& spell) {
+        DatasetSnapshot::SpellRecord record{};
+        record.id = builder.Intern(StringField(spell, "id"));
+        record.name = builder.Intern(StringField(spell, "name"));
+        record.description = builder.Intern(StringField(spell, "description"));
+        record.cooldownBurn = builder.Intern(StringField(spell, "cooldownBurn"));
+        record.modes = builder.AddList(StringList(spell.value("modes", nlohmann::json())));
+        std::vector<float> cooldown;
+        if (spell.contains("cooldown") && spell["cooldown"].is_array()) {
+            for (const auto& value : spell["cooldown"]) {
+                cooldown.push_back(value.is_number() ? value.get<float>() : 0.0f);
+            }
+        }
+        else {
+            cooldown = AbilityTable::ParseBurn(StringField(spell, "cooldownBurn"));
+        }
+        record.firstCooldown = builder.AddFloats(cooldown);
+        record.cooldownCount = static_cast<uint32_t>(cooldown.size());
+        record.summonerLevel = IntField(spell, "summonerLevel", 0);
+        record.source = builder.Intern(spell.dump());
+        record.contentHash = DatasetSnapshot::ContentHash(spell);
+        return record;
+    }
+}
+
+DatasetSnapshot::Builder::Builder(Kind kind, const std::string& patch) : kind(kind), patch(patch) {
+}
+
+DatasetSnapshot::StringRef DatasetSnapshot::Builder::Intern(std::string_view text) {
+    if (text.empty()) {
+        return StringRef();
+    }
+    auto it = internedStrings.find(text);
+    if (it != internedStrings.end()) {
+        return it->second;
+    }
+    StringRef ref{ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size()) };
+    strings.append(text.data(), text.size());
+    internedStrings.emplace(std::string(text), ref);
+    return ref;
+}
+
+DatasetSnapshot::ListRef DatasetSnapshot::Builder::AddList(const std::vector<std::string>& values) {
+    ListRef list{ static_cast<uint32_t>(lists.size()), static_cast<uint32_t>(values.size()) };
+    for (const auto& value : values) {
+        lists.push_back(Intern(value));
+    }
+    return list;
+}
+
+uint32_t DatasetSnapshot::Builder::AddFloats(const std::vector<float>& values) {
+    uint32_t first = static_cast<uint32_t>(floats.size());
+    floats.insert(floats.end(), values.begin(), values.end());
+    return first;
+}
+
+void DatasetSnapshot::Builder::Add(const ChampionRecord& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    records.insert(records.end(), bytes, bytes + sizeof(record));
+    ++recordCount;
+}
+
+void DatasetSnapshot::Builder::Add(const ItemRecord& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    records.insert(records.end(), bytes, bytes + sizeof(record));
+    ++recordCount;
+}
+
+void DatasetSnapshot::Builder::Add(const SpellRecord& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    records.insert(records.end(), bytes, bytes + sizeof(record));
+    ++recordCount;
+}
+
+std::vector<uint8_t> DatasetSnapshot::Builder::Finish() const {
+    const uint8_t* payloads[kSectionCount] = {
+        reinterpret_cast<const uint8_t*>(strings.data()),
+        records.data(),
+        reinterpret_cast<const uint8_t*>(lists.data()),
+        reinterpret_cast<const uint8_t*>(floats.data())
+    };
+    size_t sizes[kSectionCount] = {
+        strings.size(),
+        records.size(),
+        lists.size() * sizeof(StringRef),
+        floats.size() * sizeof(float)
+    };
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format = kFormat;
+    header.kind = static_cast<uint32_t>(kind);
+    header.recordSize = RecordSize(kind);
+    header.recordCount = recordCount;
+    std::memcpy(header.patch, patch.data(), std::min(patch.size(), kPatchLength - 1));
+
+    size_t offset = Align(sizeof(FileHeader));
+    for (uint32_t section = 0; section < kSectionCount; ++section) {
+        header.sections[section].offset = static_cast<uint32_t>(offset);
+        header.sections[section].size = static_cast<uint32_t>(sizes[section]);
+        header.sections[section].crc = Crc32(payloads[section], sizes[section]);
+        offset = Align(offset + sizes[section]);
+    }
+    header.headerCrc = Crc32(reinterpret_cast<const uint8_t*>(&header), offsetof(FileHeader, headerCrc));
+
+    std::vector<uint8_t> image(offset, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    for (uint32_t section = 0; section < kSectionCount; ++section) {
+        if (sizes[section] > 0) {
+            std::memcpy(image.data() + header.sections[section].offset, payloads[section], sizes[section]);
+        }
+    }
+    return image;
+}
+
+uint64_t DatasetSnapshot::ContentHash(nlohmann::json entry) {
+    if (entry.is_object()) {
+        entry.erase("version");
+    }
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : entry.dump()) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::vector<uint8_t> DatasetSnapshot::BuildChampions(const nlohmann::json& document, const std::string& patch) {
+    Builder builder(Kind::Champions, patch);
+    for (const auto& [key, value] : document.at("data").items()) {
+        builder.Add(MakeChampionRecord(builder, key, value));
+    }
+    return builder.Finish();
+}
+
+uint64_t DatasetSnapshot::ContentHash(const JsonView& entry) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::string_view bytes) {
+        for (unsigned char c : bytes) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+    };
+    if (!entry.IsObject()) {
+        mix(entry.Raw());
+        return hash;
+    }
+    entry.ForEachMember([&mix](std::string_view key, const JsonView& value) {
+        if (key != "version") {
+            mix(key);
+            mix(value.Raw());
+        }
+    });
+    return hash;
+}
+
+std::vector<uint8_t> DatasetSnapshot::BuildItems(std::string_view text, const std::string& patch) {
+    Builder builder(Kind::Items, patch);
+    JsonView document(text);
+    if (!document.IsObject()) {
+        throw std::runtime_error("items.json is not an object");
+    }
+    // In key order, so ordinals match the nlohmann build whatever the file's order
+    std::vector<std::pair<std::string_view, JsonView>> entries;
+    document.ForEachMember([&entries](std::string_view key, const JsonView& value) {
+        entries.emplace_back(key, value);
+    });
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& [key, value] : entries) {
+        builder.Add(MakeItemRecord(builder, key, value));
+    }
+    return builder.Finish();
+}
+
+std::vector<uint8_t> DatasetSnapshot::BuildItems(const nlohmann::json& document, const std::string& patch) {
+    Builder builder(Kind::Items, patch);
+    for (const auto& [key, value] : document.items()) {
+        builder.Add(MakeItemRecord(builder, key, value));
+    }
+    return builder.Finish();
+}
+
+std::vector<uint8_t> DatasetSnapshot::BuildSummonerSpells(const nlohmann::json& document, const std::string& patch) {
+    Builder builder(Kind::SummonerSpells, patch);
+    for (const auto& [key, value] : document.at("data").items()) {
+        builder.Add(MakeSpellRecord(builder, value));
+    }
+    return builder.Finish();
+}
+
+bool DatasetSnapshot::Open(const std::filesystem::path& path, Kind expectedKind, const std::string& expectedPatch) {
+    Close();
+    if (!file.Open(path)) {
+        return false;
+    }
+    if (!Validate(file.Data(), file.Size(), expectedKind, expectedPatch)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool DatasetSnapshot::Adopt(std::vector<uint8_t> image, Kind expectedKind, const std::string& expectedPatch) {
+    Close();
+    owned = std::move(image);
+    if (!Validate(owned.data(), owned.size(), expectedKind, expectedPatch)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void DatasetSnapshot::Close() {
+    file.Close();
+    owned.clear();
+    owned.shrink_to_fit();
+    base = nullptr;
+    patch.clear();
+    recordCount = 0;
+    strings = nullptr;
+    stringsSize = 0;
+    records = nullptr;
+    lists = nullptr;
+    listCount = 0;
+    floats = nullptr;
+    floatCount = 0;
+}
+
+bool DatasetSnapshot::Validate(const uint8_t* data, size_t size, Kind expectedKind, const std::string& expectedPatch) {
+    if (size < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.format != kFormat ||
+        header.headerCrc != Crc32(data, offsetof(FileHeader, headerCrc))) {
+        return false;
+    }
+    header.patch[kPatchLength - 1] = '\0';
+    if (header.kind != static_cast<uint32_t>(expectedKind) || header.recordSize != RecordSize(expectedKind) ||
+        (!expectedPatch.empty() && expectedPatch != header.patch)) {
+        return false;   // stale or foreign, not corrupt
+    }
+
+    for (uint32_t section = 0; section < kSectionCount; ++section) {
+        const SectionEntry& entry = header.sections[section];
+        if (entry.offset % 8 != 0 || entry.offset > size || entry.size > size - entry.offset ||
+            Crc32(data + entry.offset, entry.size) != entry.crc) {
+            std::cerr << "Dataset snapshot failed its checksum, rebuilding" << std::endl;
+            return false;
+        }
+    }
+    if (header.sections[kRecords].size != uint64_t(header.recordCount) * header.recordSize ||
+        header.sections[kLists].size % sizeof(StringRef) != 0 || header.sections[kFloats].size % sizeof(float) != 0) {
+        return false;
+    }
+
+    base = data;
+    kind = expectedKind;
+    patch = header.patch;
+    recordCount = header.recordCount;
+    strings = reinterpret_cast<const char*>(data + header.sections[kStrings].offset);
+    stringsSize = header.sections[kStrings].size;
+    records = data + header.sections[kRecords].offset;
+    lists = reinterpret_cast<const StringRef*>(data + header.sections[kLists].offset);
+    listCount = header.sections[kLists].size / sizeof(StringRef);
+    floats = reinterpret_cast<const float*>(data + header.sections[kFloats].offset);
+    floatCount = header.sections[kFloats].size / sizeof(float);
+    return true;
+}
+
+bool DatasetSnapshot::Write(const std::filesystem::path& path, const std::vector<uint8_t>& image) {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open " << temporary << " for writing" << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!out) {
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to write dataset snapshot: " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const DatasetSnapshot::ChampionRecord& DatasetSnapshot::Champion(size_t index) const {
+    return reinterpret_cast<const ChampionRecord*>(records)[index];
+}
+
+const DatasetSnapshot::ItemRecord& DatasetSnapshot::Item(size_t index) const {
+    return reinterpret_cast<const ItemRecord*>(records)[index];
+}
+
+const DatasetSnapshot::SpellRecord& DatasetSnapshot::Spell(size_t index) const {
+    return reinterpret_cast<const SpellRecord*>(records)[index];
+}
+
+std::string_view DatasetSnapshot::View(StringRef ref) const {
+    // The checksums only prove the file is the one we wrote, so offsets are
+    // still bounded against the pool
+    if (ref.offset > stringsSize || ref.length > stringsSize - ref.offset) {
+        return std::string_view();
+    }
+    return std::string_view(strings + ref.offset, ref.length);
+}
+
+std::string_view DatasetSnapshot::ListAt(ListRef list, uint32_t index) const {
+    if (index >= list.count || list.first > listCount || list.count > listCount - list.first) {
+        return std::string_view();
+    }
+    return View(lists[list.first + index]);
+}
+
+std::vector<std::string> DatasetSnapshot::Strings(ListRef list) const {
+    std::vector<std::string> out;
+    out.reserve(list.count);
+    for (uint32_t i = 0; i < list.count; ++i) {
+        out.emplace_back(ListAt(list, i));
+    }
+    return out;
+}
+
+const float* DatasetSnapshot::Floats(uint32_t first, uint32_t count) const {
+    if (first > floatCount || count > floatCount - first) {
+        return nullptr;
+    }
+    return floats + first;
+}
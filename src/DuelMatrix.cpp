@@ -0,0 +1,103 @@
+#include "DuelMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr float kCritDamageBonus = 0.75f;   // crits deal 175%
+    constexpr float kAttackSpeedCap = 2.5f;
+    // Rows per task; small enough for the pool to balance ~170 rows
+    constexpr size_t kRowsPerTask = 4;
+}
+
+bool DuelMatrix::Fighter::operator==(const Fighter& other) const {
+    return health == other.health && armor == other.armor && healthRegen == other.healthRegen &&
+        attackDamage == other.attackDamage && attackSpeed == other.attackSpeed && critChance == other.critChance &&
+        lethality == other.lethality && armorPenPercent == other.armorPenPercent;
+}
+
+DuelMatrix::Fighter DuelMatrix::MakeFighter(const ChampionLevelStats& champion, const StatVector& itemTotals) {
+    auto total = [&](Stat stat) { return champion.stats[StatIndex(stat)] + itemTotals[StatIndex(stat)]; };
+
+    Fighter fighter;
+    fighter.health = total(Stat::Health);
+    fighter.armor = total(Stat::Armor);
+    fighter.healthRegen = total(Stat::HealthRegen) / 5.0f;
+    fighter.attackDamage = total(Stat::AttackDamage);
+    float bonusAttackSpeed = champion.attackSpeedGrowth + itemTotals[StatIndex(Stat::AttackSpeed)];
+    fighter.attackSpeed = champion.baseAttackSpeed > 0.0f
+        ? champion.baseAttackSpeed * (1.0f + bonusAttackSpeed / 100.0f)
+        : total(Stat::AttackSpeed);
+    fighter.attackSpeed = std::min(fighter.attackSpeed, kAttackSpeedCap);
+    fighter.critChance = std::min(100.0f, total(Stat::CritChance)) / 100.0f;
+    fighter.lethality = itemTotals[StatIndex(Stat::Lethality)];
+    fighter.armorPenPercent = std::min(100.0f, itemTotals[StatIndex(Stat::ArmorPenPercent)]) / 100.0f;
+    return fighter;
+}
+
+float DuelMatrix::TimeToKill(const Fighter& attacker, const Fighter& defender) {
+    const float never = std::numeric_limits<float>::infinity();
+    if (attacker.attackSpeed <= 0.0f || attacker.attackDamage <= 0.0f) {
+        return never;
+    }
+    float armor = std::max(0.0f, defender.armor * (1.0f - attacker.armorPenPercent) - attacker.lethality);
+    float hit = attacker.attackDamage * (1.0f + kCritDamageBonus * attacker.critChance) * 100.0f / (100.0f + armor);
+    float interval = 1.0f / attacker.attackSpeed;
+    float regenPerHit = defender.healthRegen * interval;
+
+    // After n hits the defender has taken n * hit and healed (n - 1) * regenPerHit
+    if (hit >= defender.health) {
+        return 0.0f;
+    }
+    if (hit <= regenPerHit) {
+        return never;
+    }
+    float hits = std::ceil((defender.health - regenPerHit) / (hit - regenPerHit));
+    return (hits - 1.0f) * interval;
+}
+
+size_t DuelMatrix::Update(const std::vector<Fighter>& newFighters, TaskPool& pool) {
+    size_t count = newFighters.size();
+    std::vector<uint32_t> changed;
+    std::vector<uint8_t> rowChanged(count, 0);
+    if (count != fighters.size()) {
+        ttk.assign(count * count, 0.0f);
+        for (uint32_t i = 0; i < count; ++i) {
+            changed.push_back(i);
+            rowChanged[i] = 1;
+        }
+    }
+    else {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (newFighters[i] != fighters[i]) {
+                changed.push_back(i);
+                rowChanged[i] = 1;
+            }
+        }
+    }
+    if (changed.empty()) {
+        return 0;
+    }
+    fighters = newFighters;
+
+    // A changed champion recomputes its whole row; every other row only the
+    // changed columns
+    pool.ParallelFor(count, kRowsPerTask, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            float* out = ttk.data() + row * count;
+            const Fighter& attacker = fighters[row];
+            if (rowChanged[row]) {
+                for (size_t column = 0; column < count; ++column) {
+                    out[column] = TimeToKill(attacker, fighters[column]);
+                }
+            }
+            else {
+                for (uint32_t column : changed) {
+                    out[column] = TimeToKill(attacker, fighters[column]);
+                }
+            }
+        }
+    });
+    ++version;
+    return changed.size() * count + (count - changed.size()) * changed.size();
+}
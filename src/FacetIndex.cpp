@@ -0,0 +1,193 @@
+#include "FacetIndex.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    inline size_t PopCount(uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<size_t>(__popcnt64(word));
+#else
+        return static_cast<size_t>(__builtin_popcountll(word));
+#endif
+    }
+
+    inline uint32_t LowestBit(uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+    }
+
+    const std::vector<std::string> kNoValues;
+}
+
+FacetIndex::Bitmap::Bitmap(size_t bits, bool filled)
+    : words((bits + 63) / 64, filled ? ~uint64_t(0) : 0), bits(bits) {
+    // Keep the bits past the end clear so Count and CountAnd stay exact
+    if (filled && (bits & 63) != 0) {
+        words.back() = (uint64_t(1) << (bits & 63)) - 1;
+    }
+}
+
+size_t FacetIndex::Bitmap::Count() const {
+    size_t count = 0;
+    for (uint64_t word : words) {
+        count += PopCount(word);
+    }
+    return count;
+}
+
+std::vector<uint32_t> FacetIndex::Bitmap::ToOrdinals() const {
+    std::vector<uint32_t> ordinals;
+    ordinals.reserve(Count());
+    for (size_t i = 0; i < words.size(); ++i) {
+        uint64_t word = words[i];
+        while (word != 0) {
+            ordinals.push_back(static_cast<uint32_t>(i * 64) + LowestBit(word));
+            word &= word - 1;
+        }
+    }
+    return ordinals;
+}
+
+FacetIndex::Bitmap& FacetIndex::Bitmap::operator&=(const Bitmap& other) {
+    for (size_t i = 0; i < words.size(); ++i) {
+        words[i] &= i < other.words.size() ? other.words[i] : 0;
+    }
+    return *this;
+}
+
+FacetIndex::Bitmap& FacetIndex::Bitmap::operator|=(const Bitmap& other) {
+    for (size_t i = 0; i < words.size() && i < other.words.size(); ++i) {
+        words[i] |= other.words[i];
+    }
+    return *this;
+}
+
+size_t FacetIndex::Bitmap::CountAnd(const Bitmap& a, const Bitmap& b) {
+    size_t count = 0;
+    size_t wordCount = std::min(a.words.size(), b.words.size());
+    for (size_t i = 0; i < wordCount; ++i) {
+        count += PopCount(a.words[i] & b.words[i]);
+    }
+    return count;
+}
+
+void FacetIndex::Reset(size_t count) {
+    entityCount = count;
+    facetNames.clear();
+    facets.clear();
+    facetIds.clear();
+}
+
+FacetIndex::Facet& FacetIndex::GetOrAddFacet(const std::string& facet) {
+    auto [facetIt, facetInserted] = facetIds.emplace(facet, static_cast<uint32_t>(facets.size()));
+    if (facetInserted) {
+        facetNames.push_back(facet);
+        facets.emplace_back();
+    }
+    return facets[facetIt->second];
+}
+
+void FacetIndex::Add(const std::string& facet, const std::string& value, uint32_t ordinal) {
+    if (ordinal >= entityCount) {
+        return;
+    }
+    Facet& entry = GetOrAddFacet(facet);
+
+    auto [valueIt, valueInserted] = entry.valueIds.emplace(value, static_cast<uint32_t>(entry.values.size()));
+    if (valueInserted) {
+        entry.values.push_back(value);
+        entry.bitmaps.emplace_back(entityCount);
+    }
+    entry.bitmaps[valueIt->second].Set(ordinal);
+}
+
+void FacetIndex::Declare(const std::string& facet, const std::vector<std::string>& values) {
+    Facet& entry = GetOrAddFacet(facet);
+    for (const auto& value : values) {
+        if (entry.valueIds.emplace(value, static_cast<uint32_t>(entry.values.size())).second) {
+            entry.values.push_back(value);
+            entry.bitmaps.emplace_back(entityCount);
+        }
+    }
+}
+
+const FacetIndex::Facet* FacetIndex::FindFacet(const std::string& facet) const {
+    auto it = facetIds.find(facet);
+    return it != facetIds.end() ? &facets[it->second] : nullptr;
+}
+
+const std::vector<std::string>& FacetIndex::GetValues(const std::string& facet) const {
+    const Facet* entry = FindFacet(facet);
+    return entry ? entry->values : kNoValues;
+}
+
+const FacetIndex::Bitmap* FacetIndex::Find(const std::string& facet, const std::string& value) const {
+    const Facet* entry = FindFacet(facet);
+    if (!entry) {
+        return nullptr;
+    }
+    auto it = entry->valueIds.find(value);
+    return it != entry->valueIds.end() ? &entry->bitmaps[it->second] : nullptr;
+}
+
+std::vector<std::string> FacetIndex::GetValuesFor(const std::string& facet, uint32_t ordinal) const {
+    std::vector<std::string> values;
+    if (const Facet* entry = FindFacet(facet)) {
+        for (size_t i = 0; i < entry->values.size(); ++i) {
+            if (entry->bitmaps[i].Test(ordinal)) {
+                values.push_back(entry->values[i]);
+            }
+        }
+    }
+    return values;
+}
+
+FacetIndex::Bitmap FacetIndex::Evaluate(const Filter& filter, const std::string& skipFacet) const {
+    Bitmap result(entityCount, true);
+    for (const auto& [facet, selection] : filter) {
+        if (selection.values.empty() || facet == skipFacet) {
+            continue;
+        }
+        if (selection.matchAll) {
+            for (const auto& value : selection.values) {
+                const Bitmap* bitmap = Find(facet, value);
+                if (!bitmap) {
+                    return Bitmap(entityCount);
+                }
+                result &= *bitmap;
+            }
+            continue;
+        }
+        Bitmap any(entityCount);
+        for (const auto& value : selection.values) {
+            if (const Bitmap* bitmap = Find(facet, value)) {
+                any |= *bitmap;
+            }
+        }
+        result &= any;
+    }
+    return result;
+}
+
+std::vector<size_t> FacetIndex::Counts(const Filter& filter, const std::string& facet) const {
+    std::vector<size_t> counts;
+    const Facet* entry = FindFacet(facet);
+    if (!entry) {
+        return counts;
+    }
+    auto selection = filter.find(facet);
+    bool matchAll = selection != filter.end() && selection->second.matchAll;
+    Bitmap base = Evaluate(filter, matchAll ? std::string() : facet);
+    counts.reserve(entry->bitmaps.size());
+    for (const auto& bitmap : entry->bitmaps) {
+        counts.push_back(Bitmap::CountAnd(base, bitmap));
+    }
+    return counts;
+}
@@ -0,0 +1,416 @@
+#include "GlyphCache.h"
+#include "imgui_impl_opengl3.h"
+#include <misc/freetype/imgui_freetype.h>
+#include <GLFW/glfw3.h>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr uint32_t kFileMagic = 0x4146464C;  // "LFFA"
+    constexpr uint32_t kFileFormat = 1;
+
+    constexpr int kAtlasWidth = 1024;
+    // Four 1016x128 pages hold about two thousand CJK glyphs at the UI sizes
+    constexpr int kSparePages = 4;
+    constexpr int kPageWidth = kAtlasWidth - 8;
+    constexpr int kPageHeight = 128;
+    constexpr int kGlyphPadding = 1;
+
+    void WriteU32(std::ofstream& out, uint32_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteFloats(std::ofstream& out, const float* values, size_t count) {
+        out.write(reinterpret_cast<const char*>(values), count * sizeof(float));
+    }
+
+    bool ReadU32(std::ifstream& in, uint32_t& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool ReadFloats(std::ifstream& in, float* values, size_t count) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(values), count * sizeof(float)));
+    }
+
+    void HashBytes(uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    void HashFile(uint64_t& hash, const std::string& file) {
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(file, error);
+        int64_t written = error ? 0 : std::filesystem::last_write_time(file, error).time_since_epoch().count();
+        HashBytes(hash, file.data(), file.size());
+        HashBytes(hash, &size, sizeof(size));
+        HashBytes(hash, &written, sizeof(written));
+    }
+
+    struct BakedGlyph {
+        uint32_t codepoint = 0;
+        float values[9] = {};   // advance, corners, texture coordinates
+    };
+
+    struct BakedFont {
+        float size = 0, ascent = 0, descent = 0;
+        std::vector<BakedGlyph> glyphs;
+    };
+}
+
+GlyphCache::GlyphCache(std::string fontFile, std::vector<float> sizes) : fontFile(std::move(fontFile)), sizes(std::move(sizes)) {
+}
+
+bool GlyphCache::Load(ImFontAtlas* atlas, const std::filesystem::path& cacheFile, const std::vector<std::string>& fallbacks) {
+    uint64_t key = SourceKey(fallbacks);
+    if (ReadBaked(atlas, cacheFile, key)) {
+        return true;
+    }
+    if (!Bake(atlas, atlas->GetGlyphRangesDefault(), fallbacks)) {
+        return false;
+    }
+    WriteBaked(atlas, cacheFile, key);
+    return true;
+}
+
+bool GlyphCache::Rebuild(ImFontAtlas* atlas, const std::vector<ImWchar>& glyphs, const std::vector<std::string>& fallbacks) {
+    ImFontGlyphRangesBuilder builder;
+    builder.AddRanges(atlas->GetGlyphRangesDefault());
+    for (ImWchar c : glyphs) {
+        builder.AddChar(c);
+    }
+    ImVector<ImWchar> ranges;
+    builder.BuildRanges(&ranges);
+
+    bool baked = Bake(atlas, ranges.Data, fallbacks);
+    if (!baked) {
+        // Keep the UI readable with what the face alone has
+        Bake(atlas, atlas->GetGlyphRangesDefault(), {});
+    }
+    ImGui_ImplOpenGL3_DestroyFontsTexture();
+    ImGui_ImplOpenGL3_CreateFontsTexture();
+    return baked;
+}
+
+bool GlyphCache::Bake(ImFontAtlas* atlas, const ImWchar* ranges, const std::vector<std::string>& fallbacks) {
+    atlas->Clear();
+    atlas->FontBuilderIO = ImGuiFreeType::GetBuilderForFreeType();
+    atlas->Flags |= ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoPowerOfTwoHeight;
+    atlas->TexDesiredWidth = kAtlasWidth;
+    atlas->TexGlyphPadding = kGlyphPadding;
+    for (float size : sizes) {
+        if (atlas->AddFontFromFileTTF(fontFile.c_str(), size, nullptr, ranges) == nullptr) {
+            std::cerr << "Failed to load font " << fontFile << std::endl;
+            atlas->Clear();
+            return false;
+        }
+        ImFontConfig merge;
+        merge.MergeMode = true;
+        // Each glyph comes from the first font that has it
+        for (const auto& file : fallbacks) {
+            atlas->AddFontFromFileTTF(file.c_str(), size, &merge, ranges);
+        }
+    }
+
+    int pageIds[kSparePages];
+    for (int& id : pageIds) {
+        id = atlas->AddCustomRectRegular(kPageWidth, kPageHeight);
+    }
+    if (!atlas->Build()) {
+        std::cerr << "Failed to build the font atlas" << std::endl;
+        atlas->Clear();
+        return false;
+    }
+
+    pages.clear();
+    for (int id : pageIds) {
+        const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(id);
+        pages.push_back({ rect->X, rect->Y });
+    }
+    page = 0;
+    penX = penY = shelfHeight = 0;
+    // The font files are read again if glyphs are added, so they need not stay loaded
+    atlas->ClearInputData();
+    return true;
+}
+
+bool GlyphCache::Add(ImFontAtlas* atlas, const std::vector<ImWchar>& glyphs, const std::vector<std::string>& fallbacks) {
+    if (glyphs.empty()) {
+        return true;
+    }
+    if (atlas->TexPixelsAlpha8 == nullptr || atlas->Fonts.Size != static_cast<int>(sizes.size())) {
+        return false;
+    }
+
+    ImFontGlyphRangesBuilder builder;
+    builder.AddChar(' ');   // so a font without any of the glyphs still builds
+    for (ImWchar c : glyphs) {
+        builder.AddChar(c);
+    }
+    ImVector<ImWchar> ranges;
+    builder.BuildRanges(&ranges);
+
+    // The face comes first, as in the atlas, so glyphs sit on its baseline
+    ImFontAtlas scratch;
+    scratch.FontBuilderIO = ImGuiFreeType::GetBuilderForFreeType();
+    scratch.Flags = ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_NoPowerOfTwoHeight;
+    scratch.TexGlyphPadding = kGlyphPadding;
+    for (float size : sizes) {
+        if (scratch.AddFontFromFileTTF(fontFile.c_str(), size, nullptr, ranges.Data) == nullptr) {
+            return true;
+        }
+        ImFontConfig merge;
+        merge.MergeMode = true;
+        for (const auto& file : fallbacks) {
+            scratch.AddFontFromFileTTF(file.c_str(), size, &merge, ranges.Data);
+        }
+    }
+    unsigned char* source = nullptr;
+    int sourceWidth = 0, sourceHeight = 0;
+    scratch.GetTexDataAsAlpha8(&source, &sourceWidth, &sourceHeight);
+    if (source == nullptr) {
+        return true;
+    }
+
+    int dirtyTop = atlas->TexHeight, dirtyBottom = 0;
+    bool fits = true;
+    for (int i = 0; i < atlas->Fonts.Size && fits; ++i) {
+        ImFont* font = atlas->Fonts[i];
+        // BuildLookupTable appends a tab glyph; drop it so it isn't duplicated
+        if (!font->Glyphs.empty() && font->Glyphs.back().Codepoint == '\t') {
+            font->Glyphs.pop_back();
+        }
+        for (const ImFontGlyph& glyph : scratch.Fonts[i]->Glyphs) {
+            ImWchar c = static_cast<ImWchar>(glyph.Codepoint);
+            if (c <= ' ' || font->FindGlyphNoFallback(c) != nullptr) {
+                continue;
+            }
+            if (!glyph.Visible) {
+                font->AddGlyph(nullptr, c, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, 0, 0, 0, 0, glyph.AdvanceX);
+                continue;
+            }
+
+            int sourceX = static_cast<int>(glyph.U0 * sourceWidth + 0.5f);
+            int sourceY = static_cast<int>(glyph.V0 * sourceHeight + 0.5f);
+            int width = static_cast<int>(glyph.U1 * sourceWidth + 0.5f) - sourceX;
+            int height = static_cast<int>(glyph.V1 * sourceHeight + 0.5f) - sourceY;
+            int x = 0, y = 0;
+            if (!Place(width, height, x, y)) {
+                fits = false;
+                break;
+            }
+            for (int row = 0; row < height; ++row) {
+                const unsigned char* from = source + (sourceY + row) * sourceWidth + sourceX;
+                std::memcpy(atlas->TexPixelsAlpha8 + (y + row) * atlas->TexWidth + x, from, width);
+                // The backend's copy, if it made one, is what gets uploaded
+                if (atlas->TexPixelsRGBA32 != nullptr) {
+                    unsigned int* to = atlas->TexPixelsRGBA32 + (y + row) * atlas->TexWidth + x;
+                    for (int column = 0; column < width; ++column) {
+                        to[column] = IM_COL32(255, 255, 255, from[column]);
+                    }
+                }
+            }
+            dirtyTop = std::min(dirtyTop, y);
+            dirtyBottom = std::max(dirtyBottom, y + height);
+            font->AddGlyph(nullptr, c, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+                x * atlas->TexUvScale.x, y * atlas->TexUvScale.y,
+                (x + width) * atlas->TexUvScale.x, (y + height) * atlas->TexUvScale.y, glyph.AdvanceX);
+        }
+        font->BuildLookupTable();
+    }
+
+    // Whole rows, so the upload needs no row length
+    if (dirtyTop < dirtyBottom && atlas->TexPixelsRGBA32 != nullptr && atlas->TexID != nullptr) {
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(reinterpret_cast<intptr_t>(atlas->TexID)));
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, dirtyTop, atlas->TexWidth, dirtyBottom - dirtyTop, GL_RGBA, GL_UNSIGNED_BYTE,
+            atlas->TexPixelsRGBA32 + dirtyTop * atlas->TexWidth);
+    }
+    return fits;
+}
+
+bool GlyphCache::Place(int width, int height, int& x, int& y) {
+    width += kGlyphPadding;
+    height += kGlyphPadding;
+    if (width > kPageWidth || height > kPageHeight) {
+        return false;
+    }
+    while (page < pages.size()) {
+        if (penX + width > kPageWidth) {
+            penX = 0;
+            penY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (penY + height <= kPageHeight) {
+            x = pages[page].x + penX;
+            y = pages[page].y + penY;
+            penX += width;
+            shelfHeight = std::max(shelfHeight, height);
+            return true;
+        }
+        ++page;
+        penX = penY = shelfHeight = 0;
+    }
+    return false;
+}
+
+uint64_t GlyphCache::SourceKey(const std::vector<std::string>& fallbacks) const {
+    uint64_t hash = 14695981039346656037ull;
+    uint32_t settings[] = { kFileFormat, IMGUI_VERSION_NUM, kAtlasWidth, kSparePages, kPageWidth, kPageHeight };
+    HashBytes(hash, settings, sizeof(settings));
+    HashBytes(hash, sizes.data(), sizes.size() * sizeof(float));
+    HashFile(hash, fontFile);
+    for (const auto& file : fallbacks) {
+        HashFile(hash, file);
+    }
+    return hash;
+}
+
+bool GlyphCache::WriteBaked(const ImFontAtlas* atlas, const std::filesystem::path& path, uint64_t key) const {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open " << temporary << " for writing" << std::endl;
+            return false;
+        }
+
+        WriteU32(out, kFileMagic);
+        WriteU32(out, kFileFormat);
+        out.write(reinterpret_cast<const char*>(&key), sizeof(key));
+
+        WriteU32(out, atlas->TexWidth);
+        WriteU32(out, atlas->TexHeight);
+        out.write(reinterpret_cast<const char*>(atlas->TexPixelsAlpha8), static_cast<std::streamsize>(atlas->TexWidth) * atlas->TexHeight);
+        WriteFloats(out, &atlas->TexUvWhitePixel.x, 2);
+        WriteFloats(out, &atlas->TexUvLines[0].x, 4 * (IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1));
+
+        WriteU32(out, static_cast<uint32_t>(pages.size()));
+        for (const Page& spare : pages) {
+            WriteU32(out, spare.x);
+            WriteU32(out, spare.y);
+        }
+
+        WriteU32(out, atlas->Fonts.Size);
+        for (const ImFont* font : atlas->Fonts) {
+            float metrics[] = { font->FontSize, font->Ascent, font->Descent };
+            WriteFloats(out, metrics, 3);
+            WriteU32(out, font->Glyphs.Size);
+            for (const ImFontGlyph& glyph : font->Glyphs) {
+                WriteU32(out, glyph.Codepoint);
+                float values[] = { glyph.AdvanceX, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, glyph.U0, glyph.V0, glyph.U1, glyph.V1 };
+                WriteFloats(out, values, 9);
+            }
+        }
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to write the font cache: " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GlyphCache::ReadBaked(ImFontAtlas* atlas, const std::filesystem::path& path, uint64_t key) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint32_t magic = 0, format = 0;
+    uint64_t fileKey = 0;
+    if (!ReadU32(in, magic) || magic != kFileMagic || !ReadU32(in, format) || format != kFileFormat ||
+        !in.read(reinterpret_cast<char*>(&fileKey), sizeof(fileKey)) || fileKey != key) {
+        return false;
+    }
+
+    uint32_t width = 0, height = 0;
+    if (!ReadU32(in, width) || !ReadU32(in, height) || width == 0 || width > 8192 || height == 0 || height > 32768) {
+        return false;
+    }
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height);
+    ImVec2 whitePixel;
+    ImVec4 lines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    if (!in.read(reinterpret_cast<char*>(pixels.data()), pixels.size()) || !ReadFloats(in, &whitePixel.x, 2) ||
+        !ReadFloats(in, &lines[0].x, 4 * (IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1))) {
+        return false;
+    }
+
+    uint32_t pageCount = 0;
+    if (!ReadU32(in, pageCount) || pageCount > kSparePages) {
+        return false;
+    }
+    std::vector<Page> loadedPages(pageCount);
+    for (Page& spare : loadedPages) {
+        uint32_t x = 0, y = 0;
+        if (!ReadU32(in, x) || !ReadU32(in, y) || x + kPageWidth > width || y + kPageHeight > height) {
+            return false;
+        }
+        spare = { static_cast<int>(x), static_cast<int>(y) };
+    }
+
+    uint32_t fontCount = 0;
+    if (!ReadU32(in, fontCount) || fontCount != sizes.size()) {
+        return false;
+    }
+    std::vector<BakedFont> fonts(fontCount);
+    for (BakedFont& font : fonts) {
+        float metrics[3];
+        uint32_t glyphCount = 0;
+        if (!ReadFloats(in, metrics, 3) || !ReadU32(in, glyphCount) || glyphCount == 0 || glyphCount >= 0xFFFF) {
+            return false;
+        }
+        font.size = metrics[0];
+        font.ascent = metrics[1];
+        font.descent = metrics[2];
+        font.glyphs.resize(glyphCount);
+        for (BakedGlyph& glyph : font.glyphs) {
+            if (!ReadU32(in, glyph.codepoint) || glyph.codepoint > IM_UNICODE_CODEPOINT_MAX || !ReadFloats(in, glyph.values, 9)) {
+                return false;
+            }
+        }
+    }
+
+    // Only a complete file replaces the atlas contents
+    atlas->Clear();
+    atlas->FontBuilderIO = ImGuiFreeType::GetBuilderForFreeType();
+    atlas->Flags |= ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoPowerOfTwoHeight;
+    atlas->TexDesiredWidth = kAtlasWidth;
+    atlas->TexGlyphPadding = kGlyphPadding;
+    atlas->TexWidth = static_cast<int>(width);
+    atlas->TexHeight = static_cast<int>(height);
+    atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixels.size()));
+    std::memcpy(atlas->TexPixelsAlpha8, pixels.data(), pixels.size());
+    atlas->TexUvScale = ImVec2(1.0f / width, 1.0f / height);
+    atlas->TexUvWhitePixel = whitePixel;
+    std::copy(std::begin(lines), std::end(lines), atlas->TexUvLines);
+    for (const BakedFont& baked : fonts) {
+        ImFont* font = IM_NEW(ImFont);
+        atlas->Fonts.push_back(font);
+        font->ContainerAtlas = atlas;
+        font->FontSize = baked.size;
+        font->Ascent = baked.ascent;
+        font->Descent = baked.descent;
+        for (const BakedGlyph& glyph : baked.glyphs) {
+            const float* v = glyph.values;
+            font->AddGlyph(nullptr, static_cast<ImWchar>(glyph.codepoint), v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[0]);
+        }
+        font->BuildLookupTable();
+    }
+    atlas->TexReady = true;
+
+    pages = std::move(loadedPages);
+    page = 0;
+    penX = penY = shelfHeight = 0;
+    return true;
+}
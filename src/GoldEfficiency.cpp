@@ -0,0 +1,114 @@
+#include "GoldEfficiency.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    // Relative weight of the baseline prior; small enough that any stat the
+    // basic items carry is priced by the data.
+    constexpr double kPriorWeight = 1e-3;
+
+    // Solves the dense symmetric system in place by Gaussian elimination with
+    // partial pivoting.
+    bool Solve(std::array<std::array<double, kStatCount>, kStatCount>& a, std::array<double, kStatCount>& b) {
+        for (size_t col = 0; col < kStatCount; ++col) {
+            size_t pivot = col;
+            for (size_t row = col + 1; row < kStatCount; ++row) {
+                if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+            }
+            if (std::fabs(a[pivot][col]) < 1e-12) {
+                return false;
+            }
+            std::swap(a[col], a[pivot]);
+            std::swap(b[col], b[pivot]);
+            for (size_t row = col + 1; row < kStatCount; ++row) {
+                double factor = a[row][col] / a[col][col];
+                for (size_t k = col; k < kStatCount; ++k) {
+                    a[row][k] -= factor * a[col][k];
+                }
+                b[row] -= factor * b[col];
+            }
+        }
+        for (size_t col = kStatCount; col-- > 0;) {
+            double sum = b[col];
+            for (size_t k = col + 1; k < kStatCount; ++k) {
+                sum -= a[col][k] * b[k];
+            }
+            b[col] = sum / a[col][col];
+        }
+        return true;
+    }
+}
+
+StatVector GoldEfficiency::FitPrices(const ItemStatTable& table, const std::vector<uint32_t>& basicItems,
+                                     std::array<bool, kStatCount>& fitted, float& rmsError) {
+    const StatVector& baseline = BaselineGoldValues();
+
+    // Normal equations of min |A p - c|^2 + w |D (p - baseline)|^2, where D
+    // scales each stat by how much the data says about it.
+    std::array<std::array<double, kStatCount>, kStatCount> normal{};
+    std::array<double, kStatCount> rhs{};
+    for (uint32_t item : basicItems) {
+        for (size_t i = 0; i < kStatCount; ++i) {
+            double xi = table.columns[i][item];
+            if (xi == 0.0) continue;
+            rhs[i] += xi * table.cost[item];
+            for (size_t j = 0; j < kStatCount; ++j) {
+                normal[i][j] += xi * table.columns[j][item];
+            }
+        }
+    }
+
+    double meanDiagonal = 0.0;
+    for (size_t i = 0; i < kStatCount; ++i) meanDiagonal += normal[i][i];
+    meanDiagonal = std::max(1.0, meanDiagonal / kStatCount);
+    for (size_t i = 0; i < kStatCount; ++i) {
+        fitted[i] = normal[i][i] > 0.0;
+        double weight = kPriorWeight * (fitted[i] ? normal[i][i] : meanDiagonal);
+        normal[i][i] += weight;
+        rhs[i] += weight * baseline[i];
+    }
+
+    StatVector prices = baseline;
+    if (Solve(normal, rhs)) {
+        for (size_t i = 0; i < kStatCount; ++i) {
+            prices[i] = static_cast<float>(rhs[i]);
+        }
+    }
+
+    double squared = 0.0;
+    for (uint32_t item : basicItems) {
+        double predicted = 0.0;
+        for (size_t i = 0; i < kStatCount; ++i) {
+            predicted += prices[i] * table.columns[i][item];
+        }
+        squared += (predicted - table.cost[item]) * (predicted - table.cost[item]);
+    }
+    rmsError = basicItems.empty() ? 0.0f : static_cast<float>(std::sqrt(squared / basicItems.size()));
+    return prices;
+}
+
+const GoldEfficiency::Result& GoldEfficiency::Compute(const ItemStatTable& table, const std::vector<uint32_t>& basicItems) {
+    result.prices = FitPrices(table, basicItems, result.fitted, result.rmsError);
+    result.basicItemCount = basicItems.size();
+
+    // One pass per stat column, so the inner loop is a plain multiply-add the
+    // compiler vectorizes
+    size_t count = table.Size();
+    result.value.assign(count, 0.0f);
+    result.efficiency.assign(count, 0.0f);
+    float* value = result.value.data();
+    for (size_t stat = 0; stat < kStatCount; ++stat) {
+        const float price = result.prices[stat];
+        const float* column = table.columns[stat].data();
+        for (size_t item = 0; item < count; ++item) {
+            value[item] += price * column[item];
+        }
+    }
+    const float* cost = table.cost.data();
+    float* efficiency = result.efficiency.data();
+    for (size_t item = 0; item < count; ++item) {
+        efficiency[item] = cost[item] > 0.0f ? 100.0f * value[item] / cost[item] : 0.0f;
+    }
+    computed = true;
+    return result;
+}
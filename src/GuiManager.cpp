@@ -10,6 +10,7 @@
 #include <GLFW/glfw3native.h>
 #include <Windows.h>
 #include <misc/freetype/imgui_freetype.h>
+#include "imgui_internal.h"
 
 
 static void glfw_error_callback(int error, const char* description)
@@ -17,6 +18,63 @@ static void glfw_error_callback(int error, const char* description)
 	std::cerr << "GLFW Error " << error << ": " << description << std::endl;
 }
 
+// Installed Windows fonts to take missing glyphs from, the locale's own script
+// first so shared Han characters get its forms. CJK fonts are large, so they
+// are only opened when CJK text was seen.
+static std::vector<std::string> FallbackFontFiles(const std::string& locale, bool needCjk)
+{
+	char windows[MAX_PATH] = "C:\\Windows";
+	GetWindowsDirectoryA(windows, MAX_PATH);
+	std::filesystem::path fonts = std::filesystem::path(windows) / "Fonts";
+
+	std::vector<const char*> names;
+	if (needCjk) {
+		if (locale == "ja_JP") names = { "YuGothM.ttc", "meiryo.ttc" };
+		else if (locale == "ko_KR") names = { "malgun.ttf" };
+		else if (locale == "zh_TW") names = { "msjh.ttc" };
+		else if (locale == "zh_CN") names = { "msyh.ttc" };
+	}
+	names.insert(names.end(), { "segoeui.ttf", "tahoma.ttf" });
+	if (needCjk) {
+		names.insert(names.end(), { "msyh.ttc", "malgun.ttf", "YuGothM.ttc" });
+	}
+
+	std::vector<std::string> files;
+	for (const char* name : names) {
+		std::string file = (fonts / name).string();
+		std::error_code error;
+		if (std::filesystem::exists(file, error) && std::find(files.begin(), files.end(), file) == files.end()) {
+			files.push_back(file);
+		}
+	}
+	return files;
+}
+
+// String at a json pointer such as "/image/full", or empty if it is missing or not a string
+static std::string DetailString(const nlohmann::json& object, const char* pointer)
+{
+	nlohmann::json::json_pointer path(pointer);
+	if (!object.contains(path) || !object.at(path).is_string()) {
+		return std::string();
+	}
+	return object.at(path).get<std::string>();
+}
+
+// Strings of a champion detail array such as "allytips"; anything else is skipped
+static std::vector<std::string> DetailStrings(const nlohmann::json& champion, const char* key)
+{
+	std::vector<std::string> strings;
+	auto list = champion.find(key);
+	if (list != champion.end() && list->is_array()) {
+		for (const auto& value : *list) {
+			if (value.is_string()) {
+				strings.push_back(value.get<std::string>());
+			}
+		}
+	}
+	return strings;
+}
+
 GUIManager::GUIManager()
 	: window(nullptr),
 	backgroundTexture(0),
@@ -28,17 +86,19 @@ GUIManager::GUIManager()
 	iconTexture(0),
 	isIconLoaded(false),
 	skillTextures(5, 0),
-	areSkillIconsLoaded(false),
+	areChampionDetailsLoaded(false),
 	isRandomizing(false),
 	hasRandomChampion(false),
 	comboSelectedIndex(-1),
 	historyFilePath(std::filesystem::current_path() / "item_history.txt") {}
 
 GUIManager::~GUIManager() {
-	isRandomizing.store(false);
-	if (randomizationThread.joinable()) {
-		randomizationThread.join();
-	}
+	// Nothing may still be writing into state the destructor frees
+	loaders.Cancel();
+	dataLoads.Cancel();
+	uiTasks.Cancel();
+	// The data loads download with curl, which Cleanup shuts down
+	dataManager.CancelLoads();
 	if (images[0].pixels) {
 		stbi_image_free(images[0].pixels);
 	}
@@ -95,29 +155,35 @@ bool GUIManager::Initialize(int width, int height, const char* title) {
 	ApplyCustomStyles();
 	ImGuiIO& io = ImGui::GetIO();
 
-	defaultFont = io.Fonts->AddFontFromFileTTF(".\\assets\\recharge bd.ttf", 14.0f);
-	if (defaultFont == nullptr) {
+	// Read back from the cache unless the font files changed since it was baked
+	if (!glyphCache.Load(io.Fonts, std::filesystem::current_path() / "cache" / "fonts.bin", FallbackFontFiles(shownLocale, false))) {
 		std::cerr << "Failed to load default font" << std::endl;
 		return false;
 	}
-
-	smallFont = io.Fonts->AddFontFromFileTTF(".\\assets\\recharge bd.ttf", 10.0f);
-	if (smallFont == nullptr) {
-		std::cerr << "Failed to load small font" << std::endl;
-		return false;
-	}
+	defaultFont = io.Fonts->Fonts[0];
+	smallFont = io.Fonts->Fonts[1];
 
 	ImGui_ImplGlfw_InitForOpenGL(window, true);
 	ImGui_ImplOpenGL3_Init("#version 130");
 
 	backgroundTexture = LoadTexture(".\\assets\\image.png");
 
-	if (!dataManager.FetchChampionData()) {
+	// Champions and items download over their own connections, so they load side by side.
+	// Every other dataset module loads when first used or by the prefetch below.
+	curl_global_init(CURL_GLOBAL_DEFAULT);
+	std::atomic<bool> championsLoaded{ false };
+	std::atomic<bool> itemsLoaded{ false };
+	dataLoads.Run([&] { championsLoaded = dataManager.LoadModule("champions"); }, TaskPool::Priority::High);
+	dataLoads.Run([&] { itemsLoaded = dataManager.LoadModule("items"); }, TaskPool::Priority::High);
+	dataLoads.Wait();
+	dataManager.Refresh();
+
+	if (!championsLoaded) {
 		std::cerr << "Failed to fetch champion data" << std::endl;
 		return false;
 	}
 
-	if (!dataManager.FetchItemData()) {
+	if (!itemsLoaded) {
 		std::cerr << "Failed to fetch item data" << std::endl;
 		return false;
 	}
@@ -128,6 +194,7 @@ bool GUIManager::Initialize(int width, int height, const char* title) {
 		std::cerr << "Failed to load icon texture" << std::endl;
 	}
 
+	dataManager.PrefetchModules();
 	return true;
 }
 
@@ -146,12 +213,26 @@ void GUIManager::HandleDragging() {
 void GUIManager::Render() {
 	glfwPollEvents();
 
+	// Glyphs asked for during the last frame; the atlas only changes between frames
+	if (!pendingGlyphs.empty()) {
+		AddPendingGlyphs();
+	}
+
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
 	ImGui::NewFrame();
 
     HandleDragging();
 
+	// Data published by loaders since the last frame becomes visible here, so
+	// it never changes under a frame that is being drawn. Continuations run
+	// first: one that reports a load done then sees the data it published.
+	TaskPool::RunMainThreadTasks();
+	dataManager.Refresh();
+	frameArena.Reset();
+	if (dataManager.GetLocale() != shownLocale) {
+		ApplyLocaleChange();
+	}
 
 	RenderBackground();
 	RenderGUI();
@@ -161,6 +242,93 @@ void GUIManager::Render() {
 	glfwSwapBuffers(window);
 }
 
+void GUIManager::CoverText(std::string_view text) {
+	const char* at = text.data();
+	const char* end = at + text.size();
+	while (at < end) {
+		unsigned int c = static_cast<unsigned char>(*at);
+		if (c < 0x80) {
+			++at;
+			continue;
+		}
+		at += ImTextCharFromUtf8(&c, at, end);
+		// Latin-1 is in the base ranges; ImWchar stops at the BMP
+		if (c > 0xFF && c < coveredGlyphs.size() && !coveredGlyphs[c]) {
+			coveredGlyphs[c] = true;
+			pendingGlyphs.push_back(static_cast<ImWchar>(c));
+		}
+	}
+}
+
+void GUIManager::AddPendingGlyphs() {
+	ImGuiIO& io = ImGui::GetIO();
+	auto isCjk = [](ImWchar c) { return c >= 0x2E80; };
+	bool needCjk = std::any_of(pendingGlyphs.begin(), pendingGlyphs.end(), isCjk);
+	if (!glyphCache.Add(io.Fonts, pendingGlyphs, FallbackFontFiles(dataManager.GetLocale(), needCjk))) {
+		// The spare pages are full: bake everything seen so far into a bigger atlas
+		std::vector<ImWchar> covered;
+		for (unsigned int c = 0x100; c < coveredGlyphs.size(); ++c) {
+			if (coveredGlyphs[c]) {
+				covered.push_back(static_cast<ImWchar>(c));
+			}
+		}
+		needCjk = std::any_of(covered.begin(), covered.end(), isCjk);
+		glyphCache.Rebuild(io.Fonts, covered, FallbackFontFiles(dataManager.GetLocale(), needCjk));
+		defaultFont = io.Fonts->Fonts[0];
+		smallFont = io.Fonts->Fonts[1];
+	}
+	pendingGlyphs.clear();
+}
+
+void GUIManager::ApplyLocaleChange() {
+	shownLocale = dataManager.GetLocale();
+	if (const LocaleStrings* strings = dataManager.GetLocaleStrings()) {
+		strings->ForEachText([this](std::string_view text) { CoverText(text); });
+	}
+
+	// Text drawn so far is of the old locale; images are shared and stay
+	richTexts.clear();
+	skillDescriptions.Clear();
+	areChampionDetailsLoaded = false;
+	championDetailsLoading = false;
+	championStats.clear();
+	championLore.clear();
+	championSkins.clear();
+	currentSkinIndex = 0;
+	pendingSkill = selectedSkill;
+	pendingTip.reset();
+	showAllyTip = false;
+	showEnemyTip = false;
+	allyTips.clear();
+	enemyTips.clear();
+	allyTipIndices.clear();
+	enemyTipIndices.clear();
+}
+
+void GUIManager::RenderLocaleSelector() {
+	const auto& locales = DataManager::GetLocales();
+	const std::string& current = dataManager.GetLocale();
+	auto shown = std::find_if(locales.begin(), locales.end(),
+		[&current](const DataManager::Locale& locale) { return current == locale.code; });
+	for (const auto& locale : locales) {
+		CoverText(locale.name);
+	}
+
+	ImGui::SetNextItemWidth(160);
+	if (ImGui::BeginCombo("##Language", shown != locales.end() ? shown->name : current.c_str())) {
+		for (const auto& locale : locales) {
+			if (ImGui::Selectable(locale.name, current == locale.code)) {
+				dataManager.SetLocale(locale.code);
+			}
+		}
+		ImGui::EndCombo();
+	}
+	if (dataManager.IsLocaleLoading()) {
+		ImGui::SameLine();
+		ImGui::TextDisabled("Loading...");
+	}
+}
+
 bool GUIManager::ShouldClose() {
 	return glfwWindowShouldClose(window);
 }
@@ -177,6 +345,7 @@ void GUIManager::Cleanup() {
 	}
 	glfwDestroyWindow(window);
 	glfwTerminate();
+	curl_global_cleanup();
 }
 
 void GUIManager::ApplyCustomStyles() {
@@ -249,7 +418,7 @@ void GUIManager::RenderGUI() {
 	float logoWidth = 32.0f; // Width of your logo
 	float closeButtonsWidth = 60.0f; // Width of close and minimize buttons
 	float mainButtonsWidth = windowWidth - logoWidth - closeButtonsWidth;
-	float sectionWidth = mainButtonsWidth / 3.0f;
+	float sectionWidth = mainButtonsWidth / 4.0f;
 	float separatorThickness = 0.5f; 
 
 	// Logo
@@ -305,6 +474,18 @@ void GUIManager::RenderGUI() {
 	}
 	ImGui::PopStyleColor();
 
+	// Tools button
+	ImGui::SetCursorPos(ImVec2(logoWidth + sectionWidth * 3 + separatorThickness, 0));
+	bool toolsHovered = ImGui::IsMouseHoveringRect(
+		ImGui::GetCursorScreenPos(),
+		ImVec2(ImGui::GetCursorScreenPos().x + sectionWidth - separatorThickness, ImGui::GetCursorScreenPos().y + buttonHeight)
+	);
+	ImGui::PushStyleColor(ImGuiCol_Text, toolsHovered ? hoveredTextColor : normalTextColor);
+	if (ImGui::Button("TOOLS", ImVec2(sectionWidth - separatorThickness, buttonHeight))) {
+		currentState = WindowState::Tools;
+	}
+	ImGui::PopStyleColor();
+
 	ImGui::PopStyleColor(3);
 	ImGui::PopStyleVar();
 
@@ -406,6 +587,9 @@ void GUIManager::RenderGUI() {
 	case WindowState::SummonerSpells:
 		RenderSummonerSpellsWindow();
 		break;
+	case WindowState::Tools:
+		RenderToolsWindow();
+		break;
 	default:
 		RenderDefaultWindow();
 		break;
@@ -414,10 +598,194 @@ void GUIManager::RenderGUI() {
 	ImGui::PopStyleColor();
 	ImGui::EndChild();
 
+	RenderQuickOpen();
+
 	ImGui::End();
 	ImGui::PopStyleVar(3);
 }
 
+void GUIManager::RenderQuickOpen() {
+	ImGuiIO& io = ImGui::GetIO();
+	if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_P, false)) {
+		ImGui::OpenPopup("QuickOpen");
+		quickOpenBuffer[0] = '\0';
+		quickOpenSelection = 0;
+		quickOpenFocus = true;
+	}
+
+	ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(ImVec2(viewport->Pos.x + viewport->Size.x * 0.5f, viewport->Pos.y + 60), ImGuiCond_Always, ImVec2(0.5f, 0.0f));
+	ImGui::SetNextWindowSize(ImVec2(500, 0));
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.1f, 0.1f, 0.1f, 0.95f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(0.4f, 0.4f, 0.4f, 1.0f));
+	if (ImGui::BeginPopup("QuickOpen")) {
+		if (quickOpenFocus) {
+			ImGui::SetKeyboardFocusHere();
+			quickOpenFocus = false;
+		}
+		ImGui::PushItemWidth(-1);
+		if (ImGui::InputTextWithHint("##QuickOpen", "Search champions, items, spells and modes", quickOpenBuffer, IM_ARRAYSIZE(quickOpenBuffer))) {
+			quickOpenSelection = 0;
+		}
+		ImGui::PopItemWidth();
+
+		const auto& searchIndex = dataManager.GetSearchIndex();
+		const auto& results = searchIndex.Query(quickOpenSearch, quickOpenBuffer, SearchIndex::AllKinds, 8);
+		int resultCount = static_cast<int>(results.size());
+
+		// Full-text matches, refreshed while the background index is still filling in
+		std::string query = quickOpenBuffer;
+		size_t indexedDocuments = dataManager.GetTextIndex().DocumentCount();
+		if (query != quickOpenTextQuery || indexedDocuments != quickOpenTextDocuments) {
+			quickOpenTextQuery = query;
+			quickOpenTextDocuments = indexedDocuments;
+			quickOpenTextHits.clear();
+			if (query.size() >= 3) {
+				quickOpenTextHits = dataManager.SearchText(query, 6);
+			}
+		}
+		int hitCount = static_cast<int>(quickOpenTextHits.size());
+		int totalCount = resultCount + hitCount;
+
+		if (ImGui::IsKeyPressed(ImGuiKey_DownArrow)) quickOpenSelection = std::min(quickOpenSelection + 1, totalCount - 1);
+		if (ImGui::IsKeyPressed(ImGuiKey_UpArrow)) quickOpenSelection = std::max(quickOpenSelection - 1, 0);
+		int activated = ImGui::IsKeyPressed(ImGuiKey_Enter) ? quickOpenSelection : -1;
+
+		static const char* kindLabels[] = { "Champion", "Item", "Summoner Spell", "Game Mode" };
+		for (int i = 0; i < resultCount; i++) {
+			const auto& entry = searchIndex.GetEntry(results[i].entry);
+			ImGui::PushID(i);
+			if (ImGui::Selectable(entry.display.c_str(), i == quickOpenSelection)) {
+				activated = i;
+			}
+			ImGui::SameLine(ImGui::GetContentRegionMax().x - 110);
+			ImGui::TextDisabled("%s", kindLabels[static_cast<int>(entry.kind)]);
+			ImGui::PopID();
+		}
+
+		if (hitCount > 0) {
+			ImGui::Separator();
+			ImGui::TextColored(ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f), "Mentioned in");
+		}
+		for (int i = 0; i < hitCount; i++) {
+			const auto& hit = quickOpenTextHits[i];
+			std::string owner = hit.key;
+			if (hit.kind == SearchIndex::EntityKind::Item) {
+				owner = dataManager.GetSpecificItemName(hit.key);
+			}
+			else {
+				std::string title = dataManager.GetChampionNameById(hit.key);
+				if (!title.empty()) owner = title;
+			}
+			std::string label = owner + " - " + hit.label;
+
+			ImGui::PushID(resultCount + i);
+			if (ImGui::Selectable(label.c_str(), resultCount + i == quickOpenSelection)) {
+				activated = resultCount + i;
+			}
+			ImGui::PushFont(smallFont);
+			ImGui::TextDisabled("%s", hit.snippet.c_str());
+			ImGui::PopFont();
+			ImGui::PopID();
+		}
+
+		if (totalCount == 0 && quickOpenBuffer[0] != '\0') {
+			ImGui::TextDisabled("No matches");
+		}
+		size_t pending = dataManager.GetTextIndex().PendingCount();
+		if (pending > 0) {
+			ImGui::TextDisabled("Indexing descriptions... (%zu left)", pending);
+		}
+
+		if (activated >= 0 && activated < resultCount) {
+			OpenSearchResult(searchIndex.GetEntry(results[activated].entry));
+			ImGui::CloseCurrentPopup();
+		}
+		else if (activated >= resultCount && activated < totalCount) {
+			OpenTextHit(quickOpenTextHits[activated - resultCount]);
+			ImGui::CloseCurrentPopup();
+		}
+		ImGui::EndPopup();
+	}
+	ImGui::PopStyleColor(4);
+}
+
+void GUIManager::OpenSearchResult(const SearchIndex::Entry& entry) {
+	switch (entry.kind) {
+	case SearchIndex::EntityKind::Champion:
+		currentState = WindowState::Champions;
+		if (selectedChampionIndex != entry.ordinal) {
+			SelectChampion(entry.ordinal);
+		}
+		break;
+	case SearchIndex::EntityKind::Item:
+		currentState = WindowState::Items;
+		DisplayItem(dataManager.GetItemId(entry.display));
+		break;
+	case SearchIndex::EntityKind::SummonerSpell:
+		// "All Game Modes" lists every spell in load order, so the ordinal is the tile index
+		currentState = WindowState::SummonerSpells;
+		selectedGameModeIndex = 0;
+		selectedSpellIndex = entry.ordinal;
+		break;
+	case SearchIndex::EntityKind::GameMode:
+		currentState = WindowState::SummonerSpells;
+		selectedGameModeIndex = entry.ordinal;
+		selectedSpellIndex = -1;
+		break;
+	default:
+		break;
+	}
+}
+
+void GUIManager::OpenTextHit(const TextIndex::Hit& hit) {
+	if (hit.kind == SearchIndex::EntityKind::Item) {
+		currentState = WindowState::Items;
+		DisplayItem(hit.key);
+		return;
+	}
+
+	const auto& championNames = dataManager.GetChampionNames();
+	for (int i = 0; i < static_cast<int>(championNames.size()); i++) {
+		if (dataManager.GetChampionId(championNames[i]) != hit.key) {
+			continue;
+		}
+		currentState = WindowState::Champions;
+		if (selectedChampionIndex != i) {
+			SelectChampion(i);
+		}
+
+		// Jump to the part of the champion page the text came from
+		static const char* skillKeys[] = { "Q", "W", "E", "R" };
+		if (hit.field == TextIndex::Field::Passive) {
+			pendingSkill = "Passive";
+		}
+		else if (hit.field == TextIndex::Field::Spell && hit.slot < 4) {
+			pendingSkill = hit.key + " " + skillKeys[hit.slot];
+		}
+		else if (hit.field == TextIndex::Field::AllyTip || hit.field == TextIndex::Field::EnemyTip) {
+			ShowChampionTip(hit.field == TextIndex::Field::AllyTip, hit.slot);
+		}
+		break;
+	}
+}
+
+void GUIManager::ShowChampionTip(bool ally, size_t tipIndex) {
+	(ally ? showAllyTip : showEnemyTip) = true;
+	if (!areChampionDetailsLoaded) {
+		// Shown by LoadChampionDetails once the tips are in
+		pendingTip = { ally, tipIndex };
+		return;
+	}
+
+	auto& indices = ally ? allyTipIndices : enemyTipIndices;
+	auto& current = ally ? currentAllyTipIndex : currentEnemyTipIndex;
+	auto it = std::find(indices.begin(), indices.end(), tipIndex);
+	current = (it != indices.end()) ? static_cast<size_t>(it - indices.begin()) : 0;
+}
+
 void GUIManager::RenderDefaultWindow() {
 	ImVec2 textSize = ImGui::CalcTextSize("Select one option above");
 	ImVec2 windowSize = ImGui::GetContentRegionAvail();
@@ -428,6 +796,13 @@ void GUIManager::RenderDefaultWindow() {
 
 	ImGui::SetCursorPos(cursorPos);
 	ImGui::Text("Select one option above");
+
+	const char* hint = "Press Ctrl+P to search everything";
+	ImGui::SetCursorPosX((windowSize.x - ImGui::CalcTextSize(hint).x) * 0.5f);
+	ImGui::TextDisabled("%s", hint);
+
+	ImGui::SetCursorPosX((windowSize.x - 160.0f) * 0.5f);
+	RenderLocaleSelector();
 }
 
 // Champions window functions implementation -------------------------------------------------------------------------------------------------------------------
@@ -474,45 +849,44 @@ void GUIManager::RenderChampionsWindow() {
 		// Add a search input field at the top of the combo box
 		ImGui::PushItemWidth(-1);
 		ImGui::SetCursorPos(ImVec2(10, 10));
-		if (ImGui::InputText("##Search", searchBuffer, IM_ARRAYSIZE(searchBuffer))) {
-			// Convert search to lowercase for case-insensitive comparison
-			std::string search = searchBuffer;
-			std::transform(search.begin(), search.end(), search.begin(), ::tolower);
-		}
+		ImGui::InputText("##Search", searchBuffer, IM_ARRAYSIZE(searchBuffer));
 		ImGui::PopItemWidth();
+
+		// Role filter, champions must have every selected role
+		const auto& championFacets = dataManager.GetChampionFacets();
+		const auto& roles = championFacets.GetValues("Role");
+		auto roleCounts = championFacets.Counts(championFilter, "Role");
+		auto& selectedRoles = championFilter["Role"];
+		selectedRoles.matchAll = true;
+		ImGui::PushFont(smallFont);
+		for (size_t r = 0; r < roles.size(); r++) {
+			if (r > 0) ImGui::SameLine();
+			bool isActive = selectedRoles.values.count(roles[r]) > 0;
+			const char* label = frameArena.Format("%s (%zu)", roles[r].c_str(), roleCounts[r]);
+			if (isActive) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+			if (ImGui::SmallButton(label)) {
+				if (isActive) selectedRoles.values.erase(roles[r]);
+				else selectedRoles.values.insert(roles[r]);
+				championFilterMatches = championFacets.Evaluate(championFilter);
+			}
+			if (isActive) ImGui::PopStyleColor();
+		}
+		ImGui::PopFont();
 		ImGui::Separator();
 
-		for (int i = 0; i < championNames.size(); i++) {
-			// Convert champion name to lowercase for case-insensitive comparison
-			std::string lowerChampName = championNames[i];
-			std::transform(lowerChampName.begin(), lowerChampName.end(), lowerChampName.begin(), ::tolower);
-
-			// Only display champions that match the search
-			if (lowerChampName.find(searchBuffer) != std::string::npos) {
-				bool is_selected = (selectedChampionIndex == i);
-				if (ImGui::Selectable(championNames[i].c_str(), is_selected)) {
-					if (selectedChampionIndex != i) {  // Check if a different champion is selected
-						selectedChampionIndex = i;
-						std::string championId = dataManager.GetChampionId(championNames[i]);
-						LoadChampionSplash(championId);
-						LoadChampionIcon(championId);
-						areSkillIconsLoaded = false;
-						selectedSkill = ""; // Reset selected skill when changing champion
-						skillDescription = ""; // Clear skill description
-						// Reset tip-related states
-						showAllyTip = false;
-						showEnemyTip = false;
-						allyTips.clear();
-						enemyTips.clear();
-						allyTipIndices.clear();
-						enemyTipIndices.clear();
-						currentAllyTipIndex = 0;
-						currentEnemyTipIndex = 0;
-					}
+		bool roleFiltered = !selectedRoles.values.empty();
+		const auto& searchIndex = dataManager.GetSearchIndex();
+		for (const auto& result : searchIndex.Query(championSearch, searchBuffer, SearchIndex::KindBit(SearchIndex::EntityKind::Champion))) {
+			int i = searchIndex.GetEntry(result.entry).ordinal;
+			if (roleFiltered && !championFilterMatches.Test(i)) continue;
+			bool is_selected = (selectedChampionIndex == i);
+			if (ImGui::Selectable(championNames[i].c_str(), is_selected)) {
+				if (selectedChampionIndex != i) {  // Check if a different champion is selected
+					SelectChampion(i);
 				}
-				if (is_selected)
-					ImGui::SetItemDefaultFocus();
 			}
+			if (is_selected)
+				ImGui::SetItemDefaultFocus();
 		}
 		ImGui::EndCombo();
 	}
@@ -533,22 +907,7 @@ void GUIManager::RenderChampionsWindow() {
 	// Load the randomly selected champion
 	if (!isRandomizing.load() && hasRandomChampion.load()) {
 		hasRandomChampion.store(false); // Reset the flag
-
-		std::string championName = championNames[selectedChampionIndex];
-		std::string championId = dataManager.GetChampionId(championName);
-		LoadChampionSplash(championId);
-		LoadChampionIcon(championId);
-		areSkillIconsLoaded = false;
-		selectedSkill = "";
-		skillDescription = "";
-		showAllyTip = false;
-		showEnemyTip = false;
-		allyTips.clear();
-		enemyTips.clear();
-		allyTipIndices.clear();
-		enemyTipIndices.clear();
-		currentAllyTipIndex = 0;
-		currentEnemyTipIndex = 0;
+		SelectChampion(selectedChampionIndex);
 	}
 
 	// Display champion splash art as background
@@ -566,6 +925,13 @@ void GUIManager::RenderChampionsWindow() {
 		std::string championName = championNames[selectedChampionIndex];
 		std::string championId = dataManager.GetChampionId(championName);
 
+		// Stats, lore, abilities, skins and tips all come from the detail
+		// file, fetched off the render thread; until then the panel says so
+		if (!areChampionDetailsLoaded && !championDetailsLoading) {
+			championDetailsLoading = true;
+			LoadChampionDetails(championId).Start(loaders);
+		}
+
 		// Display champion icon
 		if (isChampionIconLoaded) {
 			ImGui::SetCursorPos(ImVec2(10, 50));
@@ -577,9 +943,7 @@ void GUIManager::RenderChampionsWindow() {
 		ImGui::BeginChild("ChampionInfo", ImVec2(300, 500), true, ImGuiWindowFlags_NoScrollbar);
 
 
-		nlohmann::json stats = dataManager.GetChampionStats(championName);
 		std::string title = dataManager.GetChampionTitle(championName);
-		std::string lore = dataManager.GetChampionLore(championName);
 		auto tags = dataManager.GetChampionTags(championName);
 		ImGui::Indent(5.0f);
 		ImGui::Text("Champion: %s", championName.c_str());
@@ -590,14 +954,26 @@ void GUIManager::RenderChampionsWindow() {
 			ImGui::Text("%s", tag.c_str());
 		}
 		ImGui::Text("Base Stats:");
-		ImGui::Text("HP: %.0f (+ %.0f per level)", stats["hp"].get<float>(), stats["hpperlevel"].get<float>());
-		ImGui::Text("Armor: %.1f (+ %.2f per level)", stats["armor"].get<float>(), stats["armorperlevel"].get<float>());
-		ImGui::Text("Magic Resist: %.1f (+ %.2f per level)", stats["spellblock"].get<float>(), stats["spellblockperlevel"].get<float>());
-		ImGui::Text("Move Speed: %.0f", stats["movespeed"].get<float>());
-		ImGui::Text("Attack Damage: %.0f (+ %.0f per level)", stats["attackdamage"].get<float>(), stats["attackdamageperlevel"].get<float>());
-		ImGui::Text("Attack Speed: %.3f (+ %.1f%% per level)", stats["attackspeed"].get<float>(), stats["attackspeedperlevel"].get<float>());
-		ImGui::Text("Attack Range: %.0f", stats["attackrange"].get<float>());
-		ImGui::Text("HP Regen: %.1f (+ %.1f per level)", stats["hpregen"].get<float>(), stats["hpregenperlevel"].get<float>());
+		if (!areChampionDetailsLoaded) {
+			ImGui::TextDisabled("Loading champion details...");
+		}
+		else {
+			auto stat = [this](const char* key) {
+				auto it = championStats.find(key);
+				return it != championStats.end() ? it->second : 0.0f;
+			};
+			ImGui::Text("HP: %.0f (+ %.0f per level)", stat("hp"), stat("hpperlevel"));
+			ImGui::Text("Armor: %.1f (+ %.2f per level)", stat("armor"), stat("armorperlevel"));
+			ImGui::Text("Magic Resist: %.1f (+ %.2f per level)", stat("spellblock"), stat("spellblockperlevel"));
+			ImGui::Text("Move Speed: %.0f", stat("movespeed"));
+			ImGui::Text("Attack Damage: %.0f (+ %.0f per level)", stat("attackdamage"), stat("attackdamageperlevel"));
+			ImGui::Text("Attack Speed: %.3f (+ %.1f%% per level)", stat("attackspeed"), stat("attackspeedperlevel"));
+			ImGui::Text("Attack Range: %.0f", stat("attackrange"));
+			ImGui::Text("HP Regen: %.1f (+ %.1f per level)", stat("hpregen"), stat("hpregenperlevel"));
+		}
+		ImGui::Separator();
+		ImGui::Text("Patch Changes:");
+		RenderPatchChanges(PatchHistory::Kind::Champion, championId);
 		ImGui::Unindent(5.0f);
 		ImGui::EndChild();
 
@@ -606,13 +982,19 @@ void GUIManager::RenderChampionsWindow() {
 		ImGui::BeginChild("ChampionLore", ImVec2(ImGui::GetWindowWidth() - 330, 100), true, ImGuiWindowFlags_HorizontalScrollbar);
 
 		ImGui::Indent(5.0f);
-		ImGui::TextWrapped("%s", lore.c_str());
+		if (areChampionDetailsLoaded) {
+			RenderRichText(frameArena.Format("lore:%s", championId.c_str()), championLore);
+		}
+		else {
+			ImGui::TextDisabled("Loading lore...");
+		}
 		ImGui::Unindent(5.0f);
 		ImGui::EndChild();
 
-		// Load and display skill icons
-		if (!areSkillIconsLoaded) {
-			LoadSkillIcons(championId);
+		if (!pendingSkill.empty() && areChampionDetailsLoaded) {
+			selectedSkill = pendingSkill;
+			skillDescription = SkillDescription(selectedSkill);
+			pendingSkill.clear();
 		}
 
 		// Display skill icons and buttons
@@ -631,21 +1013,22 @@ void GUIManager::RenderChampionsWindow() {
 				ImGui::Image((void*)(intptr_t)skillTextures[i], ImVec2(iconSize, iconSize));
 			}
 
-			std::string buttonLabel = (i == 0) ? "Passive" : skillNames[i] + " Ability";
-			bool isSelected = (selectedSkill == (i == 0 ? "Passive" : championId + " " + skillNames[i]));
+			const char* buttonLabel = (i == 0) ? "Passive" : frameArena.Format("%s Ability", skillNames[i].c_str());
+			std::string_view skillKey = (i == 0) ? "Passive" : frameArena.Format("%s %s", championId.c_str(), skillNames[i].c_str());
+			bool isSelected = selectedSkill == skillKey;
 
 			if (isSelected) {
 				ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
 			}
 
-			if (ImGui::Button(buttonLabel.c_str(), ImVec2(buttonWidth, buttonHeight))) {
+			if (ImGui::Button(buttonLabel, ImVec2(buttonWidth, buttonHeight))) {
 				if (isSelected) {
 					selectedSkill = "";
 					skillDescription = "";
 				}
 				else {
-					selectedSkill = (i == 0) ? "Passive" : championId + " " + skillNames[i];
-					skillDescription = skillDescriptions[selectedSkill];
+					selectedSkill = skillKey;
+					skillDescription = SkillDescription(selectedSkill);
 				}
 			}
 
@@ -661,7 +1044,7 @@ void GUIManager::RenderChampionsWindow() {
 			ImGui::SetCursorPos(ImVec2(320, 360)); // Adjusted position
 			ImGui::BeginChild("SkillDescription", ImVec2(ImGui::GetWindowWidth() - 330, 70), true, ImGuiWindowFlags_HorizontalScrollbar);
 			ImGui::Indent(5.0f);
-			ImGui::TextWrapped("%s", skillDescription.c_str());
+			RenderRichText(frameArena.Format("skill:%s:%s", championId.c_str(), selectedSkill.c_str()), skillDescription);
 			ImGui::Unindent(5.0f);
 			ImGui::EndChild();
 		}
@@ -677,22 +1060,28 @@ void GUIManager::RenderChampionsWindow() {
 
 		// Display skins if showSkins is true
 		if (showSkins) {
-			auto skins = dataManager.GetChampionSkins(championName);
-			if (!skins.empty()) {
-				const auto& currentSkin = skins[currentSkinIndex];
-				std::string skinName = currentSkin["name"];
-				std::string skinNum = std::to_string(currentSkin["num"].get<int>());
-				std::string skinKey = championId + "_" + skinNum;
+			if (!championSkins.empty()) {
+				const ChampionSkin& currentSkin = championSkins[currentSkinIndex];
+				const std::string& skinName = currentSkin.name;
+				int skinNum = currentSkin.num;
+				std::string_view skinKey = frameArena.Format("%s_%d", championId.c_str(), skinNum);
 
 				// Load skin texture if not already loaded
-				if (skinTextures.find(skinKey) == skinTextures.end()) {
-					std::string skinImageUrl = dataManager.GetChampionSkinImageUrl(championId, skinNum);
-					skinTextures[skinKey] = LoadSkinTexture(skinImageUrl);
+				Symbol skinSymbol = Symbols::Intern(skinKey);
+				const GLuint* skinTexture = skinTextures.Find(skinSymbol);
+				if (!skinTexture) {
+					LoadSkinTexture(skinSymbol, dataManager.GetChampionSkinImageUrl(championId, std::to_string(skinNum))).Start(loaders);
+					skinTexture = skinTextures.Find(skinSymbol);
 				}
 
-				// Display skin image
+				// Display skin image, or keep its place until it arrives
 				ImGui::SetCursorPos(ImVec2(390, 440)); // Adjust position as needed
-				ImGui::Image((void*)(intptr_t)skinTextures[skinKey], ImVec2(240, 136)); // Adjust size as needed
+				if (*skinTexture != 0) {
+					ImGui::Image((void*)(intptr_t)*skinTexture, ImVec2(240, 136)); // Adjust size as needed
+				}
+				else {
+					ImGui::Dummy(ImVec2(240, 136));
+				}
 
 				// Display skin name in a chat box style
 				ImGui::SetCursorPos(ImVec2(390, 580)); // Adjusted position
@@ -712,7 +1101,7 @@ void GUIManager::RenderChampionsWindow() {
 				}
 
 				ImGui::SetCursorPos(ImVec2(595, 625)); // Adjusted position for right arrow
-				if (currentSkinIndex < skins.size() - 1) {
+				if (currentSkinIndex < championSkins.size() - 1) {
 					if (ImGui::ArrowButton("##right", ImGuiDir_Right)) {
 						currentSkinIndex++;
 					}
@@ -724,13 +1113,6 @@ void GUIManager::RenderChampionsWindow() {
 		ImGui::SetCursorPos(ImVec2(650, 440));
 		if (ImGui::Button("Ally Tips")) {
 			showAllyTip = !showAllyTip;
-			if (showAllyTip && allyTips.empty()) {
-				allyTips = dataManager.GetChampionAllyTips(championName);
-				if (!allyTips.empty()) {
-					RandomizeTips(allyTips, allyTipIndices);
-					currentAllyTipIndex = 0;
-				}
-			}
 		}
 
 		if (showAllyTip) {
@@ -746,7 +1128,10 @@ void GUIManager::RenderChampionsWindow() {
 			ImGui::Indent(5.0f);
 			if (!allyTips.empty()) {
 				size_t index = allyTipIndices[currentAllyTipIndex];
-				ImGui::TextWrapped("%s", allyTips[index].c_str());
+				RenderRichText(frameArena.Format("allytip:%s:%zu", championName.c_str(), index), allyTips[index]);
+			}
+			else if (!areChampionDetailsLoaded) {
+				ImGui::TextDisabled("Loading tips...");
 			}
 			else {
 				ImGui::TextWrapped("No ally tips available for this champion.");
@@ -759,13 +1144,6 @@ void GUIManager::RenderChampionsWindow() {
 		ImGui::SetCursorPos(ImVec2(650, 535));
 		if (ImGui::Button("Enemy Tips")) {
 			showEnemyTip = !showEnemyTip;
-			if (showEnemyTip && enemyTips.empty()) {
-				enemyTips = dataManager.GetChampionEnemyTips(championName);
-				if (!enemyTips.empty()) {
-					RandomizeTips(enemyTips, enemyTipIndices);
-					currentEnemyTipIndex = 0;
-				}
-			}
 		}
 
 		if (showEnemyTip) {
@@ -781,7 +1159,10 @@ void GUIManager::RenderChampionsWindow() {
 			ImGui::Indent(5.0f);
 			if (!enemyTips.empty()) {
 				size_t index = enemyTipIndices[currentEnemyTipIndex];
-				ImGui::TextWrapped("%s", enemyTips[index].c_str());
+				RenderRichText(frameArena.Format("enemytip:%s:%zu", championName.c_str(), index), enemyTips[index]);
+			}
+			else if (!areChampionDetailsLoaded) {
+				ImGui::TextDisabled("Loading tips...");
 			}
 			else {
 				ImGui::TextWrapped("No enemy tips available for this champion.");
@@ -792,86 +1173,154 @@ void GUIManager::RenderChampionsWindow() {
 	}
 }
 
-void GUIManager::CleanupSkinTextures() {
-	for (auto& pair : skinTextures) {
-		glDeleteTextures(1, &pair.second);
+void GUIManager::SelectChampion(int index) {
+	const auto& championNames = dataManager.GetChampionNames();
+	if (index < 0 || index >= static_cast<int>(championNames.size())) {
+		return;
 	}
-	skinTextures.clear();
+
+	selectedChampionIndex = index;
+	std::string championId = dataManager.GetChampionId(championNames[index]);
+	LoadChampionSplash(championId).Start(loaders);
+	LoadChampionIcon(championId).Start(loaders);
+	areChampionDetailsLoaded = false;
+	championDetailsLoading = false;
+	championStats.clear();
+	championLore.clear();
+	championSkins.clear();
+	currentSkinIndex = 0;
+	selectedSkill = ""; // Reset selected skill when changing champion
+	pendingSkill.clear();
+	pendingTip.reset();
+	skillDescription = ""; // Clear skill description
+	// Reset tip-related states
+	showAllyTip = false;
+	showEnemyTip = false;
+	allyTips.clear();
+	enemyTips.clear();
+	allyTipIndices.clear();
+	enemyTipIndices.clear();
+	currentAllyTipIndex = 0;
+	currentEnemyTipIndex = 0;
 }
 
-void GUIManager::LoadChampionSplash(const std::string& championName) {
-	CURL* curl = curl_easy_init();
-	if (curl) {
-		std::string url = dataManager.GetChampionImageUrl(championName);
-		std::string imageData;
-
-		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &imageData);
-
-		CURLcode res = curl_easy_perform(curl);
-		curl_easy_cleanup(curl);
-
-		if (res == CURLE_OK) {
-			int width, height, channels;
-			unsigned char* image = stbi_load_from_memory(
-				reinterpret_cast<const unsigned char*>(imageData.data()),
-				imageData.size(), &width, &height, &channels, 4);
-
-			if (image) {
-				if (isChampionSplashLoaded) {
-					glDeleteTextures(1, &championSplashTexture);
-				}
+void GUIManager::CleanupSkinTextures() {
+	skinTextures.ForEach([](Symbol, GLuint& texture) {
+		glDeleteTextures(1, &texture);
+	});
+	skinTextures.Clear();
+}
 
-				glGenTextures(1, &championSplashTexture);
-				glBindTexture(GL_TEXTURE_2D, championSplashTexture);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+AsyncJob GUIManager::LoadChampionSplash(std::string championName) {
+	int requested = selectedChampionIndex;
+	GLuint texture = co_await LoadTextureAsync(dataManager.GetChampionImageUrl(championName));
+	// Dropped if another champion was picked while it loaded
+	if (texture == 0 || requested != selectedChampionIndex) {
+		glDeleteTextures(1, &texture);
+		co_return;
+	}
+	if (isChampionSplashLoaded) {
+		glDeleteTextures(1, &championSplashTexture);
+	}
+	championSplashTexture = texture;
+	isChampionSplashLoaded = true;
+}
 
-				stbi_image_free(image);
-				isChampionSplashLoaded = true;
-			}
+AsyncJob GUIManager::LoadChampionIcon(std::string championName) {
+	std::vector<uint8_t> pixels;
+	int size = 0;
+	if (dataManager.GetBundledIcon("champion/" + dataManager.GetChampionId(championName), pixels, size)) {
+		if (isChampionIconLoaded) {
+			glDeleteTextures(1, &championIconTexture);
 		}
+		championIconTexture = CreateIconTexture(pixels, size);
+		isChampionIconLoaded = true;
+		co_return;
 	}
-}
 
-void GUIManager::LoadChampionIcon(const std::string& championName) {
 	// Similar to LoadChampionSplash, but for the icon
+	int requested = selectedChampionIndex;
+	GLuint texture = co_await LoadTextureAsync(dataManager.GetChampionIconUrl(championName));
+	if (texture == 0 || requested != selectedChampionIndex) {
+		glDeleteTextures(1, &texture);
+		co_return;
+	}
+	if (isChampionIconLoaded) {
+		glDeleteTextures(1, &championIconTexture);
+	}
+	championIconTexture = texture;
+	isChampionIconLoaded = true;
+}
+
+// From the image cache when the entity did not change this patch, else downloaded and cached
+bool GUIManager::DownloadImage(const std::string& url, std::string& imageData) {
+	if (dataManager.ReadCachedImage(url, imageData)) {
+		return true;
+	}
+
 	CURL* curl = curl_easy_init();
-	if (curl) {
-		std::string url = dataManager.GetChampionIconUrl(championName);  // You'll need to add this function to DataManager
-		std::string imageData;
-
-		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &imageData);
-
-		CURLcode res = curl_easy_perform(curl);
-		curl_easy_cleanup(curl);
-
-		if (res == CURLE_OK) {
-			int width, height, channels;
-			unsigned char* image = stbi_load_from_memory(
-				reinterpret_cast<const unsigned char*>(imageData.data()),
-				imageData.size(), &width, &height, &channels, 4);
-
-			if (image) {
-				if (isChampionIconLoaded) {
-					glDeleteTextures(1, &championIconTexture);
-				}
+	if (!curl) {
+		return false;
+	}
+	imageData.clear();
+	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &imageData);
 
-				glGenTextures(1, &championIconTexture);
-				glBindTexture(GL_TEXTURE_2D, championIconTexture);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+	CURLcode res = curl_easy_perform(curl);
+	long status = 0;
+	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+	curl_easy_cleanup(curl);
 
-				stbi_image_free(image);
-				isChampionIconLoaded = true;
-			}
-		}
+	if (res != CURLE_OK || status != 200) {
+		return false;
+	}
+	dataManager.StoreCachedImage(url, imageData);
+	return true;
+}
+
+AsyncTask<std::string> GUIManager::FetchImage(std::string url) {
+	co_await ResumeOn(TaskPool::Io(), TaskPool::Priority::High);
+	std::string imageData;
+	if (!DownloadImage(url, imageData)) {
+		std::cerr << "Failed to download image: " << url << std::endl;
+		imageData.clear();
+	}
+	co_return imageData;
+}
+
+AsyncTask<GUIManager::DecodedImage> GUIManager::DecodeImage(std::string bytes) {
+	DecodedImage image;
+	if (bytes.empty()) {
+		co_return image;
+	}
+	co_await ResumeOn(TaskPool::Shared(), TaskPool::Priority::High);
+	int channels = 0;
+	image.pixels.reset(stbi_load_from_memory(
+		reinterpret_cast<const unsigned char*>(bytes.data()),
+		static_cast<int>(bytes.size()), &image.width, &image.height, &channels, 4), stbi_image_free);
+	co_return image;
+}
+
+AsyncTask<GLuint> GUIManager::LoadTextureAsync(std::string url) {
+	std::string bytes = co_await FetchImage(url);
+	DecodedImage image = co_await DecodeImage(std::move(bytes));
+	// GL calls only work on the thread that owns the context
+	co_await ResumeOnMainThread();
+	if (!image.pixels || loaders.IsCancelled()) {
+		co_return 0;
 	}
+	co_return CreateTexture(image.pixels.get(), image.width, image.height);
+}
+
+GLuint GUIManager::CreateTexture(const unsigned char* pixels, int width, int height) {
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	return texture;
 }
 
 size_t GUIManager::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
@@ -902,99 +1351,111 @@ bool GUIManager::LoadIconTexture(const char* filename) {
 	return true;
 }
 
-void GUIManager::LoadSkillIcons(const std::string& championId) {
-	auto spells = dataManager.GetChampionSpells(championId);
-	auto passive = dataManager.GetChampionPassive(championId);
+AsyncJob GUIManager::LoadChampionDetails(std::string championId) {
+	int requested = selectedChampionIndex;
+	std::string locale = shownLocale;
+	auto details = co_await dataManager.FetchChampionDetailsAsync(championId);
+	co_await ResumeOnMainThread();
+	// Dropped if another champion or locale was picked while it loaded
+	if (loaders.IsCancelled() || requested != selectedChampionIndex || locale != shownLocale) {
+		co_return;
+	}
+	// Not retried every frame; picking the champion again retries
+	championDetailsLoading = false;
+	areChampionDetailsLoaded = true;
+	if (!details) {
+		co_return;
+	}
+	// Lore, abilities, skins and tips of this champion in the current locale
+	CoverText(details->dump());
+
+	// Everything the panel shows is read here once, so a missing or
+	// mistyped field leaves a blank instead of throwing mid-frame
+	nlohmann::json champion = details->value(nlohmann::json::json_pointer("/data/" + championId), nlohmann::json());
+	auto stats = champion.find("stats");
+	if (stats != champion.end() && stats->is_object()) {
+		for (const auto& [key, value] : stats->items()) {
+			if (value.is_number()) {
+				championStats[key] = value.get<float>();
+			}
+		}
+	}
+	auto lore = champion.find("lore");
+	if (lore != champion.end() && lore->is_string()) {
+		championLore = lore->get<std::string>();
+	}
+	auto skins = champion.find("skins");
+	if (skins != champion.end() && skins->is_array()) {
+		for (const auto& skin : *skins) {
+			auto name = skin.find("name");
+			auto num = skin.find("num");
+			if (name != skin.end() && name->is_string() && num != skin.end() && num->is_number_integer()) {
+				championSkins.push_back({ name->get<std::string>(), num->get<int>() });
+			}
+		}
+	}
+	allyTips = DetailStrings(champion, "allytips");
+	enemyTips = DetailStrings(champion, "enemytips");
+	RandomizeTips(allyTips, allyTipIndices);
+	RandomizeTips(enemyTips, enemyTipIndices);
+	currentAllyTipIndex = 0;
+	currentEnemyTipIndex = 0;
+	if (pendingTip) {
+		ShowChampionTip(pendingTip->first, pendingTip->second);
+		pendingTip.reset();
+	}
+
+	auto spells = champion.find("spells");
+	auto passive = champion.find("passive");
+	if (spells == champion.end() || !spells->is_array() || passive == champion.end() || !passive->is_object()) {
+		co_return;
+	}
 
 	// Load passive icon and description
-	LoadSkillIcon(passive["image"]["full"], 0);
-	skillDescriptions["Passive"] = passive["name"].get<std::string>() + ": " + passive["description"].get<std::string>();
+	LoadSkillIcon(DetailString(*passive, "/image/full"), 0).Start(loaders);
+	skillDescriptions[Symbols::Intern("Passive")] = "<spellName>" + DetailString(*passive, "/name") + ":</spellName> " + DetailString(*passive, "/description");
 
 	// Load skill icons and descriptions
 	std::string skillNames[] = { "Q", "W", "E", "R" };
-	for (int i = 0; i < spells.size() && i < 4; ++i) {
-		LoadSkillIcon(spells[i]["image"]["full"], i + 1);
-		skillDescriptions[championId + " " + skillNames[i]] =
-			spells[i]["name"].get<std::string>() + ": " + spells[i]["description"].get<std::string>();
+	for (int i = 0; i < spells->size() && i < 4; ++i) {
+		const auto& spell = (*spells)[i];
+		LoadSkillIcon(DetailString(spell, "/image/full"), i + 1).Start(loaders);
+		skillDescriptions[Symbols::Intern(championId + " " + skillNames[i])] =
+			"<spellName>" + DetailString(spell, "/name") + ":</spellName> " + DetailString(spell, "/description");
 	}
-
-	areSkillIconsLoaded = true;
 }
 
-void GUIManager::LoadSkillIcon(const std::string& iconFilename, int index) {
-	CURL* curl = curl_easy_init();
-	if (curl) {
-		std::string url = "http://ddragon.leagueoflegends.com/cdn/14.14.1/img/passive/" + iconFilename;
-		if (index > 0) {
-			url = "http://ddragon.leagueoflegends.com/cdn/14.14.1/img/spell/" + iconFilename;
-		}
-		std::string imageData;
-
-		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &imageData);
-
-		CURLcode res = curl_easy_perform(curl);
-		curl_easy_cleanup(curl);
-
-		if (res == CURLE_OK) {
-			int width, height, channels;
-			unsigned char* image = stbi_load_from_memory(
-				reinterpret_cast<const unsigned char*>(imageData.data()),
-				imageData.size(), &width, &height, &channels, 4);
-
-			if (image) {
-				if (skillTextures[index] != 0) {
-					glDeleteTextures(1, &skillTextures[index]);
-				}
-
-				glGenTextures(1, &skillTextures[index]);
-				glBindTexture(GL_TEXTURE_2D, skillTextures[index]);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-
-				stbi_image_free(image);
-			}
-		}
+AsyncJob GUIManager::LoadSkillIcon(std::string iconFilename, int index) {
+	std::string url = dataManager.GetDataDragonUrl((index > 0 ? "img/spell/" : "img/passive/") + iconFilename);
+	int requested = selectedChampionIndex;
+	GLuint texture = co_await LoadTextureAsync(url);
+	if (texture == 0 || requested != selectedChampionIndex) {
+		glDeleteTextures(1, &texture);
+		co_return;
+	}
+	if (skillTextures[index] != 0) {
+		glDeleteTextures(1, &skillTextures[index]);
 	}
+	skillTextures[index] = texture;
 }
 
-GLuint GUIManager::LoadSkinTexture(const std::string& url) {
-	CURL* curl = curl_easy_init();
-	GLuint texture = 0;
-	if (curl) {
-		std::string imageData;
-		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &imageData);
-
-		CURLcode res = curl_easy_perform(curl);
-		curl_easy_cleanup(curl);
-
-		if (res == CURLE_OK) {
-			int width, height, channels;
-			unsigned char* image = stbi_load_from_memory(
-				reinterpret_cast<const unsigned char*>(imageData.data()),
-				imageData.size(), &width, &height, &channels, 4);
-
-			if (image) {
-				glGenTextures(1, &texture);
-				glBindTexture(GL_TEXTURE_2D, texture);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-				stbi_image_free(image);
-			}
-			else {
-				std::cerr << "Failed to load skin image: " << url << std::endl;
-			}
-		}
-		else {
-			std::cerr << "Failed to download skin image: " << url << std::endl;
-		}
+AsyncJob GUIManager::LoadSkinTexture(Symbol skinKey, std::string url) {
+	// The entry keeps the skin from being requested again while it loads
+	skinTextures[skinKey] = 0;
+	GLuint texture = co_await LoadTextureAsync(url);
+	GLuint* entry = skinTextures.Find(skinKey);
+	if (!entry) {
+		// Cleared by a champion change
+		glDeleteTextures(1, &texture);
+		co_return;
 	}
-	return texture;
+	*entry = texture;
+}
+
+const std::string& GUIManager::SkillDescription(std::string_view skillKey) const {
+	static const std::string none;
+	const std::string* description = skillDescriptions.Find(Symbols::Find(skillKey));
+	return description ? *description : none;
 }
 
 void GUIManager::RandomizeTips(const std::vector<std::string>& tips, std::vector<size_t>& indices) {
@@ -1012,29 +1473,25 @@ void GUIManager::RandomizeTips(const std::vector<std::string>& tips, std::vector
 void GUIManager::RandomizeChampion() {
 	if (isRandomizing.load()) return; // Don't start a new randomization if one is in progress
 
+	size_t championCount = dataManager.GetChampionNames().size();
+	if (championCount == 0) return;
+
 	isRandomizing.store(true);
 	hasRandomChampion.store(false);
-	const auto& championNames = dataManager.GetChampionNames();
-
-	randomizationThread = std::thread([this, championNames]() {
-		std::vector<size_t> indices(championNames.size());
-		std::iota(indices.begin(), indices.end(), 0);
 
+	uiTasks.Run([this, championCount]() {
 		std::random_device rd;
 		std::mt19937 g(rd());
-		std::shuffle(indices.begin(), indices.end(), g);
+		std::uniform_int_distribution<size_t> pick(0, championCount - 1);
+		int index = static_cast<int>(pick(g));
 
 		// Select a single random champion
-		{
-			std::lock_guard<std::mutex> lock(tipMutex);
-			selectedChampionIndex = indices[0];
-		}
-
-		isRandomizing.store(false);
-		hasRandomChampion.store(true);
+		TaskPool::PostToMain([this, index] {
+			selectedChampionIndex = index;
+			isRandomizing.store(false);
+			hasRandomChampion.store(true);
 		});
-
-	randomizationThread.detach(); // Allow the thread to run independently
+	});
 }
 
 // Item window functions implementation -------------------------------------------------------------------------------------------------------------------------
@@ -1070,24 +1527,19 @@ void GUIManager::RenderItemsWindow() {
 		ImGui::PopItemWidth();
 		ImGui::Separator();
 
-		for (int i = 0; i < itemNames.size(); i++) {
-			std::string lowerItemName = itemNames[i];
-			std::transform(lowerItemName.begin(), lowerItemName.end(), lowerItemName.begin(), ::tolower);
-			std::string search = searchBuffer;
-			std::transform(search.begin(), search.end(), search.begin(), ::tolower);
-
-			if (lowerItemName.find(search) != std::string::npos) {
-				bool is_selected = (comboSelectedIndex == i);
-				if (ImGui::Selectable(itemNames[i].c_str(), is_selected)) {
-					if (comboSelectedIndex != i) {
-						comboSelectedIndex = i;
-						std::string itemId = dataManager.GetItemId(itemNames[i]);
-						DisplayItem(itemId);
-						selectedItemIndex = 0;
-					}
+		const auto& searchIndex = dataManager.GetSearchIndex();
+		for (const auto& result : searchIndex.Query(itemSearch, searchBuffer, SearchIndex::KindBit(SearchIndex::EntityKind::Item))) {
+			int i = searchIndex.GetEntry(result.entry).ordinal;
+			bool is_selected = (comboSelectedIndex == i);
+			if (ImGui::Selectable(itemNames[i].c_str(), is_selected)) {
+				if (comboSelectedIndex != i) {
+					comboSelectedIndex = i;
+					std::string itemId = dataManager.GetItemId(itemNames[i]);
+					DisplayItem(itemId);
+					selectedItemIndex = 0;
 				}
-				if (is_selected) ImGui::SetItemDefaultFocus();
 			}
+			if (is_selected) ImGui::SetItemDefaultFocus();
 		}
 		ImGui::EndCombo();
 	}
@@ -1131,6 +1583,26 @@ void GUIManager::RenderItemsWindow() {
 		}
 		if (isActiveTag) ImGui::PopStyleColor();
 	}
+	ImGui::SameLine();
+	bool isFiltering = std::any_of(itemFilter.begin(), itemFilter.end(),
+		[](const auto& entry) { return !entry.second.values.empty(); });
+	if (isFiltering) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	if (ImGui::Button("Filters", ImVec2(0, buttonHeight))) {
+		ImGui::OpenPopup("ItemFilters");
+	}
+	if (isFiltering) ImGui::PopStyleColor();
+	RenderItemFilters();
+	ImGui::SameLine();
+	if (showItemTable) ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	if (ImGui::Button("Table", ImVec2(0, buttonHeight))) {
+		showItemTable = !showItemTable;
+	}
+	if (showItemTable) ImGui::PopStyleColor();
+	ImGui::SameLine();
+	if (ImGui::Button("Patch Diff", ImVec2(0, buttonHeight))) {
+		ImGui::OpenPopup("ItemPatchDiff");
+	}
+	RenderItemPatchDiff();
 
 	// Display items only if a tag is selected or items are being displayed
 	if (!currentItems.empty() || !currentTag.empty()) {
@@ -1138,7 +1610,10 @@ void GUIManager::RenderItemsWindow() {
 		ImGui::BeginChild("ItemsList", ImVec2(ImGui::GetWindowWidth() - 50, 300), true);
 		ImGui::Indent(2.5f);
 		int itemsPerRow = 13;
-		for (int i = 0; i < currentItems.size(); i++) {
+		if (showItemTable) {
+			RenderItemTable();
+		}
+		else for (int i = 0; i < currentItems.size(); i++) {
 			const auto& itemId = currentItems[i];
 			std::string itemName = dataManager.GetSpecificItemName(itemId);
 			std::string itemIconUrl = dataManager.GetItemImageUrl(itemId);
@@ -1169,6 +1644,7 @@ void GUIManager::RenderItemsWindow() {
 	if (!currentItems.empty() && selectedItemIndex >= 0 && selectedItemIndex < currentItems.size()) {
 		std::string itemId = currentItems[selectedItemIndex];
 		currentItemTags = dataManager.GetItemTags(itemId);
+		int ordinal = dataManager.GetItemOrdinal(itemId);
 
 		float columnWidth = (ImGui::GetWindowWidth() - 50) / 2;
 		ImVec2 statsWindowPos = ImGui::GetCursorPos();
@@ -1178,9 +1654,13 @@ void GUIManager::RenderItemsWindow() {
 		ImGui::BeginChild("ItemDetails", ImVec2(columnWidth - 10, 200), true);
 		ImGui::Indent(5.0f);
 		ImGui::Text("Name: %s", dataManager.GetSpecificItemName(itemId).c_str());
-		ImGui::Text("Description: %s", dataManager.GetItemDescription(itemId).c_str());
+		RenderRichText("item:" + itemId, "Description: " + dataManager.GetItemDescription(itemId));
 		int cost = dataManager.GetItemCost(itemId);
 		if (cost >= 0) ImGui::Text("Cost: %d", cost);
+		const GoldEfficiency::Result* efficiency = dataManager.GetGoldEfficiency();
+		if (efficiency && ordinal >= 0 && efficiency->efficiency[ordinal] > 0.0f) {
+			ImGui::Text("Gold value: %.0f (%.1f%% efficient)", efficiency->value[ordinal], efficiency->efficiency[ordinal]);
+		}
 
 		auto stats = dataManager.GetItemStats(itemId);
 		if (!stats.empty()) {
@@ -1198,8 +1678,10 @@ void GUIManager::RenderItemsWindow() {
 		auto itemData = dataManager.GetItemData(itemId);
 		if (itemData.contains("active") && !itemData["active"].empty()) {
 			ImGui::Text("Active Ability:");
-			for (const auto& active : itemData["active"]) {
-				ImGui::TextWrapped("  %s: %s", active["name"].get<std::string>().c_str(), active["effects"].get<std::string>().c_str());
+			for (size_t i = 0; i < itemData["active"].size(); i++) {
+				const auto& active = itemData["active"][i];
+				RenderRichText("itemactive:" + itemId + ":" + std::to_string(i),
+					"  <active>" + active["name"].get<std::string>() + ":</active> " + active["effects"].get<std::string>());
 				if (active.contains("cooldown") && !active["cooldown"].is_null()) {
 					ImGui::Text("  Cooldown: %s", active["cooldown"].get<std::string>().c_str());
 				}
@@ -1208,29 +1690,50 @@ void GUIManager::RenderItemsWindow() {
 		ImGui::Unindent(5.0f);
 		ImGui::EndChild();
 
-		// Builds Into column
+		// Recipe column: direct upgrades, the full recipe tree and every upgrade path
 		ImGui::SetCursorPos(ImVec2(25 + columnWidth, statsWindowPos.y));
 		ImGui::BeginChild("BuildsInto", ImVec2(columnWidth - 10, 200), true);
 		ImGui::Indent(5.0f);
-		ImGui::Text("Builds Into:");
-		std::vector<std::string> buildsInto = dataManager.GetItemBuildsInto(itemId);
-		if (!buildsInto.empty()) {
-			for (const auto& buildItemId : buildsInto) {
-				if (dataManager.ItemExists(buildItemId)) {
-					std::string buildItemName = dataManager.GetSpecificItemName(buildItemId);
-					std::string buildItemIconUrl = dataManager.GetItemImageUrl(buildItemId);
-					GLuint buildItemTexture = LoadTextureFromURL(buildItemIconUrl);
-					if (ImGui::ImageButton((void*)(intptr_t)buildItemTexture, ImVec2(32, 32))) {
-						DisplayItem(buildItemId);
-					}
-					ImGui::SameLine();
-					ImGui::Text("%s", buildItemName.c_str());
+		const auto& recipeGraph = dataManager.GetRecipeGraph();
+		if (ordinal >= 0 && ImGui::BeginTabBar("RecipeTabs")) {
+			if (ImGui::BeginTabItem("Builds Into")) {
+				auto buildsInto = recipeGraph.BuildsInto(ordinal);
+				if (buildsInto.empty()) {
+					ImGui::Text("This item doesn't build into anything.");
+				}
+				for (uint32_t parent : buildsInto) {
+					RenderItemLink(parent, 32.0f);
 					ImGui::Separator();
 				}
+				ImGui::EndTabItem();
 			}
-		}
-		else {
-			ImGui::Text("This item doesn't build into anything.");
+			if (ImGui::BeginTabItem("Recipe")) {
+				ImGui::Text("Depth: %d  Combine: %d  Tree cost: %d",
+					recipeGraph.Depth(ordinal), recipeGraph.CombineCost(ordinal), recipeGraph.TreeCost(ordinal));
+				ImGui::Separator();
+				if (recipeGraph.Components(ordinal).empty()) {
+					ImGui::Text("This is a basic item.");
+				}
+				else {
+					RenderRecipeTree(ordinal);
+				}
+				ImGui::EndTabItem();
+			}
+			if (ImGui::BeginTabItem("Patch Changes")) {
+				RenderPatchChanges(PatchHistory::Kind::Item, itemId);
+				ImGui::EndTabItem();
+			}
+			if (ImGui::BeginTabItem("All Upgrades")) {
+				auto upgrades = recipeGraph.Upgrades(ordinal);
+				if (upgrades.empty()) {
+					ImGui::Text("This item doesn't build into anything.");
+				}
+				for (uint32_t upgrade : upgrades) {
+					RenderItemLink(upgrade, 24.0f);
+				}
+				ImGui::EndTabItem();
+			}
+			ImGui::EndTabBar();
 		}
 		ImGui::Unindent(5.0f);
 		ImGui::EndChild();
@@ -1251,6 +1754,48 @@ void GUIManager::RenderItemsWindow() {
 	}
 }
 
+void GUIManager::RenderItemLink(uint32_t ordinal, float iconSize) {
+	const std::string& linkedId = dataManager.GetItemIdAt(ordinal);
+	GLuint texture = LoadTextureFromURL(dataManager.GetItemImageUrl(linkedId));
+	ImGui::PushID(static_cast<int>(ordinal));
+	if (ImGui::ImageButton((void*)(intptr_t)texture, ImVec2(iconSize, iconSize))) {
+		DisplayItem(linkedId);
+	}
+	ImGui::PopID();
+	ImGui::SameLine();
+	ImGui::Text("%s", dataManager.GetSpecificItemName(linkedId).c_str());
+}
+
+void GUIManager::RenderRecipeTree(uint32_t ordinal) {
+	// Children are only submitted while their node is open, so large trees cost nothing until expanded
+	const auto& recipeGraph = dataManager.GetRecipeGraph();
+	auto components = recipeGraph.Components(ordinal);
+	for (size_t i = 0; i < components.size(); i++) {
+		uint32_t component = components[i];
+		const std::string& componentId = dataManager.GetItemIdAt(component);
+		bool isLeaf = recipeGraph.Components(component).empty();
+
+		ImGui::PushID(static_cast<int>(i));
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth;
+		if (isLeaf) flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		GLuint texture = LoadTextureFromURL(dataManager.GetItemImageUrl(componentId));
+		bool isOpen = ImGui::TreeNodeEx("##node", flags);
+		ImGui::SameLine();
+		ImGui::Image((void*)(intptr_t)texture, ImVec2(18, 18));
+		ImGui::SameLine();
+		if (ImGui::SmallButton(dataManager.GetSpecificItemName(componentId).c_str())) {
+			DisplayItem(componentId);
+		}
+		ImGui::SameLine();
+		ImGui::TextDisabled("%d gold", dataManager.GetItemCost(componentId));
+		if (isOpen && !isLeaf) {
+			RenderRecipeTree(component);
+			ImGui::TreePop();
+		}
+		ImGui::PopID();
+	}
+}
+
 void GUIManager::RenderItemsDetail() {
 	static std::string selectedTag = "DefaultTag"; // Set a default tag
 	static std::vector<std::string> tags = { "FIGHTER", "MARKSMAN", "ASSASSIN", "MAGE", "TANK", "SUPPORT" };
@@ -1280,49 +1825,309 @@ void GUIManager::RenderItemsDetail() {
 	}
 }
 
+// One line per change, buffs in green and nerfs in red
+void GUIManager::RenderPatchChange(PatchHistory::Kind kind, const PatchHistory::Change& change, const char* prefix) {
+	const auto& history = dataManager.GetPatchHistory();
+	int verdict = PatchHistory::Verdict(kind, change);
+	if (verdict != 0) {
+		ImGui::PushStyleColor(ImGuiCol_Text, verdict > 0 ? ImVec4(0.45f, 0.85f, 0.45f, 1.0f) : ImVec4(0.9f, 0.4f, 0.4f, 1.0f));
+	}
+	if (change.field == PatchHistory::PresenceField(kind)) {
+		ImGui::Text("%s%s: %s", prefix, history.PatchName(change.patch).c_str(), change.after != 0.0f ? "added" : "removed");
+	}
+	else {
+		ImGui::Text("%s%s: %s %g -> %g", prefix, history.PatchName(change.patch).c_str(),
+			PatchHistory::FieldName(kind, change.field), change.before, change.after);
+	}
+	if (verdict != 0) {
+		ImGui::PopStyleColor();
+	}
+}
+
+void GUIManager::RenderPatchChanges(PatchHistory::Kind kind, const std::string& id) {
+	const auto& history = dataManager.GetPatchHistory();
+	auto changes = history.EntityChanges(kind, id, kPatchChangeCount);
+	if (changes.empty()) {
+		size_t seen = std::min(history.Patches(kind).size(), kPatchChangeCount);
+		ImGui::TextDisabled(seen > 1 ? "No changes in the last %zu patches." : "No earlier patch recorded yet.", seen);
+		return;
+	}
+	for (const auto& change : changes) {
+		RenderPatchChange(kind, change, "");
+	}
+}
+
+void GUIManager::RenderItemPatchDiff() {
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.1f, 0.1f, 0.1f, 0.95f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	if (ImGui::BeginPopup("ItemPatchDiff")) {
+		const auto& history = dataManager.GetPatchHistory();
+		const auto& patches = history.Patches(PatchHistory::Kind::Item);
+		if (patches.size() < 2) {
+			ImGui::Text("Only one patch has been recorded so far.");
+		}
+		else {
+			// Default to the newest patch against the one before it
+			if (itemDiffFrom < 0 || itemDiffTo < 0 || itemDiffTo >= static_cast<int>(patches.size())) {
+				itemDiffFrom = static_cast<int>(patches.size()) - 2;
+				itemDiffTo = static_cast<int>(patches.size()) - 1;
+			}
+			auto patchCombo = [&](const char* label, int& selected) {
+				ImGui::SetNextItemWidth(100);
+				if (ImGui::BeginCombo(label, history.PatchName(patches[selected]).c_str())) {
+					for (int i = 0; i < static_cast<int>(patches.size()); ++i) {
+						if (ImGui::Selectable(history.PatchName(patches[i]).c_str(), selected == i)) {
+							selected = i;
+						}
+					}
+					ImGui::EndCombo();
+				}
+			};
+			patchCombo("From", itemDiffFrom);
+			ImGui::SameLine();
+			patchCombo("To", itemDiffTo);
+			ImGui::SameLine();
+			ImGui::Checkbox("Cost only", &itemDiffCostOnly);
+			ImGui::Separator();
+
+			uint16_t from = patches[std::min(itemDiffFrom, itemDiffTo)];
+			uint16_t to = patches[std::max(itemDiffFrom, itemDiffTo)];
+			auto changes = history.ChangesBetween(PatchHistory::Kind::Item, from, to, itemDiffCostOnly ? PatchHistory::kItemCost : -1);
+			ImGui::BeginChild("ItemPatchDiffList", ImVec2(420, 300));
+			if (changes.empty()) {
+				ImGui::Text("No item changed between these patches.");
+			}
+			uint32_t lastEntity = UINT32_MAX;
+			for (const auto& change : changes) {
+				if (change.entity != lastEntity) {
+					lastEntity = change.entity;
+					const std::string& itemId = history.EntityId(PatchHistory::Kind::Item, change.entity);
+					std::string name = dataManager.ItemExists(itemId) ? dataManager.GetSpecificItemName(itemId) : itemId;
+					ImGui::PushID(static_cast<int>(change.entity));
+					if (ImGui::Selectable(name.c_str()) && dataManager.ItemExists(itemId)) {
+						DisplayItem(itemId);
+						ImGui::CloseCurrentPopup();
+					}
+					ImGui::PopID();
+				}
+				RenderPatchChange(PatchHistory::Kind::Item, change, "  ");
+			}
+			ImGui::EndChild();
+		}
+		ImGui::EndPopup();
+	}
+	ImGui::PopStyleColor(2);
+}
+
+void GUIManager::RenderItemFilters() {
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.1f, 0.1f, 0.1f, 0.95f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_CheckMark, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	if (ImGui::BeginPopup("ItemFilters")) {
+		const auto& itemFacets = dataManager.GetItemFacets();
+		bool changed = false;
+
+		ImGui::Text("Matching items: %zu", itemFacets.Evaluate(itemFilter).Count());
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Clear")) {
+			itemFilter.clear();
+			changed = true;
+		}
+		ImGui::Separator();
+
+		const auto& facets = itemFacets.GetFacets();
+		if (ImGui::BeginTable("ItemFacets", static_cast<int>(facets.size()), ImGuiTableFlags_SizingFixedFit)) {
+			for (const auto& facet : facets) {
+				ImGui::TableNextColumn();
+				ImGui::PushID(facet.c_str());
+				ImGui::TextColored(ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f), "%s", facet.c_str());
+
+				// Roles and tags can be combined ("MAGE and SUPPORT"), price and availability are alternatives
+				bool canMatchAll = facet == "Role" || facet == "Tag";
+				if (canMatchAll) {
+					auto it = itemFilter.find(facet);
+					bool matchAll = it != itemFilter.end() && it->second.matchAll;
+					if (ImGui::Checkbox("Match all", &matchAll)) {
+						itemFilter[facet].matchAll = matchAll;
+						changed = true;
+					}
+				}
+
+				const auto& values = itemFacets.GetValues(facet);
+				auto counts = itemFacets.Counts(itemFilter, facet);
+				for (size_t v = 0; v < values.size(); v++) {
+					auto it = itemFilter.find(facet);
+					bool isSelected = it != itemFilter.end() && it->second.values.count(values[v]) > 0;
+					const char* label = frameArena.Format("%s (%zu)", values[v].c_str(), counts[v]);
+					ImGui::BeginDisabled(counts[v] == 0 && !isSelected);
+					if (ImGui::Checkbox(label, &isSelected)) {
+						auto& selection = itemFilter[facet];
+						if (isSelected) selection.values.insert(values[v]);
+						else selection.values.erase(values[v]);
+						changed = true;
+					}
+					ImGui::EndDisabled();
+				}
+				ImGui::PopID();
+			}
+			ImGui::EndTable();
+		}
+
+		if (changed) {
+			ApplyItemFilter();
+		}
+		ImGui::EndPopup();
+	}
+	ImGui::PopStyleColor(3);
+}
+
+void GUIManager::RenderItemTable() {
+	const GoldEfficiency::Result* efficiency = dataManager.GetGoldEfficiency();
+	ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_ScrollY;
+	if (!ImGui::BeginTable("ItemsTable", 5, flags)) {
+		return;
+	}
+	ImGui::TableSetupScrollFreeze(0, 1);
+	ImGui::TableSetupColumn("##Icon", ImGuiTableColumnFlags_NoSort | ImGuiTableColumnFlags_WidthFixed, 32.0f);
+	ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+	ImGui::TableSetupColumn("Cost", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+	ImGui::TableSetupColumn("Gold value", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+	ImGui::TableSetupColumn("Efficiency", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending, 90.0f);
+	ImGui::TableHeadersRow();
+
+	// Sort the displayed list itself, so selecting a row uses the same index as the grid
+	ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+	if (sortSpecs && (sortSpecs->SpecsDirty || currentItems != sortedItems) && sortSpecs->SpecsCount > 0) {
+		const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+		auto key = [&](const std::string& itemId) -> float {
+			int ordinal = dataManager.GetItemOrdinal(itemId);
+			if (ordinal < 0 || !efficiency) return spec.ColumnIndex == 2 ? static_cast<float>(dataManager.GetItemCost(itemId)) : 0.0f;
+			switch (spec.ColumnIndex) {
+			case 2: return static_cast<float>(dataManager.GetItemCost(itemId));
+			case 3: return efficiency->value[ordinal];
+			default: return efficiency->efficiency[ordinal];
+			}
+		};
+		bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+		std::stable_sort(currentItems.begin(), currentItems.end(), [&](const std::string& a, const std::string& b) {
+			if (spec.ColumnIndex == 1) {
+				int order = dataManager.GetSpecificItemName(a).compare(dataManager.GetSpecificItemName(b));
+				return ascending ? order < 0 : order > 0;
+			}
+			return ascending ? key(a) < key(b) : key(a) > key(b);
+		});
+		sortedItems = currentItems;
+		sortSpecs->SpecsDirty = false;
+	}
+
+	for (int i = 0; i < currentItems.size(); i++) {
+		const auto& itemId = currentItems[i];
+		int ordinal = dataManager.GetItemOrdinal(itemId);
+		ImGui::PushID(i);
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Image((void*)(intptr_t)LoadTextureFromURL(dataManager.GetItemImageUrl(itemId)), ImVec2(24, 24));
+		ImGui::TableNextColumn();
+		if (ImGui::Selectable(dataManager.GetSpecificItemName(itemId).c_str(), selectedItemIndex == i, ImGuiSelectableFlags_SpanAllColumns)) {
+			if (selectedItemIndex != i) {
+				std::string selectedId = itemId;
+				ImGui::PopID();
+				UpdateItemState(selectedId, "", false, i, true);
+				break;
+			}
+		}
+		ImGui::TableNextColumn();
+		ImGui::Text("%d", dataManager.GetItemCost(itemId));
+		ImGui::TableNextColumn();
+		if (efficiency && ordinal >= 0) ImGui::Text("%.0f", efficiency->value[ordinal]);
+		ImGui::TableNextColumn();
+		if (efficiency && ordinal >= 0 && efficiency->efficiency[ordinal] > 0.0f) {
+			bool efficient = efficiency->efficiency[ordinal] >= 100.0f;
+			if (efficient) ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+			ImGui::Text("%.1f%%", efficiency->efficiency[ordinal]);
+			if (efficient) ImGui::PopStyleColor();
+		}
+		ImGui::PopID();
+	}
+	ImGui::EndTable();
+}
+
+void GUIManager::RenderRichText(std::string_view key, const std::string& markup) {
+	// Parsed and laid out once per key; the key names the text, so it is never re-parsed
+	auto it = richTexts.find(key);
+	if (it == richTexts.end()) {
+		it = richTexts.emplace(std::string(key), RichText(markup)).first;
+	}
+	it->second.Render();
+}
+
+void GUIManager::ApplyItemFilter() {
+	// Drop facets with nothing selected so an empty filter means "no filter"
+	for (auto it = itemFilter.begin(); it != itemFilter.end();) {
+		if (it->second.values.empty() && !it->second.matchAll) it = itemFilter.erase(it);
+		else ++it;
+	}
+
+	bool hasSelection = std::any_of(itemFilter.begin(), itemFilter.end(),
+		[](const auto& entry) { return !entry.second.values.empty(); });
+	currentItems = hasSelection ? dataManager.GetItemsMatching(itemFilter) : std::vector<std::string>();
+	currentTag = "";
+	selectedItemIndex = -1;
+	comboSelectedIndex = -1;
+	currentItemTags.clear();
+}
+
 void GUIManager::DisplayItemsByTag(const std::string& tag) {
 	UpdateItemState("", tag, true, 0, true);
 }
 
 GLuint GUIManager::LoadTextureFromURL(const std::string& url) {
 	// Check if the texture is already loaded
-	if (itemTextures.find(url) != itemTextures.end()) {
-		return itemTextures[url];
+	Symbol key = Symbols::Intern(url);
+	if (const GLuint* texture = itemTextures.Find(key)) {
+		return *texture;
 	}
 
-	CURL* curl = curl_easy_init();
-	GLuint texture = 0;
-	if (curl) {
-		std::string imageData;
-		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &imageData);
-
-		CURLcode res = curl_easy_perform(curl);
-		curl_easy_cleanup(curl);
-
-		if (res == CURLE_OK) {
-			int width, height, channels;
-			unsigned char* image = stbi_load_from_memory(
-				reinterpret_cast<const unsigned char*>(imageData.data()),
-				imageData.size(), &width, &height, &channels, 4);
-
-			if (image) {
-				glGenTextures(1, &texture);
-				glBindTexture(GL_TEXTURE_2D, texture);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-				stbi_image_free(image);
-
-				// Cache the loaded texture
-				itemTextures[url] = texture;
-			}
+	// Item icons packed into the executable need no download
+	std::string itemId = dataManager.GetItemIdFromIconUrl(url);
+	if (!itemId.empty()) {
+		GLuint bundled = LoadBundledIcon("item/" + itemId);
+		if (bundled) {
+			itemTextures[key] = bundled;
+			return bundled;
 		}
 	}
+
+	LoadItemTexture(key).Start(loaders);
+	return 0;
+}
+
+AsyncJob GUIManager::LoadItemTexture(Symbol url) {
+	// Cached as 0 while it downloads, and left at 0 if it fails
+	itemTextures[url] = 0;
+	GLuint texture = co_await LoadTextureAsync(std::string(Symbols::Name(url)));
+	itemTextures[url] = texture;
+}
+
+GLuint GUIManager::CreateIconTexture(const std::vector<uint8_t>& pixels, int size) {
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 	return texture;
 }
 
+GLuint GUIManager::LoadBundledIcon(const std::string& key) {
+	std::vector<uint8_t> pixels;
+	int size = 0;
+	if (!dataManager.GetBundledIcon(key, pixels, size)) {
+		return 0;
+	}
+	return CreateIconTexture(pixels, size);
+}
+
 void GUIManager::DisplayItem(const std::string& itemId) {
 	UpdateItemState(itemId, "", false, 0, true);
 }
@@ -1345,6 +2150,7 @@ void GUIManager::UpdateItemState(const std::string& itemId, const std::string& t
 		selectedItemIndex = -1;
 		comboSelectedIndex = -1;
 		currentItemTags.clear();  // Clear item tags when viewing a tag
+		itemFilter.clear();
 	}
 	else {
 		if (!dataManager.ItemExists(itemId)) {
@@ -1403,31 +2209,19 @@ void GUIManager::GoForward() {
 
 // Summoner's Spells page ---------------------------------------------------------------------------------------------------------------------------------------
 void GUIManager::RenderSummonerSpellsWindow() {
-	// Fetch game modes if not already done
-	static bool gameModesLoaded = false;
-	static bool fetchFailed = false;
-	if (!gameModesLoaded && !fetchFailed) {
-		ImGui::Text("Fetching game modes...");
-		if (dataManager.FetchGameModes() && dataManager.FetchSummonerSpells()) {
-			gameModesLoaded = true;
-		}
-		else {
-			fetchFailed = true;
-			ImGui::Text("Failed to load data. Please try again later.");
-			if (ImGui::Button("Retry")) {
-				fetchFailed = false;
-			}
-			return;
-		}
-	}
-
-	if (fetchFailed) {
+	// Game modes load first, the spells module needs them
+	DatasetRegistry::State spellsState = dataManager.RequestModule("summonerSpells");
+	if (spellsState == DatasetRegistry::State::Failed) {
 		ImGui::Text("Failed to load data. Please try again later.");
 		if (ImGui::Button("Retry")) {
-			fetchFailed = false;
+			dataManager.RetryModule("summonerSpells");
 		}
 		return;
 	}
+	if (spellsState != DatasetRegistry::State::Ready) {
+		ImGui::Text("Fetching game modes...");
+		return;
+	}
 
 	const auto& gameModes = dataManager.GetGameModes();
 
@@ -1464,24 +2258,17 @@ void GUIManager::RenderSummonerSpellsWindow() {
 		ImGui::PopItemWidth();
 		ImGui::Separator();
 
-		for (int i = 0; i < gameModes.size(); i++) {
+		const auto& searchIndex = dataManager.GetSearchIndex();
+		for (const auto& result : searchIndex.Query(gameModeSearch, gameModeSearchBuffer, SearchIndex::KindBit(SearchIndex::EntityKind::GameMode))) {
+			int i = searchIndex.GetEntry(result.entry).ordinal;
 			const auto& gameMode = gameModes[i];
+			bool is_selected = (selectedGameModeIndex == i);
+			if (ImGui::Selectable(gameMode.mode.c_str(), is_selected)) {
+				selectedGameModeIndex = i;
+			}
 
-			// Convert search and game mode to lowercase for case-insensitive comparison
-			std::string search = gameModeSearchBuffer;
-			std::string mode = gameMode.mode;
-			std::transform(search.begin(), search.end(), search.begin(), ::tolower);
-			std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
-
-			if (mode.find(search) != std::string::npos) {
-				bool is_selected = (selectedGameModeIndex == i);
-				if (ImGui::Selectable(gameMode.mode.c_str(), is_selected)) {
-					selectedGameModeIndex = i;
-				}
-
-				if (is_selected) {
-					ImGui::SetItemDefaultFocus();
-				}
+			if (is_selected) {
+				ImGui::SetItemDefaultFocus();
 			}
 		}
 		ImGui::EndCombo();
@@ -1496,11 +2283,15 @@ void GUIManager::RenderSummonerSpellsWindow() {
 		ImGui::Text("MODE: %s", gameModes[selectedGameModeIndex].description.c_str());
 
 		const std::string& selectedMode = gameModes[selectedGameModeIndex].mode;
-		auto spells = dataManager.GetSummonerSpellsForMode(selectedMode);
+		if (modeSpellsIndex != selectedGameModeIndex) {
+			modeSpells = dataManager.GetSummonerSpellsForMode(selectedMode);
+			modeSpellsIndex = selectedGameModeIndex;
+		}
+		const auto& allSpells = dataManager.GetSummonerSpells();
 
 		ImGui::NewLine();
 
-		if (spells.empty()) {
+		if (modeSpells.empty()) {
 			ImGui::SetCursorPosX(25);
 			ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "This game mode does not allow the use of Summoner Spells.");
 		}
@@ -1515,9 +2306,7 @@ void GUIManager::RenderSummonerSpellsWindow() {
 			int iconsPerRow = 13; // Limit to 13 icons per row
 			float leftOffset = 25.0f; // 25 pixels offset from the left
 
-			static int selectedSpellIndex = -1;
-
-			for (size_t i = 0; i < spells.size(); ++i) {
+			for (size_t i = 0; i < modeSpells.size(); ++i) {
 				if (i % iconsPerRow == 0) {
 					ImGui::NewLine();
 					ImGui::SetCursorPosX(leftOffset); // Set left offset
@@ -1526,7 +2315,7 @@ void GUIManager::RenderSummonerSpellsWindow() {
 					ImGui::SameLine(0, padding);
 				}
 
-				const auto& spell = spells[i];
+				const auto& spell = allSpells[modeSpells[i]];
 				GLuint texture = LoadSummonerSpellTexture(spell.id);
 
 				ImGui::PushID(static_cast<int>(i));
@@ -1543,15 +2332,15 @@ void GUIManager::RenderSummonerSpellsWindow() {
 			}
 
 			// Display chat box for selected spell
-			if (selectedSpellIndex >= 0 && selectedSpellIndex < spells.size()) {
-				const auto& selectedSpell = spells[selectedSpellIndex];
+			if (selectedSpellIndex >= 0 && selectedSpellIndex < modeSpells.size()) {
+				const auto& selectedSpell = allSpells[modeSpells[selectedSpellIndex]];
 				ImGui::NewLine();
 				ImGui::SetCursorPosX(25);
 				ImGui::BeginChild("SpellDetails", ImVec2(windowWidth - 50, 100), true);
 				ImGui::Indent(5.0f);
 				ImGui::Text("Name: %s", selectedSpell.name.c_str());
 				ImGui::Text("Summoner Level required to unlock: %d", selectedSpell.summonerLevel);
-				ImGui::TextWrapped("Description: %s", selectedSpell.description.c_str());
+				RenderRichText("summoner:" + selectedSpell.id, "Description: " + selectedSpell.description);
 				ImGui::Text("Cooldown: %s", selectedSpell.cooldownBurn.c_str());
 				ImGui::Unindent(5.0f);
 				ImGui::EndChild();
@@ -1569,8 +2358,9 @@ void GUIManager::RenderSummonerSpellsWindow() {
 
 				ImGui::PushFont(smallFont);
 
-				for (const auto& mode : selectedSpell.modes) {
-					ImVec2 textSize = ImGui::CalcTextSize(mode.c_str());
+				for (Symbol modeSymbol : selectedSpell.modes) {
+					std::string_view mode = Symbols::Name(modeSymbol);
+					ImVec2 textSize = ImGui::CalcTextSize(mode.data());
 					float buttonWidth = textSize.x + 20.0f;
 					float buttonHeight = textSize.y + 16.0f;
 
@@ -1589,7 +2379,7 @@ void GUIManager::RenderSummonerSpellsWindow() {
 						ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
 					}
 
-					if (ImGui::Button(mode.c_str(), ImVec2(buttonWidth, buttonHeight))) {
+					if (ImGui::Button(mode.data(), ImVec2(buttonWidth, buttonHeight))) {
 						auto it = std::find_if(gameModes.begin(), gameModes.end(),
 							[&mode](const DataManager::GameMode& gm) { return gm.mode == mode; });
 						if (it != gameModes.end()) {
@@ -1613,12 +2403,16 @@ void GUIManager::RenderSummonerSpellsWindow() {
 }
 
 GLuint GUIManager::LoadSummonerSpellTexture(const std::string& spellId) {
-	if (summonerSpellTextures.find(spellId) != summonerSpellTextures.end()) {
-		return summonerSpellTextures[spellId];
+	Symbol key = Symbols::Intern(spellId);
+	if (const GLuint* texture = summonerSpellTextures.Find(key)) {
+		return *texture;
 	}
 
-	std::string url = "https://ddragon.leagueoflegends.com/cdn/14.14.1/img/spell/" + spellId + ".png";
-	GLuint texture = LoadTextureFromURL(url);
-	summonerSpellTextures[spellId] = texture;
+	GLuint texture = LoadBundledIcon("spell/" + spellId);
+	if (!texture) {
+		// Downloaded icons are cached by LoadTextureFromURL once they arrive
+		return LoadTextureFromURL(dataManager.GetDataDragonUrl("img/spell/" + spellId + ".png"));
+	}
+	summonerSpellTextures[key] = texture;
 	return texture;
 }
\ No newline at end of file
@@ -0,0 +1,819 @@
+#include "GUIManager.h"
+#include <cfloat>
+#include <cmath>
+#include <chrono>
+#include <numeric>
+
+void GUIManager::RenderToolsWindow() {
+	ImGui::SetCursorPos(ImVec2(10, 5));
+	ImGui::BeginGroup();
+
+	ImGui::PushStyleColor(ImGuiCol_Tab, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_TabHovered, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_TabActive, ImVec4(0.8431f, 0.7255f, 0.4745f, 0.6f));
+	if (ImGui::BeginTabBar("ToolsTabs")) {
+		if (ImGui::BeginTabItem("Build Optimizer")) {
+			RenderOptimizerTab();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Stat Curves")) {
+			RenderStatCurvesTab();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Duels")) {
+			RenderDuelTab();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Team Builder")) {
+			RenderTeamTab();
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Abilities")) {
+			RenderAbilitiesTab();
+			ImGui::EndTabItem();
+		}
+		ImGui::EndTabBar();
+	}
+	ImGui::PopStyleColor(3);
+
+	ImGui::EndGroup();
+}
+
+void GUIManager::StartOptimizer() {
+	const auto& championNames = dataManager.GetChampionNames();
+	if (optimizerChampionIndex < 0 || optimizerChampionIndex >= static_cast<int>(championNames.size())) {
+		return;
+	}
+
+	BuildOptimizer::Request request;
+	request.champion = dataManager.GetChampionLevelStats(optimizerChampionIndex, optimizerLevel);
+	request.metric = static_cast<BuildOptimizer::Metric>(optimizerMetric);
+	request.slots = optimizerSlots;
+	request.goldBudget = static_cast<float>(optimizerBudget);
+	request.items = dataManager.GetBuildCandidates();
+	for (uint32_t item : request.items) {
+		request.groups.push_back(dataManager.GetItemGroupMask(item));
+	}
+	const GoldEfficiency::Result* efficiency = dataManager.GetGoldEfficiency();
+	request.goldValues = efficiency ? efficiency->prices : BaselineGoldValues();
+	buildOptimizer.Start(dataManager.GetItemStatTable(), std::move(request));
+}
+
+void GUIManager::RenderOptimizerTab() {
+	const auto& championNames = dataManager.GetChampionNames();
+
+	// Set custom colors
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgActive, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+
+	ImGui::SetNextItemWidth(250);
+	if (ImGui::BeginCombo("Champion", optimizerChampionIndex >= 0 ? championNames[optimizerChampionIndex].c_str() : "Select Champion")) {
+		for (int i = 0; i < static_cast<int>(championNames.size()); i++) {
+			if (ImGui::Selectable(championNames[i].c_str(), i == optimizerChampionIndex)) {
+				optimizerChampionIndex = i;
+			}
+		}
+		ImGui::EndCombo();
+	}
+
+	ImGui::SetNextItemWidth(250);
+	ImGui::SliderInt("Level", &optimizerLevel, 1, 18);
+
+	const char* metricNames[static_cast<int>(BuildOptimizer::Metric::Count)];
+	for (int i = 0; i < IM_ARRAYSIZE(metricNames); i++) {
+		metricNames[i] = BuildOptimizer::MetricName(static_cast<BuildOptimizer::Metric>(i));
+	}
+	ImGui::SetNextItemWidth(250);
+	ImGui::Combo("Optimize for", &optimizerMetric, metricNames, IM_ARRAYSIZE(metricNames));
+
+	ImGui::SetNextItemWidth(250);
+	ImGui::SliderInt("Items", &optimizerSlots, 1, BuildOptimizer::kMaxSlots);
+
+	ImGui::SetNextItemWidth(250);
+	ImGui::SliderInt("Gold budget", &optimizerBudget, 0, 25000, optimizerBudget == 0 ? "No limit" : "%d");
+
+	auto progress = buildOptimizer.GetProgress();
+	if (progress.running) {
+		if (ImGui::Button("Cancel", ImVec2(100, 30))) {
+			buildOptimizer.Cancel();
+		}
+	}
+	else if (ImGui::Button("Optimize", ImVec2(100, 30))) {
+		StartOptimizer();
+	}
+
+	if (progress.branchesTotal > 0) {
+		ImGui::SameLine();
+		float fraction = static_cast<float>(progress.branchesDone) / static_cast<float>(progress.branchesTotal);
+		ImGui::ProgressBar(fraction, ImVec2(250, 30));
+		ImGui::SameLine();
+		ImGui::Text("%llu builds checked in %.2fs", static_cast<unsigned long long>(progress.nodes), progress.seconds);
+	}
+	ImGui::PopStyleColor(8);
+
+	if (progress.best.empty()) {
+		return;
+	}
+
+	// Results, refreshed every frame while the search runs
+	ImGui::Separator();
+	if (ImGui::BeginTable("OptimizerResults", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("#");
+		ImGui::TableSetupColumn(BuildOptimizer::MetricName(static_cast<BuildOptimizer::Metric>(optimizerMetric)));
+		ImGui::TableSetupColumn("Cost");
+		ImGui::TableSetupColumn("Items");
+		ImGui::TableHeadersRow();
+
+		for (size_t row = 0; row < progress.best.size(); row++) {
+			const auto& build = progress.best[row];
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", row + 1);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", build.score);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", build.cost);
+			ImGui::TableNextColumn();
+			for (int slot = 0; slot < build.count; slot++) {
+				const std::string& itemId = dataManager.GetItemIdAt(build.items[slot]);
+				GLuint texture = LoadTextureFromURL(dataManager.GetItemImageUrl(itemId));
+				if (slot > 0) ImGui::SameLine();
+				ImGui::PushID(static_cast<int>(row * BuildOptimizer::kMaxSlots + slot));
+				if (ImGui::ImageButton((void*)(intptr_t)texture, ImVec2(32, 32))) {
+					currentState = WindowState::Items;
+					DisplayItem(itemId);
+				}
+				ImGui::PopID();
+				if (ImGui::IsItemHovered()) {
+					ImGui::BeginTooltip();
+					ImGui::Text("%s (%d gold)", dataManager.GetSpecificItemName(itemId).c_str(), dataManager.GetItemCost(itemId));
+					ImGui::EndTooltip();
+				}
+			}
+		}
+		ImGui::EndTable();
+	}
+}
+
+void GUIManager::RenderStatCurvesTab() {
+	const StatCurves::Table* curves = dataManager.GetStatCurves();
+	const auto& championNames = dataManager.GetChampionNames();
+	if (!curves || curves->championCount != championNames.size()) {
+		ImGui::Text("Champion data is not loaded.");
+		return;
+	}
+	const auto& curveStats = StatCurves::CurveStats();
+
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgActive, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+
+	ImGui::SetNextItemWidth(250);
+	ImGui::SliderInt("Level", &statCurveLevel, 1, StatCurves::kMaxLevel);
+	ImGui::SameLine(0, 30);
+	const char* statNames[StatCurves::kCurveCount];
+	for (size_t curve = 0; curve < StatCurves::kCurveCount; curve++) {
+		statNames[curve] = StatName(curveStats[curve]);
+	}
+	ImGui::SetNextItemWidth(200);
+	ImGui::Combo("Plot", &statCurvePlotStat, statNames, IM_ARRAYSIZE(statNames));
+	ImGui::SameLine();
+	if (ImGui::Button("Clear plot")) {
+		statCurvePlotted.clear();
+	}
+	ImGui::PopStyleColor(5);
+
+	RenderStatCurvePlot(*curves);
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+		ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchSame;
+	if (!ImGui::BeginTable("StatCurvesTable", static_cast<int>(StatCurves::kCurveCount) + 1, flags, ImVec2(0, ImGui::GetContentRegionAvail().y - 10))) {
+		return;
+	}
+	ImGui::TableSetupScrollFreeze(1, 1);
+	ImGui::TableSetupColumn("Champion", ImGuiTableColumnFlags_DefaultSort);
+	for (size_t curve = 0; curve < StatCurves::kCurveCount; curve++) {
+		ImGui::TableSetupColumn(statNames[curve], ImGuiTableColumnFlags_PreferSortDescending);
+	}
+	ImGui::TableHeadersRow();
+
+	// Only re-sort when the sort column or the level changes; the values are
+	// read straight out of the memoized level rows
+	ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+	bool stale = statCurveOrder.size() != championNames.size() || statCurveOrderLevel != statCurveLevel;
+	if (sortSpecs && sortSpecs->SpecsCount > 0 && (sortSpecs->SpecsDirty || stale)) {
+		statCurveOrder.resize(championNames.size());
+		std::iota(statCurveOrder.begin(), statCurveOrder.end(), 0);
+		const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+		bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+		if (spec.ColumnIndex == 0) {
+			std::sort(statCurveOrder.begin(), statCurveOrder.end(), [&](uint32_t a, uint32_t b) {
+				return ascending ? championNames[a] < championNames[b] : championNames[b] < championNames[a];
+			});
+		}
+		else {
+			const float* values = curves->Level(spec.ColumnIndex - 1, statCurveLevel);
+			std::stable_sort(statCurveOrder.begin(), statCurveOrder.end(), [&](uint32_t a, uint32_t b) {
+				return ascending ? values[a] < values[b] : values[a] > values[b];
+			});
+		}
+		statCurveOrderLevel = statCurveLevel;
+		sortSpecs->SpecsDirty = false;
+	}
+
+	ImGuiListClipper clipper;
+	clipper.Begin(static_cast<int>(statCurveOrder.size()));
+	while (clipper.Step()) {
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+			uint32_t champion = statCurveOrder[row];
+			auto plotted = std::find(statCurvePlotted.begin(), statCurvePlotted.end(), champion);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::PushID(static_cast<int>(champion));
+			if (ImGui::Selectable(championNames[champion].c_str(), plotted != statCurvePlotted.end(), ImGuiSelectableFlags_SpanAllColumns)) {
+				// Rows toggle in and out of the plot
+				if (plotted != statCurvePlotted.end()) statCurvePlotted.erase(plotted);
+				else if (statCurvePlotted.size() < 8) statCurvePlotted.push_back(champion);
+			}
+			ImGui::PopID();
+			for (size_t curve = 0; curve < StatCurves::kCurveCount; curve++) {
+				ImGui::TableNextColumn();
+				float value = curves->Get(curve, statCurveLevel, champion);
+				if (curveStats[curve] == Stat::AttackSpeed) ImGui::Text("%.3f", value);
+				else if (curveStats[curve] == Stat::HealthRegen || curveStats[curve] == Stat::ManaRegen) ImGui::Text("%.1f", value);
+				else ImGui::Text("%.0f", value);
+			}
+		}
+	}
+	ImGui::EndTable();
+}
+
+void GUIManager::RenderStatCurvePlot(const StatCurves::Table& curves) {
+	static const ImU32 colors[] = {
+		IM_COL32(215, 185, 121, 255), IM_COL32(90, 170, 230, 255), IM_COL32(220, 90, 90, 255), IM_COL32(120, 200, 120, 255),
+		IM_COL32(190, 120, 220, 255), IM_COL32(230, 150, 70, 255), IM_COL32(90, 210, 200, 255), IM_COL32(200, 200, 200, 255)
+	};
+	const auto& championNames = dataManager.GetChampionNames();
+	size_t curve = static_cast<size_t>(statCurvePlotStat);
+
+	ImVec2 size(ImGui::GetContentRegionAvail().x - 10, 200);
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(25, 25, 25, 255));
+	drawList->AddRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(80, 80, 80, 255));
+	ImGui::Dummy(size);
+
+	if (statCurvePlotted.empty()) {
+		drawList->AddText(ImVec2(origin.x + 10, origin.y + 10), IM_COL32(160, 160, 160, 255), "Click champions in the table to plot their curves.");
+		return;
+	}
+
+	float low = FLT_MAX, high = -FLT_MAX;
+	for (uint32_t champion : statCurvePlotted) {
+		low = std::min({ low, curves.Get(curve, 1, champion), curves.Get(curve, StatCurves::kMaxLevel, champion) });
+		high = std::max({ high, curves.Get(curve, 1, champion), curves.Get(curve, StatCurves::kMaxLevel, champion) });
+	}
+	if (high - low < 1e-3f) {
+		high = low + 1.0f;
+	}
+
+	const float margin = 30.0f;
+	auto point = [&](int level, float value) {
+		float x = origin.x + margin + (size.x - 2 * margin) * (level - 1) / (StatCurves::kMaxLevel - 1);
+		float y = origin.y + size.y - margin - (size.y - 2 * margin) * (value - low) / (high - low);
+		return ImVec2(x, y);
+	};
+
+	// Current level marker and axis labels
+	ImVec2 marker = point(statCurveLevel, low);
+	drawList->AddLine(ImVec2(marker.x, origin.y + margin / 2), ImVec2(marker.x, origin.y + size.y - margin / 2), IM_COL32(100, 100, 100, 255));
+	char label[32];
+	snprintf(label, sizeof(label), "%.1f", high);
+	drawList->AddText(ImVec2(origin.x + 4, point(1, high).y - 7), IM_COL32(160, 160, 160, 255), label);
+	snprintf(label, sizeof(label), "%.1f", low);
+	drawList->AddText(ImVec2(origin.x + 4, point(1, low).y - 7), IM_COL32(160, 160, 160, 255), label);
+
+	for (size_t i = 0; i < statCurvePlotted.size(); i++) {
+		uint32_t champion = statCurvePlotted[i];
+		ImU32 color = colors[i % IM_ARRAYSIZE(colors)];
+		ImVec2 points[StatCurves::kMaxLevel];
+		for (int level = 1; level <= StatCurves::kMaxLevel; level++) {
+			points[level - 1] = point(level, curves.Get(curve, level, champion));
+		}
+		drawList->AddPolyline(points, StatCurves::kMaxLevel, color, ImDrawFlags_None, 2.0f);
+		drawList->AddCircleFilled(points[statCurveLevel - 1], 3.5f, color);
+		drawList->AddText(ImVec2(origin.x + size.x - 150, origin.y + 8 + 15 * i), color, championNames[champion].c_str());
+	}
+}
+
+bool GUIManager::RenderItemSetEditor(const char* id, std::vector<uint32_t>& items) {
+	bool changed = false;
+	ImGui::PushID(id);
+	for (size_t slot = 0; slot < items.size(); slot++) {
+		const std::string& itemId = dataManager.GetItemIdAt(items[slot]);
+		if (slot > 0) ImGui::SameLine();
+		ImGui::PushID(static_cast<int>(slot));
+		if (ImGui::ImageButton((void*)(intptr_t)LoadTextureFromURL(dataManager.GetItemImageUrl(itemId)), ImVec2(32, 32))) {
+			items.erase(items.begin() + slot);
+			changed = true;
+			ImGui::PopID();
+			break;
+		}
+		ImGui::PopID();
+		if (ImGui::IsItemHovered()) {
+			ImGui::BeginTooltip();
+			ImGui::Text("%s (click to remove)", dataManager.GetSpecificItemName(itemId).c_str());
+			ImGui::EndTooltip();
+		}
+	}
+
+	if (items.size() < BuildOptimizer::kMaxSlots) {
+		ImGui::SetNextItemWidth(250);
+		if (ImGui::BeginCombo("##AddItem", "Add item")) {
+			for (uint32_t candidate : dataManager.GetBuildCandidates()) {
+				const std::string& itemId = dataManager.GetItemIdAt(candidate);
+				ImGui::PushID(static_cast<int>(candidate));
+				if (ImGui::Selectable(dataManager.GetSpecificItemName(itemId).c_str())) {
+					items.push_back(candidate);
+					changed = true;
+				}
+				ImGui::PopID();
+			}
+			ImGui::EndCombo();
+		}
+	}
+	ImGui::PopID();
+	return changed;
+}
+
+void GUIManager::UpdateDuels() {
+	if (!duelInputsDirty) {
+		return;
+	}
+	duelInputsDirty = false;
+
+	const auto& table = dataManager.GetItemStatTable();
+	size_t count = dataManager.GetChampionNames().size();
+	std::vector<DuelMatrix::Fighter> fighters(count);
+	for (uint32_t champion = 0; champion < count; champion++) {
+		auto custom = duelOverrides.find(champion);
+		const DuelSetup& setup = custom != duelOverrides.end() ? custom->second : duelDefault;
+		StatVector itemTotals{};
+		for (uint32_t item : setup.items) {
+			if (item >= table.Size()) continue;
+			for (size_t stat = 0; stat < kStatCount; stat++) {
+				itemTotals[stat] += table.columns[stat][item];
+			}
+		}
+		fighters[champion] = DuelMatrix::MakeFighter(dataManager.GetChampionLevelStats(champion, setup.level), itemTotals);
+	}
+
+	// Only the champions whose fighter changed are recomputed
+	auto start = std::chrono::steady_clock::now();
+	size_t cells = duelMatrix.Update(fighters, TaskPool::Shared());
+	if (cells > 0) {
+		duelLastCells = cells;
+		duelLastMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+void GUIManager::UpdateDuelHeatmap() {
+	size_t count = duelMatrix.Size();
+	if (count == 0 || (duelHeatmapVersion == duelMatrix.Version() && duelHeatmapTextureMode == duelHeatmapMode)) {
+		return;
+	}
+	duelHeatmapVersion = duelMatrix.Version();
+	duelHeatmapTextureMode = duelHeatmapMode;
+
+	// Time to kill is spread on a log scale between the fastest and slowest finite kill
+	float fastest = FLT_MAX, slowest = 0.0f;
+	for (uint32_t row = 0; row < count; row++) {
+		for (uint32_t column = 0; column < count; column++) {
+			float time = duelMatrix.Get(row, column);
+			if (std::isfinite(time)) {
+				fastest = std::min(fastest, time);
+				slowest = std::max(slowest, time);
+			}
+		}
+	}
+	float range = std::max(1e-3f, std::log1p(slowest) - std::log1p(fastest));
+
+	const ImVec4 gold(0.8431f, 0.7255f, 0.4745f, 1.0f);
+	const ImVec4 blue(0.25f, 0.45f, 0.75f, 1.0f);
+	const ImVec4 dark(0.1f, 0.1f, 0.1f, 1.0f);
+	auto mix = [](const ImVec4& a, const ImVec4& b, float t) {
+		return ImVec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, 1.0f);
+	};
+
+	std::vector<uint8_t> pixels(count * count * 4);
+	for (uint32_t row = 0; row < count; row++) {
+		for (uint32_t column = 0; column < count; column++) {
+			float time = duelMatrix.Get(row, column);
+			ImVec4 color = dark;
+			if (duelHeatmapMode == 0) {
+				// Fast kills gold, slow kills blue, never dark
+				if (std::isfinite(time)) color = mix(gold, blue, (std::log1p(time) - std::log1p(fastest)) / range);
+			}
+			else if (row != column) {
+				// Gold when the row champion kills first, blue when it dies first
+				float reverse = duelMatrix.Get(column, row);
+				float advantage = 0.0f;
+				if (!std::isfinite(time) && !std::isfinite(reverse)) advantage = 0.0f;
+				else if (!std::isfinite(time)) advantage = -1.0f;
+				else if (!std::isfinite(reverse)) advantage = 1.0f;
+				else advantage = std::max(-1.0f, std::min(1.0f, std::log2((reverse + 0.1f) / (time + 0.1f)) / 2.0f));
+				color = advantage >= 0.0f ? mix(dark, gold, advantage) : mix(dark, blue, -advantage);
+			}
+			uint8_t* pixel = &pixels[(row * count + column) * 4];
+			pixel[0] = static_cast<uint8_t>(color.x * 255.0f);
+			pixel[1] = static_cast<uint8_t>(color.y * 255.0f);
+			pixel[2] = static_cast<uint8_t>(color.z * 255.0f);
+			pixel[3] = 255;
+		}
+	}
+
+	if (duelHeatmapTexture == 0) {
+		glGenTextures(1, &duelHeatmapTexture);
+	}
+	glBindTexture(GL_TEXTURE_2D, duelHeatmapTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(count), static_cast<GLsizei>(count), 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+}
+
+void GUIManager::RenderDuelTab() {
+	const auto& championNames = dataManager.GetChampionNames();
+	if (championNames.empty() || dataManager.GetItemStatTable().Size() == 0) {
+		ImGui::Text("Champion and item data is not loaded.");
+		return;
+	}
+	if (duelMatrix.Size() != championNames.size()) {
+		duelInputsDirty = true;
+	}
+	UpdateDuels();
+	UpdateDuelHeatmap();
+
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgActive, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_CheckMark, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+
+	// Heatmap, one texel per champion pair; rows attack, columns defend
+	size_t count = duelMatrix.Size();
+	float side = std::min(ImGui::GetContentRegionAvail().y - 10, ImGui::GetContentRegionAvail().x - 420);
+	side = std::max(side, static_cast<float>(count));
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImGui::Image((void*)(intptr_t)duelHeatmapTexture, ImVec2(side, side));
+	float cell = side / static_cast<float>(count);
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	if (duelSelected >= 0 && duelSelected < static_cast<int>(count)) {
+		float offset = cell * duelSelected;
+		drawList->AddRect(ImVec2(origin.x, origin.y + offset), ImVec2(origin.x + side, origin.y + offset + cell), IM_COL32(255, 255, 255, 160));
+		drawList->AddRect(ImVec2(origin.x + offset, origin.y), ImVec2(origin.x + offset + cell, origin.y + side), IM_COL32(255, 255, 255, 160));
+	}
+	if (ImGui::IsItemHovered()) {
+		ImVec2 mouse = ImGui::GetMousePos();
+		int row = std::min(static_cast<int>(count) - 1, static_cast<int>((mouse.y - origin.y) / cell));
+		int column = std::min(static_cast<int>(count) - 1, static_cast<int>((mouse.x - origin.x) / cell));
+		if (row >= 0 && column >= 0) {
+			auto describe = [](float time) {
+				char text[32];
+				if (std::isfinite(time)) snprintf(text, sizeof(text), "%.2fs", time);
+				else snprintf(text, sizeof(text), "never");
+				return std::string(text);
+			};
+			ImGui::BeginTooltip();
+			ImGui::Text("%s kills %s in %s", championNames[row].c_str(), championNames[column].c_str(), describe(duelMatrix.Get(row, column)).c_str());
+			ImGui::Text("%s kills %s in %s", championNames[column].c_str(), championNames[row].c_str(), describe(duelMatrix.Get(column, row)).c_str());
+			ImGui::EndTooltip();
+			if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+				duelSelected = row;
+			}
+		}
+	}
+
+	ImGui::SameLine(0, 20);
+	ImGui::BeginGroup();
+	const char* modes[] = { "Time to kill", "Duel winner" };
+	ImGui::SetNextItemWidth(250);
+	ImGui::Combo("Color by", &duelHeatmapMode, modes, IM_ARRAYSIZE(modes));
+	ImGui::Text("Recomputed %zu cells in %.2f ms", duelLastCells, duelLastMilliseconds);
+
+	ImGui::Separator();
+	ImGui::Text("Every champion");
+	ImGui::SetNextItemWidth(250);
+	if (ImGui::SliderInt("Level##Default", &duelDefault.level, 1, 18)) {
+		duelInputsDirty = true;
+	}
+	if (RenderItemSetEditor("DefaultItems", duelDefault.items)) {
+		duelInputsDirty = true;
+	}
+
+	ImGui::Separator();
+	if (duelSelected >= 0 && duelSelected < static_cast<int>(count)) {
+		uint32_t champion = static_cast<uint32_t>(duelSelected);
+		ImGui::Text("%s", championNames[champion].c_str());
+		auto custom = duelOverrides.find(champion);
+		bool isCustom = custom != duelOverrides.end();
+		if (ImGui::Checkbox("Custom setup", &isCustom)) {
+			if (isCustom) duelOverrides[champion] = duelDefault;
+			else duelOverrides.erase(champion);
+			duelInputsDirty = true;
+		}
+		custom = duelOverrides.find(champion);
+		if (custom != duelOverrides.end()) {
+			ImGui::SetNextItemWidth(250);
+			if (ImGui::SliderInt("Level##Custom", &custom->second.level, 1, 18)) {
+				duelInputsDirty = true;
+			}
+			if (RenderItemSetEditor("CustomItems", custom->second.items)) {
+				duelInputsDirty = true;
+			}
+		}
+	}
+	else {
+		ImGui::Text("Click a row of the heatmap to give a champion its own setup.");
+	}
+	ImGui::EndGroup();
+	ImGui::PopStyleColor(6);
+}
+
+void GUIManager::UpdateTeamProfiles() {
+	const auto& championNames = dataManager.GetChampionNames();
+	const StatCurves::Table* curves = dataManager.GetStatCurves();
+	if (!curves || (teamProfilesLevel == teamLevel && teamProfiles.size() == championNames.size())) {
+		return;
+	}
+	int health = StatCurves::CurveIndex(Stat::Health);
+	int armor = StatCurves::CurveIndex(Stat::Armor);
+	int magicResist = StatCurves::CurveIndex(Stat::MagicResist);
+	const uint8_t frontlineRoles = TeamComposer::RoleMask({ "Tank", "Fighter" });
+
+	teamProfiles.assign(championNames.size(), TeamComposer::Champion());
+	for (uint32_t champion = 0; champion < championNames.size(); champion++) {
+		auto& profile = teamProfiles[champion];
+		profile.roles = TeamComposer::RoleMask(dataManager.GetChampionTags(championNames[champion]));
+		if (profile.roles & frontlineRoles) {
+			// Effective HP against half physical, half magic damage
+			float damageTaken = 0.5f * 100.0f / (100.0f + curves->Get(armor, teamLevel, champion)) +
+				0.5f * 100.0f / (100.0f + curves->Get(magicResist, teamLevel, champion));
+			profile.frontline = curves->Get(health, teamLevel, champion) / damageTaken;
+		}
+		auto info = dataManager.GetChampionInfo(championNames[champion]);
+		profile.physical = info.value("attack", 0.0f);
+		profile.magic = info.value("magic", 0.0f);
+		profile.ranged = dataManager.GetChampionLevelStats(champion, 1).attackRange > 300.0f;
+	}
+	teamProfilesLevel = teamLevel;
+}
+
+void GUIManager::StartTeamSearch() {
+	UpdateTeamProfiles();
+	TeamComposer::Request request;
+	request.champions = teamProfiles;
+	for (int pick : teamPicks) {
+		if (pick >= 0 && std::find(request.picked.begin(), request.picked.end(), static_cast<uint32_t>(pick)) == request.picked.end()) {
+			request.picked.push_back(static_cast<uint32_t>(pick));
+		}
+	}
+	request.weights = teamWeights;
+	request.timeBudget = teamTimeBudget;
+	teamComposer.Start(std::move(request));
+}
+
+void GUIManager::RenderTeamTab() {
+	const auto& championNames = dataManager.GetChampionNames();
+	if (championNames.empty() || !dataManager.GetStatCurves()) {
+		ImGui::Text("Champion data is not loaded.");
+		return;
+	}
+	UpdateTeamProfiles();
+
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgActive, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+
+	// Picked champions; empty slots are filled by the search
+	ImGui::BeginGroup();
+	for (int slot = 0; slot < TeamComposer::kTeamSize; slot++) {
+		int& pick = teamPicks[slot];
+		ImGui::PushID(slot);
+		ImGui::SetNextItemWidth(200);
+		if (ImGui::BeginCombo("##Pick", pick >= 0 && pick < static_cast<int>(championNames.size()) ? championNames[pick].c_str() : "Open slot")) {
+			if (ImGui::Selectable("Open slot", pick < 0)) {
+				pick = -1;
+			}
+			for (int i = 0; i < static_cast<int>(championNames.size()); i++) {
+				if (ImGui::Selectable(championNames[i].c_str(), i == pick)) {
+					pick = i;
+				}
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::PopID();
+	}
+	ImGui::EndGroup();
+
+	ImGui::SameLine(0, 30);
+	ImGui::BeginGroup();
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderInt("Level", &teamLevel, 1, StatCurves::kMaxLevel);
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderFloat("Time budget", &teamTimeBudget, 0.1f, 10.0f, "%.1fs");
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderFloat("Role coverage", &teamWeights.coverage, 0.0f, 2.0f, "%.1f");
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderFloat("Frontline", &teamWeights.frontline, 0.0f, 2.0f, "%.1f");
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderFloat("Damage mix", &teamWeights.damage, 0.0f, 2.0f, "%.1f");
+	ImGui::SetNextItemWidth(200);
+	ImGui::SliderFloat("Range mix", &teamWeights.range, 0.0f, 2.0f, "%.1f");
+	ImGui::EndGroup();
+
+	// Breakdown of the picks so far
+	std::vector<uint32_t> picked;
+	for (int pick : teamPicks) {
+		if (pick >= 0) picked.push_back(static_cast<uint32_t>(pick));
+	}
+	float reference = TeamComposer::FrontlineReference(teamProfiles);
+	auto breakdown = TeamComposer::Score(teamProfiles, picked, teamWeights, reference);
+	ImGui::Text("Current picks: %.1f  (roles %.0f%%, frontline %.0f%%, damage mix %.0f%%, range mix %.0f%%)", breakdown.total,
+		100.0f * breakdown.coverage, 100.0f * breakdown.frontline, 100.0f * breakdown.damage, 100.0f * breakdown.range);
+
+	auto progress = teamComposer.GetProgress();
+	if (progress.running) {
+		if (ImGui::Button("Cancel", ImVec2(150, 30))) {
+			teamComposer.Cancel();
+		}
+	}
+	else if (ImGui::Button(picked.size() < TeamComposer::kTeamSize ? "Find completions" : "Score team", ImVec2(150, 30))) {
+		StartTeamSearch();
+	}
+	if (progress.tasksTotal > 0) {
+		ImGui::SameLine();
+		float fraction = static_cast<float>(progress.tasksDone) / static_cast<float>(progress.tasksTotal);
+		ImGui::ProgressBar(fraction, ImVec2(250, 30));
+		ImGui::SameLine();
+		ImGui::Text("%llu teams checked in %.2fs%s", static_cast<unsigned long long>(progress.nodes), progress.seconds,
+			progress.timedOut ? " (time budget reached)" : "");
+	}
+	ImGui::PopStyleColor(8);
+
+	if (progress.best.empty()) {
+		return;
+	}
+
+	// Results, refreshed every frame while the search runs
+	ImGui::Separator();
+	if (ImGui::BeginTable("TeamResults", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("#");
+		ImGui::TableSetupColumn("Score");
+		ImGui::TableSetupColumn("Team");
+		ImGui::TableHeadersRow();
+		for (size_t row = 0; row < progress.best.size(); row++) {
+			const auto& team = progress.best[row];
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", row + 1);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", team.score);
+			ImGui::TableNextColumn();
+			for (int member = 0; member < team.count; member++) {
+				if (member > 0) ImGui::SameLine();
+				bool isPick = std::find(picked.begin(), picked.end(), team.members[member]) != picked.end();
+				if (!isPick) ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+				ImGui::Text("%s", championNames[team.members[member]].c_str());
+				if (!isPick) ImGui::PopStyleColor();
+			}
+		}
+		ImGui::EndTable();
+	}
+}
+
+void GUIManager::RenderAbilitiesTab() {
+	const auto& championNames = dataManager.GetChampionNames();
+	const AbilityTable& abilities = dataManager.GetAbilityTable();
+	if (abilities.Size() == 0) {
+		if (championNames.empty()) {
+			return;
+		}
+		if (dataManager.RequestModule("abilities") != DatasetRegistry::State::Failed) {
+			ImGui::Text("Loading ability data...");
+		}
+		else {
+			ImGui::Text("Ability data is not loaded.");
+			if (ImGui::Button("Retry", ImVec2(100, 30))) {
+				dataManager.RetryModule("abilities");
+			}
+		}
+		return;
+	}
+
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_FrameBgActive, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f));
+	ImGui::SetNextItemWidth(250);
+	ImGui::SliderInt("Ability haste", &abilityHaste, 0, 300);
+	ImGui::PopStyleColor(4);
+	ImGui::SameLine(0, 20);
+	ImGui::Text("Cooldown reduction: %.1f%%", 100.0f - 10000.0f / (100.0f + abilityHaste));
+
+	// One pass over every rank of every ability, only when the haste or the table changes
+	bool tableChanged = abilityCachesGeneration != abilities.Generation();
+	if (tableChanged || abilityCooldownsHaste != abilityHaste) {
+		abilities.HasteCooldowns(static_cast<float>(abilityHaste), abilityCooldowns);
+		abilityCooldownsHaste = abilityHaste;
+	}
+	abilityCachesGeneration = abilities.Generation();
+
+	ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH |
+		ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	if (!ImGui::BeginTable("AbilitiesTable", 7, flags, ImVec2(0, ImGui::GetContentRegionAvail().y - 10))) {
+		return;
+	}
+	ImGui::TableSetupScrollFreeze(0, 1);
+	ImGui::TableSetupColumn("Champion", ImGuiTableColumnFlags_DefaultSort);
+	ImGui::TableSetupColumn("Key", ImGuiTableColumnFlags_WidthFixed, 40.0f);
+	ImGui::TableSetupColumn("Ability");
+	ImGui::TableSetupColumn("Cooldown by rank", ImGuiTableColumnFlags_NoSort);
+	ImGui::TableSetupColumn("Max rank cooldown", ImGuiTableColumnFlags_WidthFixed, 130.0f);
+	ImGui::TableSetupColumn("Cost", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+	ImGui::TableSetupColumn("Range", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+	ImGui::TableHeadersRow();
+
+	// Haste scales every cooldown alike, so the order only changes with the sort column
+	auto maxRank = [&abilities](const float* values, size_t row) { return values[abilities.GetAbility(row).maxRank - 1]; };
+	ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+	if (sortSpecs && sortSpecs->SpecsCount > 0 && (sortSpecs->SpecsDirty || tableChanged)) {
+		abilityOrder.resize(abilities.Size());
+		std::iota(abilityOrder.begin(), abilityOrder.end(), 0);
+		const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+		bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+		auto less = [&](uint32_t a, uint32_t b) {
+			const auto& first = abilities.GetAbility(a);
+			const auto& second = abilities.GetAbility(b);
+			switch (spec.ColumnIndex) {
+			case 1: return first.slot < second.slot;
+			case 2: return first.name < second.name;
+			case 4: return maxRank(abilities.Cooldowns(a), a) < maxRank(abilities.Cooldowns(b), b);
+			case 5: return maxRank(abilities.Costs(a), a) < maxRank(abilities.Costs(b), b);
+			case 6: return maxRank(abilities.Ranges(a), a) < maxRank(abilities.Ranges(b), b);
+			default:
+				if (first.champion != second.champion) return championNames[first.champion] < championNames[second.champion];
+				return first.slot < second.slot;
+			}
+		};
+		std::stable_sort(abilityOrder.begin(), abilityOrder.end(), [&](uint32_t a, uint32_t b) {
+			return ascending ? less(a, b) : less(b, a);
+		});
+		sortSpecs->SpecsDirty = false;
+	}
+
+	ImGuiListClipper clipper;
+	clipper.Begin(static_cast<int>(abilityOrder.size()));
+	while (clipper.Step()) {
+		for (int line = clipper.DisplayStart; line < clipper.DisplayEnd; line++) {
+			uint32_t row = abilityOrder[line];
+			const auto& ability = abilities.GetAbility(row);
+			const float* cooldowns = &abilityCooldowns[row * AbilityTable::kMaxRanks];
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", ability.champion < championNames.size() ? championNames[ability.champion].c_str() : "");
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", AbilityTable::SlotKey(ability.slot));
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", ability.name.c_str());
+			ImGui::TableNextColumn();
+			char ranks[96] = "";
+			int length = 0;
+			for (int rank = 0; rank < ability.maxRank && length < static_cast<int>(sizeof(ranks)); rank++) {
+				length += snprintf(ranks + length, sizeof(ranks) - length, rank > 0 ? " / %.1f" : "%.1f", cooldowns[rank]);
+			}
+			ImGui::Text("%s", ranks);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1fs", cooldowns[ability.maxRank - 1]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", maxRank(abilities.Costs(row), row));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", maxRank(abilities.Ranges(row), row));
+		}
+	}
+	ImGui::EndTable();
+}
@@ -0,0 +1,251 @@
+#include "JsonView.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    [[noreturn]] void Malformed(const char* what) {
+        throw std::runtime_error(std::string("malformed json: ") + what);
+    }
+
+    bool IsSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    size_t SkipSpace(std::string_view text, size_t pos) {
+        while (pos < text.size() && IsSpace(text[pos])) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    // pos is at the opening quote; returns the position after the closing one
+    size_t SkipString(std::string_view text, size_t pos) {
+        // Jumps from quote to quote; a quote after an odd run of backslashes is escaped
+        const char* begin = text.data();
+        const char* end = begin + text.size();
+        const char* at = begin + pos + 1;
+        while (const char* quote = static_cast<const char*>(std::memchr(at, '"', end - at))) {
+            const char* slash = quote;
+            while (slash > at && slash[-1] == '\\') {
+                --slash;
+            }
+            if ((quote - slash) % 2 == 0) {
+                return quote - begin + 1;
+            }
+            at = quote + 1;
+        }
+        Malformed("unterminated string");
+    }
+
+    // Returns the position after the value starting at pos
+    size_t SkipValue(std::string_view text, size_t pos) {
+        if (pos >= text.size()) {
+            Malformed("missing value");
+        }
+        char c = text[pos];
+        if (c == '"') {
+            return SkipString(text, pos);
+        }
+        if (c == '{' || c == '[') {
+            // Only brackets and strings matter inside a skipped container
+            int depth = 0;
+            while (pos < text.size()) {
+                c = text[pos];
+                if (c == '"') {
+                    pos = SkipString(text, pos);
+                    continue;
+                }
+                if (c == '{' || c == '[') {
+                    ++depth;
+                }
+                else if (c == '}' || c == ']') {
+                    if (--depth == 0) {
+                        return pos + 1;
+                    }
+                }
+                ++pos;
+            }
+            Malformed("unbalanced brackets");
+        }
+        // Literal or number: runs to the next delimiter
+        size_t start = pos;
+        while (pos < text.size() && !IsSpace(text[pos]) && text[pos] != ',' && text[pos] != '}' && text[pos] != ']') {
+            ++pos;
+        }
+        if (pos == start) {
+            Malformed("missing value");
+        }
+        return pos;
+    }
+
+    JsonView::Type TypeOf(char c) {
+        switch (c) {
+        case '{': return JsonView::Type::Object;
+        case '[': return JsonView::Type::Array;
+        case '"': return JsonView::Type::String;
+        case 't':
+        case 'f': return JsonView::Type::Bool;
+        case 'n': return JsonView::Type::Null;
+        default: return JsonView::Type::Number;
+        }
+    }
+
+    void AppendUtf8(std::string& out, uint32_t codepoint) {
+        if (codepoint < 0x80) {
+            out += static_cast<char>(codepoint);
+        }
+        else if (codepoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codepoint >> 6));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else if (codepoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codepoint >> 12));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (codepoint >> 18));
+            out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+    }
+
+    uint32_t Hex4(std::string_view text, size_t pos) {
+        uint32_t value = 0;
+        if (pos + 4 > text.size() ||
+            std::from_chars(text.data() + pos, text.data() + pos + 4, value, 16).ptr != text.data() + pos + 4) {
+            Malformed("bad \\u escape");
+        }
+        return value;
+    }
+}
+
+JsonView::JsonView(std::string_view text) {
+    size_t pos = SkipSpace(text, 0);
+    *this = At(text, pos);
+    if (SkipSpace(text, pos) != text.size()) {
+        Malformed("trailing characters");
+    }
+}
+
+JsonView JsonView::At(std::string_view text, size_t& pos) {
+    size_t start = pos;
+    pos = SkipValue(text, pos);
+    return JsonView(text.substr(start, pos - start), TypeOf(text[start]));
+}
+
+bool JsonView::NextMember(size_t& pos, std::string_view& key, JsonView& value) const {
+    pos = SkipSpace(raw, pos);
+    if (pos < raw.size() && raw[pos] == ',') {
+        pos = SkipSpace(raw, pos + 1);
+    }
+    if (pos >= raw.size() || raw[pos] == '}') {
+        return false;
+    }
+    if (raw[pos] != '"') {
+        Malformed("expected a key");
+    }
+    size_t keyEnd = SkipString(raw, pos);
+    key = raw.substr(pos + 1, keyEnd - pos - 2);
+    pos = SkipSpace(raw, keyEnd);
+    if (pos >= raw.size() || raw[pos] != ':') {
+        Malformed("expected ':'");
+    }
+    pos = SkipSpace(raw, pos + 1);
+    value = At(raw, pos);
+    return true;
+}
+
+bool JsonView::NextElement(size_t& pos, JsonView& value) const {
+    pos = SkipSpace(raw, pos);
+    if (pos < raw.size() && raw[pos] == ',') {
+        pos = SkipSpace(raw, pos + 1);
+    }
+    if (pos >= raw.size() || raw[pos] == ']') {
+        return false;
+    }
+    value = At(raw, pos);
+    return true;
+}
+
+JsonView JsonView::Find(std::string_view key) const {
+    size_t pos = 1;
+    std::string_view memberKey;
+    JsonView value;
+    while (type == Type::Object && NextMember(pos, memberKey, value)) {
+        if (memberKey == key) {
+            return value;
+        }
+    }
+    return JsonView();
+}
+
+std::string JsonView::String() const {
+    if (type != Type::String) {
+        return std::string();
+    }
+    std::string_view body = raw.substr(1, raw.size() - 2);
+    if (body.find('\\') == std::string_view::npos) {
+        return std::string(body);
+    }
+    std::string out;
+    out.reserve(body.size());
+    for (size_t i = 0; i < body.size(); ++i) {
+        if (body[i] != '\\') {
+            out += body[i];
+            continue;
+        }
+        if (++i >= body.size()) {
+            Malformed("bad escape");
+        }
+        switch (body[i]) {
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+            uint32_t codepoint = Hex4(body, i + 1);
+            i += 4;
+            // A high surrogate pairs with the escape after it
+            if (codepoint >= 0xD800 && codepoint < 0xDC00 && i + 6 < body.size() &&
+                body[i + 1] == '\\' && body[i + 2] == 'u') {
+                uint32_t low = Hex4(body, i + 3);
+                if (low >= 0xDC00 && low < 0xE000) {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+            }
+            AppendUtf8(out, codepoint);
+            break;
+        }
+        default: out += body[i]; break;   // quote, backslash and slash
+        }
+    }
+    return out;
+}
+
+double JsonView::Number(double fallback) const {
+    if (type != Type::Number) {
+        return fallback;
+    }
+    double value = fallback;
+    auto result = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+    return result.ec == std::errc() ? value : fallback;
+}
+
+bool JsonView::Bool(bool fallback) const {
+    if (type != Type::Bool) {
+        return fallback;
+    }
+    return raw == "true";
+}
+
+nlohmann::json JsonView::Materialize() const {
+    if (type == Type::Missing) {
+        return nlohmann::json();
+    }
+    return nlohmann::json::parse(raw.begin(), raw.end());
+}
@@ -0,0 +1,66 @@
+#include "LocaleStrings.h"
+#include "JsonView.h"
+#include <stdexcept>
+
+void LocaleStrings::Build(std::string_view championJson, std::string_view summonerJson) {
+    JsonView championData = JsonView(championJson).Find("data");
+    JsonView spellData = JsonView(summonerJson).Find("data");
+    if (!championData.IsObject() || !spellData.IsObject()) {
+        throw std::runtime_error("locale data has no \"data\" object");
+    }
+    championData.ForEachMember([this](std::string_view id, const JsonView& champion) {
+        champions[Symbols::Intern(id)] = { champion.Find("name").String(), champion.Find("title").String(),
+            champion.Find("blurb").String() };
+    });
+    // summoner.json is keyed by spell key; the id is what the datasets use
+    spellData.ForEachMember([this](std::string_view, const JsonView& spell) {
+        spells[Symbols::Intern(spell.Find("id").String())] = { spell.Find("name").String(), spell.Find("description").String() };
+    });
+}
+
+std::string LocaleStrings::Serialize() const {
+    nlohmann::json out;
+    nlohmann::json& championsOut = out["champions"];
+    champions.ForEach([&championsOut](Symbol id, const Champion& champion) {
+        championsOut[std::string(Symbols::Name(id))] = { champion.name, champion.title, champion.blurb };
+    });
+    nlohmann::json& spellsOut = out["spells"];
+    spells.ForEach([&spellsOut](Symbol id, const Spell& spell) {
+        spellsOut[std::string(Symbols::Name(id))] = { spell.name, spell.description };
+    });
+    return out.dump();
+}
+
+bool LocaleStrings::Parse(std::string_view text) {
+    champions.Clear();
+    spells.Clear();
+    try {
+        JsonView document(text);
+        document.Find("champions").ForEachMember([this](std::string_view id, const JsonView& fields) {
+            Champion& champion = champions[Symbols::Intern(id)];
+            int index = 0;
+            fields.ForEachElement([&champion, &index](const JsonView& field) {
+                std::string* targets[] = { &champion.name, &champion.title, &champion.blurb };
+                if (index < 3) {
+                    *targets[index++] = field.String();
+                }
+            });
+        });
+        document.Find("spells").ForEachMember([this](std::string_view id, const JsonView& fields) {
+            Spell& spell = spells[Symbols::Intern(id)];
+            int index = 0;
+            fields.ForEachElement([&spell, &index](const JsonView& field) {
+                std::string* targets[] = { &spell.name, &spell.description };
+                if (index < 2) {
+                    *targets[index++] = field.String();
+                }
+            });
+        });
+    }
+    catch (const std::exception&) {
+        champions.Clear();
+        spells.Clear();
+        return false;
+    }
+    return !Empty();
+}
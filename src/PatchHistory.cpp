@@ -0,0 +1,397 @@
+#include "PatchHistory.h"
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr uint32_t kFileMagic = 0x5348504C;  // "LPHS"
+    constexpr uint32_t kFileFormat = 1;
+
+    const char* kChampionFieldNames[kBaseStatCount] = {
+        "Health", "Health per level", "Mana", "Mana per level", "Move Speed",
+        "Armor", "Armor per level", "Magic Resist", "Magic Resist per level", "Attack Range",
+        "Health Regen", "Health Regen per level", "Mana Regen", "Mana Regen per level",
+        "Crit", "Crit per level", "Attack Damage", "Attack Damage per level",
+        "Attack Speed per level", "Attack Speed"
+    };
+
+    // NaN stands for "not there yet" and compares equal to itself here
+    bool SameValue(float a, float b) {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+
+    void WriteU32(std::ofstream& out, uint32_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteU16(std::ofstream& out, uint16_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::ofstream& out, const std::string& value) {
+        WriteU32(out, static_cast<uint32_t>(value.size()));
+        out.write(value.data(), value.size());
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    // Patch names like "14.14.1" by their numbers, so "14.9" comes before "14.10"
+    int ComparePatches(const std::string& a, const std::string& b) {
+        size_t i = 0, j = 0;
+        while (i < a.size() || j < b.size()) {
+            unsigned long x = 0, y = 0;
+            for (; i < a.size() && a[i] != '.'; ++i) {
+                x = x * 10 + (a[i] >= '0' && a[i] <= '9' ? a[i] - '0' : 0);
+            }
+            for (; j < b.size() && b[j] != '.'; ++j) {
+                y = y * 10 + (b[j] >= '0' && b[j] <= '9' ? b[j] - '0' : 0);
+            }
+            if (x != y) {
+                return x < y ? -1 : 1;
+            }
+            ++i;
+            ++j;
+        }
+        return 0;
+    }
+
+    bool ReadString(std::ifstream& in, std::string& value) {
+        uint32_t size = 0;
+        if (!ReadValue(in, size) || size > (1u << 16)) {
+            return false;
+        }
+        value.resize(size);
+        return static_cast<bool>(in.read(value.data(), size));
+    }
+}
+
+size_t PatchHistory::FieldCount(Kind kind) {
+    return kind == Kind::Champion ? kBaseStatCount : kStatCount + 1;
+}
+
+const char* PatchHistory::FieldName(Kind kind, uint16_t field) {
+    if (field == PresenceField(kind)) {
+        return "Available";
+    }
+    if (kind == Kind::Champion) {
+        return field < kBaseStatCount ? kChampionFieldNames[field] : "";
+    }
+    return field == kItemCost ? "Cost" : StatName(static_cast<Stat>(field));
+}
+
+int PatchHistory::Direction(Kind kind, uint16_t field) {
+    if (field >= PresenceField(kind)) {
+        return 0;
+    }
+    return kind == Kind::Item && field == kItemCost ? -1 : 1;
+}
+
+int PatchHistory::Verdict(Kind kind, const Change& change) {
+    if (std::isnan(change.before) || std::isnan(change.after) || change.before == change.after) {
+        return 0;
+    }
+    int direction = Direction(kind, change.field);
+    return change.after > change.before ? direction : -direction;
+}
+
+uint16_t PatchHistory::AddPatch(const std::string& patch) {
+    int existing = FindPatch(patch);
+    if (existing >= 0) {
+        return static_cast<uint16_t>(existing);
+    }
+    patches.push_back(patch);
+    return static_cast<uint16_t>(patches.size() - 1);
+}
+
+int PatchHistory::FindPatch(const std::string& patch) const {
+    auto it = std::find(patches.begin(), patches.end(), patch);
+    return it == patches.end() ? -1 : static_cast<int>(it - patches.begin());
+}
+
+bool PatchHistory::Ingest(Kind kind, const std::string& patch, const std::vector<std::string>& ids, const std::vector<float>& values) {
+    Store& store = stores[static_cast<size_t>(kind)];
+    size_t fields = FieldCount(kind);
+    if (values.size() != ids.size() * fields) {
+        return false;
+    }
+    // Patches are numbered in the order they were added, and the runs rely on
+    // that being release order: a patch must be newer than this kind's newest,
+    // and a new name newer than every patch of either kind
+    if (!store.ingested.empty() && ComparePatches(patch, patches[store.ingested.back()]) <= 0) {
+        return false;
+    }
+    if (FindPatch(patch) < 0 && !patches.empty() &&
+        ComparePatches(patch, *std::max_element(patches.begin(), patches.end(),
+            [](const std::string& a, const std::string& b) { return ComparePatches(a, b) < 0; })) <= 0) {
+        return false;
+    }
+
+    uint16_t index = AddPatch(patch);
+    bool first = store.ingested.empty();
+    store.changes.resize(patches.size());
+    auto& changes = store.changes[index];
+    changes.clear();
+
+    // Only the newest run of each column is compared, so the cost of a patch
+    // does not grow with the number of patches kept
+    std::vector<bool> seen(store.ids.size(), false);
+    for (size_t row = 0; row < ids.size(); ++row) {
+        auto [it, added] = store.entities.emplace(ids[row], static_cast<uint32_t>(store.ids.size()));
+        uint32_t entity = it->second;
+        if (added) {
+            store.ids.push_back(ids[row]);
+            store.columns.resize(store.ids.size() * (fields + 1));
+            seen.push_back(false);
+        }
+        seen[entity] = true;
+
+        for (uint16_t field = 0; field < fields; ++field) {
+            auto& column = store.columns[entity * (fields + 1) + field];
+            float value = values[row * fields + field];
+            if (column.empty()) {
+                column.push_back({ index, value });
+            }
+            else if (!SameValue(column.back().value, value)) {
+                changes.push_back({ index, field, entity, column.back().value, value });
+                column.push_back({ index, value });
+            }
+        }
+
+        auto& presence = store.columns[entity * (fields + 1) + fields];
+        if (presence.empty() || presence.back().value == 0.0f) {
+            if (!presence.empty() || !first) {
+                changes.push_back({ index, static_cast<uint16_t>(fields), entity, 0.0f, 1.0f });
+            }
+            presence.push_back({ index, 1.0f });
+        }
+    }
+
+    // Entities the patch no longer lists keep their last values and are marked gone
+    for (uint32_t entity = 0; entity < seen.size(); ++entity) {
+        auto& presence = store.columns[entity * (fields + 1) + fields];
+        if (!seen[entity] && !presence.empty() && presence.back().value != 0.0f) {
+            changes.push_back({ index, static_cast<uint16_t>(fields), entity, 1.0f, 0.0f });
+            presence.push_back({ index, 0.0f });
+        }
+    }
+
+    store.ingested.push_back(index);
+    return true;
+}
+
+float PatchHistory::ValueAt(Kind kind, uint32_t entity, uint16_t field, uint16_t patch) const {
+    const Store& store = stores[static_cast<size_t>(kind)];
+    const auto& column = store.columns[entity * (FieldCount(kind) + 1) + field];
+    auto it = std::upper_bound(column.begin(), column.end(), patch,
+        [](uint16_t value, const Run& run) { return value < run.patch; });
+    if (it == column.begin()) {
+        return field == PresenceField(kind) ? 0.0f : std::nanf("");
+    }
+    return std::prev(it)->value;
+}
+
+std::vector<PatchHistory::Change> PatchHistory::EntityChanges(Kind kind, const std::string& id, size_t patchCount) const {
+    const Store& store = stores[static_cast<size_t>(kind)];
+    std::vector<Change> result;
+    auto it = store.entities.find(id);
+    if (it == store.entities.end() || store.ingested.empty()) {
+        return result;
+    }
+
+    size_t fields = FieldCount(kind);
+    size_t keep = std::min(patchCount, store.ingested.size());
+    uint16_t oldest = store.ingested[store.ingested.size() - keep];
+    for (uint16_t field = 0; field <= fields; ++field) {
+        const auto& column = store.columns[it->second * (fields + 1) + field];
+        for (size_t run = 0; run < column.size(); ++run) {
+            if (column[run].patch < oldest) {
+                continue;
+            }
+            if (run > 0) {
+                result.push_back({ column[run].patch, field, it->second, column[run - 1].value, column[run].value });
+            }
+            else if (field == fields && column[run].patch != store.ingested.front()) {
+                result.push_back({ column[run].patch, field, it->second, 0.0f, 1.0f });
+            }
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const Change& a, const Change& b) { return a.patch > b.patch; });
+    return result;
+}
+
+std::vector<PatchHistory::Change> PatchHistory::ChangesBetween(Kind kind, uint16_t from, uint16_t to, int field) const {
+    const Store& store = stores[static_cast<size_t>(kind)];
+    std::vector<Change> result;
+    if (from >= to || to >= store.changes.size()) {
+        return result;
+    }
+
+    // Only entities one of the patches in between touched can differ
+    std::vector<uint32_t> touched;
+    for (uint16_t patch = from + 1; patch <= to; ++patch) {
+        for (const auto& change : store.changes[patch]) {
+            if (field < 0 || change.field == field) {
+                touched.push_back(change.entity);
+            }
+        }
+    }
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+    uint16_t first = field < 0 ? 0 : static_cast<uint16_t>(field);
+    uint16_t last = field < 0 ? PresenceField(kind) : static_cast<uint16_t>(field);
+    for (uint32_t entity : touched) {
+        for (uint16_t f = first; f <= last; ++f) {
+            float before = ValueAt(kind, entity, f, from);
+            float after = ValueAt(kind, entity, f, to);
+            if (!SameValue(before, after) && !(std::isnan(before) && f != PresenceField(kind))) {
+                result.push_back({ to, f, entity, before, after });
+            }
+        }
+    }
+    return result;
+}
+
+const std::vector<PatchHistory::Change>& PatchHistory::PatchChanges(Kind kind, uint16_t patch) const {
+    static const std::vector<Change> none;
+    const Store& store = stores[static_cast<size_t>(kind)];
+    return patch < store.changes.size() ? store.changes[patch] : none;
+}
+
+void PatchHistory::RebuildChanges(Kind kind) {
+    // Every run after a column's first is a change; a first presence run later
+    // than the kind's first patch is an addition
+    Store& store = stores[static_cast<size_t>(kind)];
+    size_t fields = FieldCount(kind);
+    store.changes.assign(patches.size(), {});
+    for (uint32_t entity = 0; entity < store.ids.size(); ++entity) {
+        for (uint16_t field = 0; field <= fields; ++field) {
+            const auto& column = store.columns[entity * (fields + 1) + field];
+            for (size_t run = 1; run < column.size(); ++run) {
+                store.changes[column[run].patch].push_back({ column[run].patch, field, entity, column[run - 1].value, column[run].value });
+            }
+            if (field == fields && !column.empty() && !store.ingested.empty() && column[0].patch != store.ingested.front()) {
+                store.changes[column[0].patch].push_back({ column[0].patch, field, entity, 0.0f, 1.0f });
+            }
+        }
+    }
+}
+
+bool PatchHistory::Save(const std::filesystem::path& path) const {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open " << temporary << " for writing" << std::endl;
+            return false;
+        }
+
+        WriteU32(out, kFileMagic);
+        WriteU32(out, kFileFormat);
+        WriteU32(out, static_cast<uint32_t>(patches.size()));
+        for (const auto& patch : patches) {
+            WriteString(out, patch);
+        }
+        for (const Store& store : stores) {
+            WriteU32(out, static_cast<uint32_t>(store.ingested.size()));
+            for (uint16_t patch : store.ingested) {
+                WriteU16(out, patch);
+            }
+            WriteU32(out, static_cast<uint32_t>(store.ids.size()));
+            for (const auto& id : store.ids) {
+                WriteString(out, id);
+            }
+            for (const auto& column : store.columns) {
+                WriteU32(out, static_cast<uint32_t>(column.size()));
+                for (const Run& run : column) {
+                    WriteU16(out, run.patch);
+                    out.write(reinterpret_cast<const char*>(&run.value), sizeof(run.value));
+                }
+            }
+        }
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to write patch history: " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PatchHistory::Load(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint32_t magic = 0, format = 0, patchCount = 0;
+    if (!ReadValue(in, magic) || magic != kFileMagic || !ReadValue(in, format) || format != kFileFormat ||
+        !ReadValue(in, patchCount) || patchCount > UINT16_MAX) {
+        return false;
+    }
+    std::vector<std::string> loadedPatches(patchCount);
+    for (auto& patch : loadedPatches) {
+        if (!ReadString(in, patch)) {
+            return false;
+        }
+    }
+
+    Store loaded[static_cast<size_t>(Kind::Count)];
+    for (size_t kind = 0; kind < static_cast<size_t>(Kind::Count); ++kind) {
+        Store& store = loaded[kind];
+        size_t fields = FieldCount(static_cast<Kind>(kind));
+        uint32_t ingestedCount = 0, entityCount = 0;
+        if (!ReadValue(in, ingestedCount) || ingestedCount > patchCount) {
+            return false;
+        }
+        store.ingested.resize(ingestedCount);
+        for (auto& patch : store.ingested) {
+            if (!ReadValue(in, patch) || patch >= patchCount) {
+                return false;
+            }
+        }
+        if (!ReadValue(in, entityCount)) {
+            return false;
+        }
+        for (uint32_t entity = 0; entity < entityCount; ++entity) {
+            std::string id;
+            if (!ReadString(in, id)) {
+                return false;
+            }
+            store.entities[id] = entity;
+            store.ids.push_back(std::move(id));
+        }
+        store.columns.resize(static_cast<size_t>(entityCount) * (fields + 1));
+        for (auto& column : store.columns) {
+            uint32_t runCount = 0;
+            if (!ReadValue(in, runCount) || runCount > ingestedCount) {
+                return false;
+            }
+            column.resize(runCount);
+            for (Run& run : column) {
+                if (!ReadValue(in, run.patch) || run.patch >= patchCount || !ReadValue(in, run.value)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    patches = std::move(loadedPatches);
+    for (size_t kind = 0; kind < static_cast<size_t>(Kind::Count); ++kind) {
+        stores[kind] = std::move(loaded[kind]);
+        RebuildChanges(static_cast<Kind>(kind));
+    }
+    return true;
+}
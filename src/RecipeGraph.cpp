@@ -0,0 +1,112 @@
+#include "RecipeGraph.h"
+#include <algorithm>
+
+namespace {
+    // Flattens per-item lists into offsets + edges.
+    void Compile(const std::vector<std::vector<uint32_t>>& rows, std::vector<uint32_t>& offsets, std::vector<uint32_t>& edges) {
+        offsets.assign(rows.size() + 1, 0);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            offsets[i + 1] = offsets[i] + static_cast<uint32_t>(rows[i].size());
+        }
+        edges.clear();
+        edges.reserve(offsets.back());
+        for (const auto& row : rows) {
+            edges.insert(edges.end(), row.begin(), row.end());
+        }
+    }
+
+    // Breadth-first closure of every item over one edge direction.
+    void Closure(const std::vector<std::vector<uint32_t>>& next, std::vector<uint32_t>& offsets, std::vector<uint32_t>& edges) {
+        size_t count = next.size();
+        std::vector<uint32_t> seen(count, UINT32_MAX);
+        std::vector<std::vector<uint32_t>> rows(count);
+        for (uint32_t item = 0; item < count; ++item) {
+            auto& row = rows[item];
+            seen[item] = item;
+            for (size_t head = 0;; ++head) {
+                const auto& neighbours = head == 0 ? next[item] : next[row[head - 1]];
+                for (uint32_t neighbour : neighbours) {
+                    if (seen[neighbour] != item) {
+                        seen[neighbour] = item;
+                        row.push_back(neighbour);
+                    }
+                }
+                if (head >= row.size()) {
+                    break;
+                }
+            }
+        }
+        Compile(rows, offsets, edges);
+    }
+}
+
+void RecipeGraph::Build(const std::vector<std::vector<uint32_t>>& components, const std::vector<int>& totalCost) {
+    size_t count = components.size();
+
+    std::vector<std::vector<uint32_t>> parents(count);
+    std::vector<std::vector<uint32_t>> distinctComponents(count);
+    for (uint32_t item = 0; item < count; ++item) {
+        for (uint32_t component : components[item]) {
+            if (component >= count || component == item) {
+                continue;
+            }
+            auto& distinct = distinctComponents[item];
+            if (std::find(distinct.begin(), distinct.end(), component) == distinct.end()) {
+                distinct.push_back(component);
+                parents[component].push_back(item);
+            }
+        }
+    }
+
+    Compile(components, componentOffsets, componentEdges);
+    Compile(parents, parentOffsets, parentEdges);
+    Closure(parents, upgradeOffsets, upgradeEdges);
+    Closure(distinctComponents, treeOffsets, treeEdges);
+
+    // Rollups in post-order; an item still on the stack is skipped, so a
+    // malformed cyclic recipe cannot recurse forever.
+    enum : uint8_t { Unvisited, Visiting, Done };
+    std::vector<uint8_t> state(count, Unvisited);
+    combineCost.assign(count, 0);
+    treeCost.assign(count, 0);
+    depth.assign(count, 0);
+
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    for (uint32_t root = 0; root < count; ++root) {
+        if (state[root] != Unvisited) {
+            continue;
+        }
+        stack.push_back({ root, 0 });
+        state[root] = Visiting;
+        while (!stack.empty()) {
+            auto& [item, next] = stack.back();
+            Range row = Components(item);
+            if (next < row.size()) {
+                uint32_t component = row[next++];
+                if (component < count && state[component] == Unvisited) {
+                    state[component] = Visiting;
+                    stack.push_back({ component, 0 });
+                }
+                continue;
+            }
+
+            int price = std::max(0, item < totalCost.size() ? totalCost[item] : 0);
+            int componentsPrice = 0;
+            int componentsTree = 0;
+            int deepest = -1;
+            for (uint32_t component : row) {
+                if (component >= count || state[component] != Done) {
+                    continue;
+                }
+                componentsPrice += std::max(0, totalCost[component]);
+                componentsTree += treeCost[component];
+                deepest = std::max(deepest, depth[component]);
+            }
+            combineCost[item] = std::max(0, price - componentsPrice);
+            treeCost[item] = combineCost[item] + componentsTree;
+            depth[item] = deepest + 1;
+            state[item] = Done;
+            stack.pop_back();
+        }
+    }
+}
@@ -0,0 +1,285 @@
+#include "RichText.h"
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+
+namespace {
+    constexpr size_t kMaxLayouts = 4;
+
+    struct TagStyle {
+        const char* tag;
+        RichText::Style style;
+    };
+
+    // Tag names are compared lower case
+    const TagStyle kTagStyles[] = {
+        { "b", RichText::Style::Emphasis }, { "strong", RichText::Style::Emphasis },
+        { "active", RichText::Style::Emphasis }, { "passive", RichText::Style::Emphasis },
+        { "spellname", RichText::Style::Emphasis }, { "spellpassive", RichText::Style::Emphasis },
+        { "spellactive", RichText::Style::Emphasis }, { "attention", RichText::Style::Emphasis },
+        { "keywordmajor", RichText::Style::Emphasis }, { "raritymythic", RichText::Style::Emphasis },
+        { "raritylegendary", RichText::Style::Emphasis }, { "font", RichText::Style::Emphasis },
+        { "physicaldamage", RichText::Style::Physical }, { "scalead", RichText::Style::Physical },
+        { "scalebonusad", RichText::Style::Physical },
+        { "magicdamage", RichText::Style::Magic }, { "scaleap", RichText::Style::Magic },
+        { "truedamage", RichText::Style::True },
+        { "healing", RichText::Style::Heal }, { "lifesteal", RichText::Style::Heal },
+        { "scalehealth", RichText::Style::Heal },
+        { "shield", RichText::Style::Shield },
+        { "status", RichText::Style::Status }, { "keywordstealth", RichText::Style::Status },
+        { "speed", RichText::Style::Status },
+        { "scalelevel", RichText::Style::Scaling }, { "scalemana", RichText::Style::Scaling },
+        { "scalearmor", RichText::Style::Scaling }, { "scalemr", RichText::Style::Scaling },
+        { "rules", RichText::Style::Muted }, { "flavortext", RichText::Style::Muted }, { "i", RichText::Style::Muted },
+    };
+
+    const std::pair<const char*, const char*> kEntities[] = {
+        { "&nbsp;", " " }, { "&amp;", "&" }, { "&lt;", "<" }, { "&gt;", ">" },
+        { "&quot;", "\"" }, { "&#39;", "'" }
+    };
+
+    bool FindTagStyle(const std::string& tag, RichText::Style& style) {
+        for (const auto& entry : kTagStyles) {
+            if (tag == entry.tag) {
+                style = entry.style;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+ImVec4 RichText::StyleColor(Style style) {
+    switch (style) {
+    case Style::Emphasis: return ImVec4(0.8431f, 0.7255f, 0.4745f, 1.0f);
+    case Style::Physical: return ImVec4(1.0f, 0.55f, 0.25f, 1.0f);
+    case Style::Magic: return ImVec4(0.45f, 0.65f, 1.0f, 1.0f);
+    case Style::True: return ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+    case Style::Heal: return ImVec4(0.4f, 0.85f, 0.4f, 1.0f);
+    case Style::Shield: return ImVec4(0.75f, 0.85f, 0.9f, 1.0f);
+    case Style::Status: return ImVec4(0.8f, 0.55f, 0.95f, 1.0f);
+    case Style::Scaling: return ImVec4(0.6f, 0.85f, 0.8f, 1.0f);
+    case Style::Muted: return ImVec4(0.6f, 0.6f, 0.6f, 1.0f);
+    default: return ImGui::GetStyleColorVec4(ImGuiCol_Text);
+    }
+}
+
+RichText::RichText(const std::string& markup) {
+    Parse(markup);
+}
+
+void RichText::Parse(const std::string& markup) {
+    text.clear();
+    spans.clear();
+    text.reserve(markup.size());
+
+    // Open tags and the style each one set; unknown tags keep the style
+    // around them so their closing tag still pops the right entry
+    std::vector<std::pair<std::string, Style>> stack;
+    auto current = [&stack] { return stack.empty() ? Style::Normal : stack.back().second; };
+    auto append = [this, &current](const char* begin, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            char c = begin[i];
+            if (c == '\r' || c == '\t') c = ' ';
+            // Collapse runs of spaces and drop spaces at the start of a line
+            if (c == ' ' && (text.empty() || text.back() == ' ' || text.back() == '\n')) continue;
+            if (c == '\n' && !text.empty() && text.back() == ' ') text.pop_back();
+            Style style = current();
+            uint32_t position = static_cast<uint32_t>(text.size());
+            if (spans.empty() || spans.back().style != style || spans.back().end != position) {
+                spans.push_back({ position, position, style });
+            }
+            text.push_back(c);
+            spans.back().end = position + 1;
+        }
+    };
+
+    for (size_t i = 0; i < markup.size();) {
+        char c = markup[i];
+        if (c == '<') {
+            size_t end = markup.find('>', i);
+            if (end == std::string::npos) {
+                break;
+            }
+            std::string tag = markup.substr(i + 1, end - i - 1);
+            i = end + 1;
+
+            bool closing = !tag.empty() && tag[0] == '/';
+            bool selfClosing = !tag.empty() && tag.back() == '/';
+            size_t nameBegin = closing ? 1 : 0;
+            size_t nameEnd = nameBegin;
+            while (nameEnd < tag.size() && std::isalnum(static_cast<unsigned char>(tag[nameEnd]))) ++nameEnd;
+            std::string name = tag.substr(nameBegin, nameEnd - nameBegin);
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+
+            if (name == "br") {
+                append("\n", 1);
+            }
+            else if (name == "li" && !closing) {
+                if (!text.empty() && text.back() != '\n') append("\n", 1);
+                append("- ", 2);
+            }
+            else if (closing) {
+                auto open = std::find_if(stack.rbegin(), stack.rend(), [&name](const auto& entry) { return entry.first == name; });
+                if (open != stack.rend()) {
+                    stack.erase(std::next(open).base(), stack.end());
+                }
+            }
+            else if (!selfClosing && !name.empty()) {
+                Style style = current();
+                FindTagStyle(name, style);
+                stack.push_back({ name, style });
+            }
+            continue;
+        }
+        if (c == '{' && i + 1 < markup.size() && markup[i + 1] == '{') {
+            // Tooltip placeholders like {{ e1 }} have no value here
+            size_t end = markup.find("}}", i);
+            i = (end == std::string::npos) ? markup.size() : end + 2;
+            continue;
+        }
+        if (c == '&') {
+            bool matched = false;
+            for (const auto& [entity, replacement] : kEntities) {
+                size_t length = std::char_traits<char>::length(entity);
+                if (markup.compare(i, length, entity) == 0) {
+                    append(replacement, std::char_traits<char>::length(replacement));
+                    i += length;
+                    matched = true;
+                    break;
+                }
+            }
+            if (matched) {
+                continue;
+            }
+        }
+        append(&markup[i], 1);
+        ++i;
+    }
+
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\n')) {
+        text.pop_back();
+    }
+    while (!spans.empty() && spans.back().begin >= text.size()) {
+        spans.pop_back();
+    }
+    if (!spans.empty()) {
+        spans.back().end = std::min<uint32_t>(spans.back().end, static_cast<uint32_t>(text.size()));
+    }
+}
+
+const RichText::Layout& RichText::GetLayout(const ImFont* font, float fontSize, float width) const {
+    auto found = std::find_if(layouts.begin(), layouts.end(), [&](const Layout& layout) {
+        return layout.font == font && layout.fontSize == fontSize && layout.width == width;
+    });
+    if (found != layouts.end()) {
+        if (found != layouts.begin()) {
+            std::rotate(layouts.begin(), found, found + 1);
+        }
+        return layouts.front();
+    }
+
+    Layout layout;
+    layout.font = font;
+    layout.fontSize = fontSize;
+    layout.width = width;
+    BuildLayout(layout);
+    if (layouts.size() >= kMaxLayouts) {
+        layouts.pop_back();
+    }
+    layouts.insert(layouts.begin(), std::move(layout));
+    return layouts.front();
+}
+
+void RichText::BuildLayout(Layout& layout) const {
+    ImFont* font = const_cast<ImFont*>(layout.font);
+    auto measure = [&](uint32_t begin, uint32_t end) {
+        return font->CalcTextSizeA(layout.fontSize, FLT_MAX, 0.0f, text.data() + begin, text.data() + end).x;
+    };
+    const char space = ' ';
+    float spaceWidth = font->CalcTextSizeA(layout.fontSize, FLT_MAX, 0.0f, &space, &space + 1).x;
+
+    layout.segments.clear();
+    layout.lineStarts.assign(1, 0);
+    auto newLine = [&layout] { layout.lineStarts.push_back(static_cast<uint32_t>(layout.segments.size())); };
+
+    // Words are placed one at a time; a word that continues a segment of the
+    // same style on the same line extends it, spaces included, so a line is
+    // usually one segment per colour.
+    float x = 0.0f;
+    size_t span = 0;
+    uint32_t position = 0;
+    uint32_t size = static_cast<uint32_t>(text.size());
+    while (position < size) {
+        char c = text[position];
+        if (c == '\n') {
+            newLine();
+            x = 0.0f;
+            ++position;
+            continue;
+        }
+        if (c == ' ') {
+            if (x > 0.0f) x += spaceWidth;
+            ++position;
+            continue;
+        }
+
+        uint32_t wordEnd = position;
+        while (wordEnd < size && text[wordEnd] != ' ' && text[wordEnd] != '\n') ++wordEnd;
+        float wordWidth = measure(position, wordEnd);
+        if (x > 0.0f && x + wordWidth > layout.width) {
+            newLine();
+            x = 0.0f;
+        }
+
+        // Split the word at span boundaries
+        uint32_t pieceBegin = position;
+        while (pieceBegin < wordEnd) {
+            while (span + 1 < spans.size() && spans[span].end <= pieceBegin) ++span;
+            Style style = span < spans.size() ? spans[span].style : Style::Normal;
+            uint32_t pieceEnd = span < spans.size() ? std::min(wordEnd, std::max(spans[span].end, pieceBegin + 1)) : wordEnd;
+
+            bool lineHasSegment = layout.segments.size() > layout.lineStarts.back();
+            Segment* last = lineHasSegment ? &layout.segments.back() : nullptr;
+            if (last && last->style == style) {
+                last->end = pieceEnd;
+            }
+            else {
+                layout.segments.push_back({ pieceBegin, pieceEnd, style, x });
+            }
+            x += measure(pieceBegin, pieceEnd);
+            pieceBegin = pieceEnd;
+        }
+        position = wordEnd;
+    }
+    layout.lineStarts.push_back(static_cast<uint32_t>(layout.segments.size()));
+}
+
+void RichText::Render() const {
+    ImFont* font = ImGui::GetFont();
+    float fontSize = ImGui::GetFontSize();
+    float width = std::max(1.0f, ImGui::GetContentRegionAvail().x);
+    const Layout& layout = GetLayout(font, fontSize, width);
+
+    size_t lineCount = layout.lineStarts.size() - 1;
+    float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    // Only lines inside the clip rect are drawn
+    float clipTop = drawList->GetClipRectMin().y;
+    float clipBottom = drawList->GetClipRectMax().y;
+    size_t first = origin.y < clipTop ? static_cast<size_t>((clipTop - origin.y) / lineHeight) : 0;
+    for (size_t line = first; line < lineCount; ++line) {
+        float y = origin.y + line * lineHeight;
+        if (y > clipBottom) {
+            break;
+        }
+        for (uint32_t s = layout.lineStarts[line]; s < layout.lineStarts[line + 1]; ++s) {
+            const Segment& segment = layout.segments[s];
+            drawList->AddText(font, fontSize, ImVec2(origin.x + segment.x, y), ImGui::GetColorU32(StyleColor(segment.style)),
+                text.data() + segment.begin, text.data() + segment.end);
+        }
+    }
+    ImGui::Dummy(ImVec2(width, std::max(1.0f, lineCount * lineHeight - ImGui::GetStyle().ItemSpacing.y)));
+}
@@ -0,0 +1,501 @@
+#include "SearchIndex.h"
+#include <algorithm>
+
+namespace {
+    // Results below this count trigger the typo-tolerant pass.
+    constexpr size_t kFuzzyThreshold = 8;
+    // Upper bound on edit-distance checks per fuzzy pass, taken in order of bigram overlap.
+    constexpr size_t kMaxFuzzyCandidates = 512;
+    // Grams at a word boundary, and at the start of the name, are also stored
+    // under tagged keys.
+    constexpr uint32_t kWordStartTag = 4;
+    constexpr uint32_t kPrefixTag = 8;
+
+    struct FoldRange {
+        uint32_t first;
+        uint32_t last;
+        const char* ascii;
+    };
+
+    // Latin-1 Supplement and Latin Extended-A folded to their ASCII base letters.
+    const FoldRange kFoldTable[] = {
+        { 0x00C0, 0x00C5, "a" }, { 0x00C6, 0x00C6, "ae" }, { 0x00C7, 0x00C7, "c" },
+        { 0x00C8, 0x00CB, "e" }, { 0x00CC, 0x00CF, "i" }, { 0x00D0, 0x00D0, "d" },
+        { 0x00D1, 0x00D1, "n" }, { 0x00D2, 0x00D6, "o" }, { 0x00D8, 0x00D8, "o" },
+        { 0x00D9, 0x00DC, "u" }, { 0x00DD, 0x00DD, "y" }, { 0x00DE, 0x00DE, "th" },
+        { 0x00DF, 0x00DF, "ss" }, { 0x00E0, 0x00E5, "a" }, { 0x00E6, 0x00E6, "ae" },
+        { 0x00E7, 0x00E7, "c" }, { 0x00E8, 0x00EB, "e" }, { 0x00EC, 0x00EF, "i" },
+        { 0x00F0, 0x00F0, "d" }, { 0x00F1, 0x00F1, "n" }, { 0x00F2, 0x00F6, "o" },
+        { 0x00F8, 0x00F8, "o" }, { 0x00F9, 0x00FC, "u" }, { 0x00FD, 0x00FD, "y" },
+        { 0x00FE, 0x00FE, "th" }, { 0x00FF, 0x00FF, "y" },
+        { 0x0100, 0x0105, "a" }, { 0x0106, 0x010D, "c" }, { 0x010E, 0x0111, "d" },
+        { 0x0112, 0x011B, "e" }, { 0x011C, 0x0123, "g" }, { 0x0124, 0x0127, "h" },
+        { 0x0128, 0x0131, "i" }, { 0x0132, 0x0133, "ij" }, { 0x0134, 0x0135, "j" },
+        { 0x0136, 0x0138, "k" }, { 0x0139, 0x0142, "l" }, { 0x0143, 0x014B, "n" },
+        { 0x014C, 0x0151, "o" }, { 0x0152, 0x0153, "oe" }, { 0x0154, 0x0159, "r" },
+        { 0x015A, 0x0161, "s" }, { 0x0162, 0x0167, "t" }, { 0x0168, 0x0173, "u" },
+        { 0x0174, 0x0175, "w" }, { 0x0176, 0x0178, "y" }, { 0x0179, 0x017E, "z" },
+        { 0x017F, 0x017F, "s" },
+    };
+
+    const char* FoldCodepoint(uint32_t cp) {
+        for (const auto& range : kFoldTable) {
+            if (cp >= range.first && cp <= range.last) {
+                return range.ascii;
+            }
+        }
+        return nullptr;
+    }
+
+    uint32_t PackGram(const char* gram, size_t length, uint32_t tag = 0) {
+        uint32_t key = static_cast<uint32_t>(length + tag) << 24;
+        for (size_t i = 0; i < length; ++i) {
+            key |= static_cast<uint32_t>(static_cast<unsigned char>(gram[i])) << (8 * i);
+        }
+        return key;
+    }
+
+    bool IsWordStart(std::string_view text, size_t pos) {
+        return pos == 0 || text[pos - 1] == ' ';
+    }
+}
+
+std::string SearchIndex::Normalize(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    bool pendingSpace = false;
+
+    auto append = [&](const char* s, size_t n) {
+        if (pendingSpace && !out.empty()) {
+            out.push_back(' ');
+        }
+        pendingSpace = false;
+        out.append(s, n);
+    };
+
+    for (size_t i = 0; i < text.size();) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            ++i;
+            if (c >= 'A' && c <= 'Z') {
+                char lower = static_cast<char>(c - 'A' + 'a');
+                append(&lower, 1);
+            }
+            else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                char keep = static_cast<char>(c);
+                append(&keep, 1);
+            }
+            else if (c == ' ' || c == '-' || c == '_' || c == '/' || c == '\t') {
+                pendingSpace = true;
+            }
+            // Apostrophes, dots and other punctuation are dropped ("Kai'Sa" -> "kaisa").
+            continue;
+        }
+
+        // Decode one UTF-8 sequence.
+        size_t length = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 1;
+        if (i + length > text.size()) {
+            break;
+        }
+        uint32_t cp = (length == 1) ? c : (c & (0x7F >> length));
+        for (size_t k = 1; k < length; ++k) {
+            cp = (cp << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+        }
+
+        if (const char* folded = FoldCodepoint(cp)) {
+            append(folded, std::char_traits<char>::length(folded));
+        }
+        else {
+            append(text.data() + i, length);
+        }
+        i += length;
+    }
+    return out;
+}
+
+namespace {
+    // Optimal string alignment distance between a and the closest prefix of b,
+    // exiting early once every cell of a row exceeds maxDistance.
+    int BoundedPrefixDistance(const char* a, size_t aLen, const char* b, size_t bLen,
+                              size_t minPrefix, int maxDistance) {
+        constexpr size_t kMaxLength = 64;
+        if (aLen >= kMaxLength || bLen >= kMaxLength) {
+            return maxDistance + 1;
+        }
+
+        int rows[3][kMaxLength + 1];
+        int* prevPrev = rows[0];
+        int* prev = rows[1];
+        int* cur = rows[2];
+        for (size_t j = 0; j <= bLen; ++j) {
+            prev[j] = static_cast<int>(j);
+        }
+
+        for (size_t i = 1; i <= aLen; ++i) {
+            cur[0] = static_cast<int>(i);
+            int rowMin = cur[0];
+            for (size_t j = 1; j <= bLen; ++j) {
+                int cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+                int value = std::min(std::min(prev[j], cur[j - 1]) + 1, prev[j - 1] + cost);
+                if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                    value = std::min(value, prevPrev[j - 2] + 1);
+                }
+                cur[j] = value;
+                rowMin = std::min(rowMin, value);
+            }
+            if (rowMin > maxDistance) {
+                return maxDistance + 1;
+            }
+            std::swap(prevPrev, prev);
+            std::swap(prev, cur);
+        }
+
+        int best = maxDistance + 1;
+        for (size_t j = minPrefix; j <= bLen; ++j) {
+            best = std::min(best, prev[j]);
+        }
+        return best;
+    }
+}
+
+int SearchIndex::BoundedEditDistance(const char* a, size_t aLen, const char* b, size_t bLen, int maxDistance) {
+    if (static_cast<int>(aLen > bLen ? aLen - bLen : bLen - aLen) > maxDistance) {
+        return maxDistance + 1;
+    }
+    return BoundedPrefixDistance(a, aLen, b, bLen, bLen, maxDistance);
+}
+
+void SearchIndex::SetEntries(EntityKind kind, const std::vector<std::string>& names) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+        [kind](const Entry& entry) { return entry.kind == kind; }), entries.end());
+
+    entries.reserve(entries.size() + names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        entries.push_back({ kind, static_cast<int>(i), names[i] });
+    }
+    Rebuild();
+}
+
+void SearchIndex::Clear() {
+    entries.clear();
+    pool.clear();
+    offsets.assign(1, 0);
+    kindOf.clear();
+    postings.clear();
+    ++generation;
+}
+
+void SearchIndex::Rebuild() {
+    pool.clear();
+    offsets.assign(1, 0);
+    kindOf.clear();
+    kindOf.reserve(entries.size());
+    for (const auto& entry : entries) {
+        pool += Normalize(entry.display);
+        offsets.push_back(static_cast<uint32_t>(pool.size()));
+        kindOf.push_back(static_cast<uint8_t>(entry.kind));
+    }
+
+    // Visiting names shortest first leaves every posting list ordered by name
+    // length, which is the ranking order within a prefix or word-start tier.
+    std::vector<uint32_t> order(entries.size());
+    for (uint32_t id = 0; id < order.size(); ++id) {
+        order[id] = id;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return GetNormalized(a).size() < GetNormalized(b).size();
+    });
+
+    postings.clear();
+    auto addPosting = [this](uint32_t key, uint32_t id) {
+        // Each id is added in one go, so a repeated gram is always at the back.
+        auto& list = postings[key];
+        if (list.empty() || list.back() != id) {
+            list.push_back(id);
+        }
+    };
+    for (uint32_t id : order) {
+        std::string_view text = GetNormalized(id);
+        for (size_t n = 1; n <= 3; ++n) {
+            for (size_t pos = 0; pos + n <= text.size(); ++pos) {
+                addPosting(PackGram(text.data() + pos, n), id);
+                if (IsWordStart(text, pos)) {
+                    addPosting(PackGram(text.data() + pos, n, kWordStartTag), id);
+                }
+                if (pos == 0) {
+                    addPosting(PackGram(text.data(), n, kPrefixTag), id);
+                }
+            }
+        }
+    }
+    ++generation;
+}
+
+const std::vector<uint32_t>* SearchIndex::FindPosting(const char* gram, size_t length, uint32_t tag) const {
+    auto it = postings.find(PackGram(gram, length, tag));
+    return it != postings.end() ? &it->second : nullptr;
+}
+
+const std::vector<uint32_t>* SearchIndex::ShortestPosting(const std::string& query) const {
+    size_t gramLength = std::min<size_t>(query.size(), 3);
+    const std::vector<uint32_t>* shortest = nullptr;
+    for (size_t pos = 0; pos + gramLength <= query.size(); ++pos) {
+        const auto* list = FindPosting(query.data() + pos, gramLength);
+        if (list == nullptr) {
+            return nullptr;  // a missing gram means nothing can match
+        }
+        if (shortest == nullptr || list->size() < shortest->size()) {
+            shortest = list;
+        }
+    }
+    return shortest;
+}
+
+void SearchIndex::FilterExact(const std::vector<uint32_t>& candidates, const std::string& query,
+                              uint32_t kinds, bool needsVerify, std::vector<uint32_t>& out) const {
+    std::vector<uint32_t> filtered;
+    const std::vector<uint32_t>* source = &candidates;
+    if (&candidates == &out) {
+        filtered.swap(out);
+        source = &filtered;
+    }
+    out.clear();
+    out.reserve(source->size());
+    for (uint32_t id : *source) {
+        if (!Accepts(id, kinds)) {
+            continue;
+        }
+        if (needsVerify && GetNormalized(id).find(query) == std::string_view::npos) {
+            continue;
+        }
+        out.push_back(id);
+    }
+}
+
+bool SearchIndex::CollectTier(Session& session, const std::string& query, uint32_t kinds, size_t maxResults) const {
+    // Top-K for short queries straight from the length-ordered tier lists: all
+    // prefix matches outrank all other word-start matches, which outrank all
+    // mid-word matches, and within a tier shorter names score higher.
+    const auto* prefixes = FindPosting(query.data(), query.size(), kPrefixTag);
+    const auto* wordStarts = FindPosting(query.data(), query.size(), kWordStartTag);
+    if (prefixes == nullptr || wordStarts == nullptr) {
+        return false;
+    }
+
+    auto& results = session.results;
+    auto take = [&](const std::vector<uint32_t>& list, bool skipPrefixes) {
+        size_t cutoffLength = 0;
+        for (uint32_t id : list) {
+            if (!Accepts(id, kinds)) {
+                continue;
+            }
+            std::string_view text = GetNormalized(id);
+            if (skipPrefixes && text.compare(0, query.size(), query) == 0) {
+                continue;
+            }
+            // Keep going past the K-th entry while names tie on length, so the
+            // final sort can order ties alphabetically.
+            if (results.size() >= maxResults) {
+                if (cutoffLength == 0) {
+                    cutoffLength = GetNormalized(results.back().entry).size();
+                }
+                if (text.size() > cutoffLength) {
+                    break;
+                }
+            }
+            results.push_back({ id, ScoreExact(id, query) });
+        }
+    };
+
+    take(*prefixes, false);
+    if (results.size() < maxResults) {
+        take(*wordStarts, true);
+    }
+    if (results.size() < maxResults) {
+        results.clear();
+        return false;
+    }
+    return true;
+}
+
+int SearchIndex::ScoreExact(uint32_t id, const std::string& query) const {
+    std::string_view text = GetNormalized(id);
+    int lengthPenalty = static_cast<int>(std::min<size_t>(text.size() - query.size(), 99));
+    if (text == query) {
+        return 1000;
+    }
+    if (text.compare(0, query.size(), query) == 0) {
+        return 800 - lengthPenalty;
+    }
+    for (size_t pos = text.find(query); pos != std::string_view::npos; pos = text.find(query, pos + 1)) {
+        if (IsWordStart(text, pos)) {
+            return 600 - lengthPenalty;
+        }
+    }
+    return 400 - lengthPenalty;
+}
+
+void SearchIndex::CollectFuzzy(Session& session, const std::string& query, uint32_t kinds) const {
+    if (query.size() < 3) {
+        return;
+    }
+    int maxDistance = query.size() <= 5 ? 1 : 2;
+    int bigramCount = static_cast<int>(query.size()) - 1;
+    int required = bigramCount - 2 * maxDistance;
+    if (required < 1) {
+        required = 1;
+    }
+
+    auto& counts = session.scratch;
+    auto& touched = session.touched;
+    if (counts.size() != entries.size()) {
+        counts.assign(entries.size(), 0);
+    }
+    touched.clear();
+
+    // Count shared bigrams per entry; a name within maxDistance edits of the query
+    // keeps at least bigramCount - 2 * maxDistance of them.
+    for (size_t pos = 0; pos + 2 <= query.size(); ++pos) {
+        bool seen = false;
+        for (size_t prev = 0; prev < pos && !seen; ++prev) {
+            seen = query.compare(prev, 2, query, pos, 2) == 0;
+        }
+        if (seen) {
+            continue;
+        }
+        if (const auto* list = FindPosting(query.data() + pos, 2)) {
+            for (uint32_t id : *list) {
+                if (counts[id]++ == 0) {
+                    touched.push_back(id);
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> alreadyMatched(session.matches);
+    std::sort(alreadyMatched.begin(), alreadyMatched.end());
+
+    // Bucket candidates by overlap so the edit-distance budget goes to the
+    // names sharing the most bigrams with the query.
+    std::vector<std::vector<uint32_t>> byOverlap(bigramCount + 1);
+    for (uint32_t id : touched) {
+        int shared = std::min<int>(counts[id], bigramCount);
+        counts[id] = 0;
+        if (shared < required || !Accepts(id, kinds) ||
+            std::binary_search(alreadyMatched.begin(), alreadyMatched.end(), id)) {
+            continue;
+        }
+        byOverlap[shared].push_back(id);
+    }
+
+    size_t budget = kMaxFuzzyCandidates;
+    for (int shared = bigramCount; shared >= required && budget > 0; --shared) {
+        for (uint32_t id : byOverlap[shared]) {
+            if (budget == 0) {
+                break;
+            }
+            --budget;
+
+            // Compare against the text following each word start, taking the best
+            // window up to maxDistance characters shorter or longer than the query.
+            std::string_view text = GetNormalized(id);
+            size_t minWindow = query.size() > static_cast<size_t>(maxDistance) ? query.size() - maxDistance : 1;
+            int best = maxDistance + 1;
+            for (size_t start = 0; start < text.size() && best > 0; ++start) {
+                if (!IsWordStart(text, start)) {
+                    continue;
+                }
+                size_t window = std::min(text.size() - start, query.size() + maxDistance);
+                if (window < minWindow) {
+                    continue;
+                }
+                best = std::min(best, BoundedPrefixDistance(query.data(), query.size(),
+                    text.data() + start, window, minWindow, maxDistance));
+            }
+            if (best <= maxDistance) {
+                int lengthPenalty = static_cast<int>(std::min<size_t>(text.size(), 99));
+                session.results.push_back({ id, 200 - 50 * best - lengthPenalty });
+            }
+        }
+    }
+}
+
+const std::vector<SearchIndex::Result>& SearchIndex::Query(Session& session, const std::string& rawQuery,
+                                                           uint32_t kinds, size_t maxResults) const {
+    std::string query = Normalize(rawQuery);
+    bool sameIndex = session.generation == generation && session.lastKinds == kinds;
+    if (sameIndex && query == session.lastQuery && session.lastMaxResults == maxResults) {
+        return session.results;
+    }
+
+    bool couldNarrow = sameIndex && session.hasMatches && !session.lastQuery.empty() &&
+        query.size() > session.lastQuery.size() &&
+        query.compare(0, session.lastQuery.size(), session.lastQuery) == 0;
+
+    session.results.clear();
+    session.lastQuery = query;
+    session.lastKinds = kinds;
+    session.lastMaxResults = maxResults;
+    session.generation = generation;
+
+    if (query.empty()) {
+        session.hasMatches = false;
+        for (uint32_t id = 0; id < entries.size(); ++id) {
+            if (Accepts(id, kinds)) {
+                session.results.push_back({ id, 0 });
+                if (maxResults != 0 && session.results.size() >= maxResults) {
+                    break;
+                }
+            }
+        }
+        return session.results;
+    }
+
+    auto better = [this](const Result& a, const Result& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return entries[a.entry].display < entries[b.entry].display;
+    };
+    auto finish = [&]() -> const std::vector<Result>& {
+        if (maxResults != 0 && session.results.size() > maxResults) {
+            std::partial_sort(session.results.begin(), session.results.begin() + maxResults,
+                session.results.end(), better);
+            session.results.resize(maxResults);
+        }
+        else {
+            std::sort(session.results.begin(), session.results.end(), better);
+        }
+        return session.results;
+    };
+
+    if (maxResults != 0 && query.size() <= 3 && CollectTier(session, query, kinds, maxResults)) {
+        // The full match set was never materialized, so the next keystroke
+        // goes back to the index instead of narrowing.
+        session.hasMatches = false;
+        return finish();
+    }
+
+    // Incremental narrowing: a query that extends the previous one can only match
+    // a subset of the previous matches, which is used when it is the smaller set.
+    const auto* shortest = ShortestPosting(query);
+    if (shortest == nullptr) {
+        session.matches.clear();
+    }
+    else if (couldNarrow && session.matches.size() <= shortest->size()) {
+        // The previous matches only contain the shorter query, so each is checked.
+        FilterExact(session.matches, query, kinds, true, session.matches);
+    }
+    else {
+        // Grams of up to three characters are indexed directly, so the posting
+        // list of a query that short is exactly its matches.
+        FilterExact(*shortest, query, kinds, query.size() > 3, session.matches);
+    }
+    session.hasMatches = true;
+
+    for (uint32_t id : session.matches) {
+        session.results.push_back({ id, ScoreExact(id, query) });
+    }
+    if (session.results.size() < kFuzzyThreshold) {
+        CollectFuzzy(session, query, kinds);
+    }
+    return finish();
+}
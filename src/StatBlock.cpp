@@ -0,0 +1,196 @@
+#include "StatBlock.h"
+
+namespace {
+    struct StatSource {
+        const char* key;       // meraki stats key
+        Stat flat;             // where "flat" goes
+        Stat percent;          // where "percent" goes, Stat::Count to ignore it
+    };
+
+    // Attack speed, crit, life steal and similar are listed as flat or percent
+    // depending on the item, both mean percentage points here.
+    const StatSource kSources[] = {
+        { "health", Stat::Health, Stat::Count },
+        { "mana", Stat::Mana, Stat::Count },
+        { "armor", Stat::Armor, Stat::Count },
+        { "magicResistance", Stat::MagicResist, Stat::Count },
+        { "attackDamage", Stat::AttackDamage, Stat::Count },
+        { "abilityPower", Stat::AbilityPower, Stat::Count },
+        { "attackSpeed", Stat::AttackSpeed, Stat::AttackSpeed },
+        { "criticalStrikeChance", Stat::CritChance, Stat::CritChance },
+        { "lethality", Stat::Lethality, Stat::Count },
+        { "armorPenetration", Stat::Lethality, Stat::ArmorPenPercent },
+        { "magicPenetration", Stat::MagicPen, Stat::MagicPenPercent },
+        { "abilityHaste", Stat::AbilityHaste, Stat::Count },
+        { "lifesteal", Stat::LifeSteal, Stat::LifeSteal },
+        { "omnivamp", Stat::Omnivamp, Stat::Omnivamp },
+        { "movespeed", Stat::MoveSpeed, Stat::MoveSpeedPercent },
+        { "healthRegen", Stat::HealthRegen, Stat::HealthRegen },
+        { "manaRegen", Stat::ManaRegen, Stat::ManaRegen },
+        { "healAndShieldPower", Stat::HealShieldPower, Stat::HealShieldPower },
+        { "tenacity", Stat::Tenacity, Stat::Tenacity },
+    };
+
+    const char* kStatNames[kStatCount] = {
+        "Health", "Mana", "Armor", "Magic Resist", "Attack Damage", "Ability Power", "Attack Speed",
+        "Crit Chance", "Lethality", "Armor Pen %", "Magic Pen", "Magic Pen %", "Ability Haste",
+        "Life Steal", "Omnivamp", "Move Speed", "Move Speed %", "Health Regen", "Mana Regen",
+        "Heal & Shield Power", "Tenacity"
+    };
+
+    const char* kBaseStatKeys[kBaseStatCount] = {
+        "hp", "hpperlevel", "mp", "mpperlevel", "movespeed", "armor", "armorperlevel",
+        "spellblock", "spellblockperlevel", "attackrange", "hpregen", "hpregenperlevel",
+        "mpregen", "mpregenperlevel", "crit", "critperlevel", "attackdamage", "attackdamageperlevel",
+        "attackspeedperlevel", "attackspeed"
+    };
+
+    float Number(const nlohmann::json& object, const char* key) {
+        auto it = object.find(key);
+        return (it != object.end() && it->is_number()) ? it->get<float>() : 0.0f;
+    }
+
+    float Number(const JsonView& object, const char* key) {
+        return static_cast<float>(object.Find(key).Number());
+    }
+}
+
+const char* StatName(Stat stat) {
+    return stat < Stat::Count ? kStatNames[StatIndex(stat)] : "";
+}
+
+StatVector ParseItemStats(const nlohmann::json& stats) {
+    StatVector out{};
+    if (!stats.is_object()) {
+        return out;
+    }
+    for (const auto& source : kSources) {
+        auto it = stats.find(source.key);
+        if (it == stats.end() || !it->is_object()) {
+            continue;
+        }
+        out[StatIndex(source.flat)] += Number(*it, "flat");
+        if (source.percent != Stat::Count) {
+            out[StatIndex(source.percent)] += Number(*it, "percent");
+        }
+    }
+    return out;
+}
+
+StatVector ParseItemStats(const JsonView& stats) {
+    StatVector out{};
+    if (!stats.IsObject()) {
+        return out;
+    }
+    // One pass over the members instead of a lookup per source
+    stats.ForEachMember([&out](std::string_view key, const JsonView& value) {
+        if (!value.IsObject()) {
+            return;
+        }
+        for (const auto& source : kSources) {
+            if (key != source.key) {
+                continue;
+            }
+            out[StatIndex(source.flat)] += Number(value, "flat");
+            if (source.percent != Stat::Count) {
+                out[StatIndex(source.percent)] += Number(value, "percent");
+            }
+        }
+    });
+    return out;
+}
+
+float GrowthMultiplier(int level) {
+    float steps = static_cast<float>(level - 1);
+    return steps * (0.7025f + 0.0175f * steps);
+}
+
+const char* BaseStatKey(BaseStat stat) {
+    return stat < BaseStat::Count ? kBaseStatKeys[BaseStatIndex(stat)] : "";
+}
+
+ChampionBaseStats ParseChampionBaseStats(const nlohmann::json& stats) {
+    ChampionBaseStats out{};
+    if (!stats.is_object()) {
+        return out;
+    }
+    for (size_t i = 0; i < kBaseStatCount; ++i) {
+        out[i] = Number(stats, kBaseStatKeys[i]);
+    }
+    return out;
+}
+
+ChampionLevelStats ChampionStatsAtLevel(const nlohmann::json& stats, int level) {
+    return ChampionStatsAtLevel(ParseChampionBaseStats(stats), level);
+}
+
+ChampionLevelStats ChampionStatsAtLevel(const ChampionBaseStats& stats, int level) {
+    ChampionLevelStats out;
+    float growth = GrowthMultiplier(level);
+    auto value = [&stats](BaseStat stat) { return stats[BaseStatIndex(stat)]; };
+    auto grown = [&value, growth](BaseStat base, BaseStat perLevel) {
+        return value(base) + value(perLevel) * growth;
+    };
+
+    out.stats[StatIndex(Stat::Health)] = grown(BaseStat::Hp, BaseStat::HpPerLevel);
+    out.stats[StatIndex(Stat::Mana)] = grown(BaseStat::Mp, BaseStat::MpPerLevel);
+    out.stats[StatIndex(Stat::Armor)] = grown(BaseStat::Armor, BaseStat::ArmorPerLevel);
+    out.stats[StatIndex(Stat::MagicResist)] = grown(BaseStat::SpellBlock, BaseStat::SpellBlockPerLevel);
+    out.stats[StatIndex(Stat::AttackDamage)] = grown(BaseStat::AttackDamage, BaseStat::AttackDamagePerLevel);
+    out.stats[StatIndex(Stat::CritChance)] = grown(BaseStat::Crit, BaseStat::CritPerLevel);
+    out.stats[StatIndex(Stat::MoveSpeed)] = value(BaseStat::MoveSpeed);
+    out.stats[StatIndex(Stat::HealthRegen)] = grown(BaseStat::HpRegen, BaseStat::HpRegenPerLevel);
+    out.stats[StatIndex(Stat::ManaRegen)] = grown(BaseStat::MpRegen, BaseStat::MpRegenPerLevel);
+
+    out.baseAttackSpeed = value(BaseStat::AttackSpeed);
+    out.attackSpeedGrowth = value(BaseStat::AttackSpeedPerLevel) * growth;
+    out.stats[StatIndex(Stat::AttackSpeed)] = out.baseAttackSpeed * (1.0f + out.attackSpeedGrowth / 100.0f);
+    out.attackRange = value(BaseStat::AttackRange);
+    return out;
+}
+
+const StatVector& BaselineGoldValues() {
+    // Gold per point of the cheapest basic item for each stat
+    static const StatVector values = [] {
+        StatVector v{};
+        v[StatIndex(Stat::Health)] = 2.667f;          // Ruby Crystal
+        v[StatIndex(Stat::Mana)] = 1.4f;              // Sapphire Crystal
+        v[StatIndex(Stat::Armor)] = 20.0f;            // Cloth Armor
+        v[StatIndex(Stat::MagicResist)] = 18.0f;      // Null-Magic Mantle
+        v[StatIndex(Stat::AttackDamage)] = 35.0f;     // Long Sword
+        v[StatIndex(Stat::AbilityPower)] = 21.75f;    // Amplifying Tome
+        v[StatIndex(Stat::AttackSpeed)] = 25.0f;      // Dagger
+        v[StatIndex(Stat::CritChance)] = 40.0f;       // Cloak of Agility
+        v[StatIndex(Stat::Lethality)] = 30.0f;
+        v[StatIndex(Stat::MagicPen)] = 31.1f;
+        v[StatIndex(Stat::AbilityHaste)] = 26.67f;
+        v[StatIndex(Stat::LifeSteal)] = 37.5f;        // Vampiric Scepter
+        v[StatIndex(Stat::MoveSpeed)] = 12.0f;        // Boots
+        v[StatIndex(Stat::HealthRegen)] = 3.0f;       // Rejuvenation Bead
+        v[StatIndex(Stat::ManaRegen)] = 5.0f;         // Faerie Charm
+        return v;
+    }();
+    return values;
+}
+
+StatVector ItemStatTable::Row(uint32_t item) const {
+    StatVector row{};
+    for (size_t stat = 0; stat < kStatCount; ++stat) {
+        row[stat] = columns[stat][item];
+    }
+    return row;
+}
+
+void ItemStatTable::Resize(size_t count) {
+    for (auto& column : columns) {
+        column.assign(count, 0.0f);
+    }
+    cost.assign(count, 0.0f);
+}
+
+void ItemStatTable::SetRow(uint32_t item, const StatVector& stats, float itemCost) {
+    for (size_t stat = 0; stat < kStatCount; ++stat) {
+        columns[stat][item] = stats[stat];
+    }
+    cost[item] = itemCost;
+}
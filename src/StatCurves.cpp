@@ -0,0 +1,84 @@
+#include "StatCurves.h"
+
+namespace {
+    struct CurveSource {
+        Stat stat;
+        BaseStat base;
+        BaseStat perLevel;    // BaseStat::Count for stats that don't grow
+    };
+
+    const CurveSource kCurveSources[StatCurves::kCurveCount] = {
+        { Stat::Health, BaseStat::Hp, BaseStat::HpPerLevel },
+        { Stat::Mana, BaseStat::Mp, BaseStat::MpPerLevel },
+        { Stat::Armor, BaseStat::Armor, BaseStat::ArmorPerLevel },
+        { Stat::MagicResist, BaseStat::SpellBlock, BaseStat::SpellBlockPerLevel },
+        { Stat::AttackDamage, BaseStat::AttackDamage, BaseStat::AttackDamagePerLevel },
+        { Stat::AttackSpeed, BaseStat::AttackSpeed, BaseStat::AttackSpeedPerLevel },
+        { Stat::HealthRegen, BaseStat::HpRegen, BaseStat::HpRegenPerLevel },
+        { Stat::ManaRegen, BaseStat::MpRegen, BaseStat::MpRegenPerLevel },
+        { Stat::MoveSpeed, BaseStat::MoveSpeed, BaseStat::Count },
+    };
+}
+
+const std::array<Stat, StatCurves::kCurveCount>& StatCurves::CurveStats() {
+    static const std::array<Stat, kCurveCount> stats = [] {
+        std::array<Stat, kCurveCount> out{};
+        for (size_t curve = 0; curve < kCurveCount; ++curve) {
+            out[curve] = kCurveSources[curve].stat;
+        }
+        return out;
+    }();
+    return stats;
+}
+
+int StatCurves::CurveIndex(Stat stat) {
+    for (size_t curve = 0; curve < kCurveCount; ++curve) {
+        if (kCurveSources[curve].stat == stat) {
+            return static_cast<int>(curve);
+        }
+    }
+    return -1;
+}
+
+const StatCurves::Table& StatCurves::Compute(const std::vector<ChampionBaseStats>& championStats) {
+    size_t count = championStats.size();
+    table.championCount = count;
+    table.values.assign(kCurveCount * kMaxLevel * count, 0.0f);
+
+    std::vector<float> base(count);
+    std::vector<float> perLevel(count);
+    std::array<float, kMaxLevel> growth{};
+    for (int level = 1; level <= kMaxLevel; ++level) {
+        growth[level - 1] = GrowthMultiplier(level);
+    }
+
+    for (size_t curve = 0; curve < kCurveCount; ++curve) {
+        const CurveSource& source = kCurveSources[curve];
+        for (size_t champion = 0; champion < count; ++champion) {
+            const ChampionBaseStats& stats = championStats[champion];
+            base[champion] = stats[BaseStatIndex(source.base)];
+            perLevel[champion] = source.perLevel != BaseStat::Count ? stats[BaseStatIndex(source.perLevel)] : 0.0f;
+        }
+
+        // Attack speed growth is a bonus percentage of the base ratio, the
+        // rest grow by a flat amount per level
+        if (source.stat == Stat::AttackSpeed) {
+            for (size_t champion = 0; champion < count; ++champion) {
+                perLevel[champion] = base[champion] * perLevel[champion] / 100.0f;
+            }
+        }
+
+        // Both cases are now base + perLevel * growth, one plain loop per level
+        const float* b = base.data();
+        const float* p = perLevel.data();
+        for (int level = 1; level <= kMaxLevel; ++level) {
+            float g = growth[level - 1];
+            float* out = table.values.data() + (curve * kMaxLevel + (level - 1)) * count;
+            for (size_t champion = 0; champion < count; ++champion) {
+                out[champion] = b[champion] + p[champion] * g;
+            }
+        }
+    }
+    computed = true;
+    return table;
+}
@@ -0,0 +1,100 @@
+#include "Symbols.h"
+#include "Arena.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+
+namespace {
+    constexpr size_t kChunkBits = 12;
+    constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+    constexpr size_t kMaxChunks = 1024;   // 4M symbols
+
+    struct Table {
+        std::shared_mutex mutex;
+        Arena texts;
+        // Names in fixed chunks that never move, so readers index them without the lock
+        std::unique_ptr<std::string_view[]> chunks[kMaxChunks];
+        std::atomic<size_t> count{ 0 };
+        std::vector<Symbol> slots;        // open addressing over the text hash, power of two
+
+        std::string_view NameOf(Symbol symbol) const {
+            return chunks[symbol >> kChunkBits][symbol & (kChunkSize - 1)];
+        }
+
+        // The slot holding text, or the empty slot it would go in
+        size_t Probe(std::string_view text) const {
+            size_t slot = std::hash<std::string_view>()(text) & (slots.size() - 1);
+            while (slots[slot] != Symbols::kNone && NameOf(slots[slot]) != text) {
+                slot = (slot + 1) & (slots.size() - 1);
+            }
+            return slot;
+        }
+
+        void Grow() {
+            std::vector<Symbol> old = std::move(slots);
+            slots.assign(old.empty() ? 1024 : old.size() * 2, Symbols::kNone);
+            for (Symbol symbol : old) {
+                if (symbol != Symbols::kNone) {
+                    slots[Probe(NameOf(symbol))] = symbol;
+                }
+            }
+        }
+    };
+
+    Table& GetTable() {
+        static Table table;
+        return table;
+    }
+}
+
+Symbol Symbols::Intern(std::string_view text) {
+    Table& table = GetTable();
+    {
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        if (!table.slots.empty()) {
+            Symbol found = table.slots[table.Probe(text)];
+            if (found != kNone) {
+                return found;
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    size_t count = table.count.load(std::memory_order_relaxed);
+    if ((count + 1) * 2 > table.slots.size()) {
+        table.Grow();
+    }
+    size_t slot = table.Probe(text);
+    if (table.slots[slot] != kNone) {
+        return table.slots[slot];   // interned by another thread in between
+    }
+    auto& chunk = table.chunks[count >> kChunkBits];
+    if (!chunk) {
+        chunk = std::make_unique<std::string_view[]>(kChunkSize);
+    }
+    chunk[count & (kChunkSize - 1)] = table.texts.Store(text);
+    Symbol symbol = static_cast<Symbol>(count);
+    table.slots[slot] = symbol;
+    table.count.store(count + 1, std::memory_order_release);
+    return symbol;
+}
+
+Symbol Symbols::Find(std::string_view text) {
+    Table& table = GetTable();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    return table.slots.empty() ? kNone : table.slots[table.Probe(text)];
+}
+
+std::string_view Symbols::Name(Symbol symbol) {
+    const Table& table = GetTable();
+    if (symbol >= table.count.load(std::memory_order_acquire)) {
+        return std::string_view();
+    }
+    return table.NameOf(symbol);
+}
+
+size_t Symbols::Count() {
+    return GetTable().count.load(std::memory_order_acquire);
+}
@@ -0,0 +1,222 @@
+#include "TaskPool.h"
+#include <algorithm>
+
+namespace {
+    // Queue of the pool the current thread works for, so tasks submitted from
+    // a worker go to its own deque.
+    thread_local const void* currentPool = nullptr;
+    thread_local size_t currentQueue = 0;
+
+    std::mutex mainMutex;
+    std::vector<std::function<void()>> mainTasks;
+}
+
+TaskPool::TaskPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&TaskPool::WorkerLoop, this, i);
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+TaskPool& TaskPool::Shared() {
+    // One core is left to the UI thread
+    static TaskPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+TaskPool& TaskPool::Io() {
+    static TaskPool pool(4);
+    return pool;
+}
+
+void TaskPool::PostToMain(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(mainMutex);
+    mainTasks.push_back(std::move(task));
+}
+
+void TaskPool::RunMainThreadTasks() {
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        tasks.swap(mainTasks);
+    }
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+bool TaskPool::IsWorkerThread() const {
+    return currentPool == this;
+}
+
+bool TaskPool::RunPending() {
+    return RunOne(currentPool == this ? currentQueue : 0);
+}
+
+void TaskPool::Submit(std::function<void()> task, Priority priority) {
+    size_t target = currentPool == this ? currentQueue : nextQueue++ % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        ++queued;
+    }
+    wake.notify_one();
+}
+
+bool TaskPool::RunOne(size_t home) {
+    std::function<void()> task;
+    for (size_t priority = 0; priority < static_cast<size_t>(Priority::Count) && !task; ++priority) {
+        for (size_t offset = 0; offset < queues.size() && !task; ++offset) {
+            Queue& queue = *queues[(home + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& tasks = queue.tasks[priority];
+            if (tasks.empty()) {
+                continue;
+            }
+            // Own work newest first while it is still in cache, stolen work oldest first
+            if (offset == 0) {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+            }
+            else {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    --queued;
+    task();
+    return true;
+}
+
+void TaskPool::WorkerLoop(size_t index) {
+    currentPool = this;
+    currentQueue = index;
+    while (true) {
+        if (RunOne(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void TaskPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(1, grain);
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    // Every thread claims chunks off one counter, so the caller never has to
+    // run anything but this loop. Helpers that start after the last chunk is
+    // claimed find nothing left and only touch the shared state.
+    struct Loop {
+        const std::function<void(size_t, size_t)>* body;
+        size_t count, grain, chunks;
+        std::atomic<size_t> next{ 0 };
+        size_t finished = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+
+        void Work() {
+            size_t ran = 0;
+            for (size_t chunk = next++; chunk < chunks; chunk = next++) {
+                size_t begin = chunk * grain;
+                (*body)(begin, std::min(count, begin + grain));
+                ++ran;
+            }
+            if (ran > 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished += ran;
+                if (finished == chunks) {
+                    done.notify_all();
+                }
+            }
+        }
+    };
+    auto loop = std::make_shared<Loop>();
+    loop->body = &body;
+    loop->count = count;
+    loop->grain = grain;
+    loop->chunks = chunks;
+
+    size_t helpers = std::min<size_t>(chunks - 1, threads.size());
+    for (size_t i = 0; i < helpers; ++i) {
+        Submit([loop] { loop->Work(); }, Priority::High);
+    }
+    loop->Work();
+
+    // Only chunks other threads already started are left
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->done.wait(lock, [&loop] { return loop->finished == loop->chunks; });
+}
+
+TaskGroup::~TaskGroup() {
+    cancelled = true;
+    Wait();
+}
+
+void TaskGroup::Run(std::function<void()> task, TaskPool::Priority priority) {
+    ++pending;
+    pool.Submit([this, task = std::move(task)] {
+        if (!cancelled) {
+            task();
+        }
+        // Under the lock, so a waiter cannot destroy the group before notify
+        std::lock_guard<std::mutex> lock(doneMutex);
+        --pending;
+        done.notify_all();
+    }, priority);
+}
+
+void TaskGroup::Wait() {
+    if (pool.IsWorkerThread()) {
+        while (pending > 0) {
+            if (!pool.RunPending()) {
+                std::this_thread::yield();
+            }
+        }
+        std::lock_guard<std::mutex> lock(doneMutex);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [this] { return pending == 0; });
+}
+
+void TaskGroup::Cancel() {
+    cancelled = true;
+    Wait();
+    cancelled = false;
+}
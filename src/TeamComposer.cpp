@@ -0,0 +1,346 @@
+#include "TeamComposer.h"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+namespace {
+    constexpr uint64_t kNodeFlushInterval = 4096;
+    constexpr int kIdealRanged = 2;
+    constexpr int kMaxRolesPerChampion = 2;   // ddragon lists at most two tags
+
+    const char* kRoleNames[TeamComposer::kRoleCount] = { "Fighter", "Tank", "Mage", "Assassin", "Marksman", "Support" };
+
+    int RoleCount(uint8_t roles) {
+        int count = 0;
+        for (; roles; roles &= roles - 1) ++count;
+        return count;
+    }
+
+    float RangeTerm(int distance) {
+        return 1.0f - static_cast<float>(distance) / 3.0f;
+    }
+
+    // Saturating, so a third tank still counts a little but never as much as the first
+    float FrontlineTerm(float frontline, float frontlineReference) {
+        return 1.0f - std::exp(-frontline / frontlineReference);
+    }
+
+    float WeightedTotal(const TeamComposer::Breakdown& terms, const TeamComposer::Weights& weights) {
+        float weightSum = weights.coverage + weights.frontline + weights.damage + weights.range;
+        if (weightSum <= 0.0f) {
+            return 0.0f;
+        }
+        return 100.0f * (weights.coverage * terms.coverage + weights.frontline * terms.frontline +
+            weights.damage * terms.damage + weights.range * terms.range) / weightSum;
+    }
+
+    TeamComposer::Breakdown Terms(uint8_t roles, int ranged, float frontline, float physical, float magic, float frontlineReference) {
+        TeamComposer::Breakdown terms;
+        terms.coverage = static_cast<float>(RoleCount(roles)) / TeamComposer::kRoleCount;
+        terms.frontline = FrontlineTerm(frontline, frontlineReference);
+        float damage = physical + magic;
+        terms.damage = damage > 0.0f ? 1.0f - std::fabs(physical - magic) / damage : 0.0f;
+        terms.range = RangeTerm(std::abs(ranged - kIdealRanged));
+        return terms;
+    }
+}
+
+const char* TeamComposer::RoleName(int role) {
+    return role >= 0 && role < kRoleCount ? kRoleNames[role] : "";
+}
+
+uint8_t TeamComposer::RoleMask(const std::vector<std::string>& tags) {
+    uint8_t mask = 0;
+    for (const auto& tag : tags) {
+        for (int role = 0; role < kRoleCount; ++role) {
+            if (tag == kRoleNames[role]) mask |= uint8_t(1) << role;
+        }
+    }
+    return mask;
+}
+
+TeamComposer::~TeamComposer() {
+    Cancel();
+}
+
+float TeamComposer::FrontlineReference(const std::vector<Champion>& champions) {
+    float largest = 0.0f;
+    for (const auto& champion : champions) {
+        largest = std::max(largest, champion.frontline);
+    }
+    return std::max(1.0f, largest);
+}
+
+TeamComposer::Breakdown TeamComposer::Score(const std::vector<Champion>& champions, const std::vector<uint32_t>& members,
+                                            const Weights& weights, float frontlineReference) {
+    uint8_t roles = 0;
+    int ranged = 0;
+    float frontline = 0.0f, physical = 0.0f, magic = 0.0f;
+    for (uint32_t member : members) {
+        if (member >= champions.size()) continue;
+        const Champion& champion = champions[member];
+        roles |= champion.roles;
+        ranged += champion.ranged ? 1 : 0;
+        frontline += champion.frontline;
+        physical += champion.physical;
+        magic += champion.magic;
+    }
+    Breakdown breakdown = Terms(roles, ranged, frontline, physical, magic, frontlineReference);
+    breakdown.total = WeightedTotal(breakdown, weights);
+    return breakdown;
+}
+
+TeamComposer::State TeamComposer::Add(const State& state, const Champion& champion) const {
+    State next = state;
+    next.roles |= champion.roles;
+    next.ranged += champion.ranged ? 1 : 0;
+    next.frontline += champion.frontline;
+    next.physical += champion.physical;
+    next.magic += champion.magic;
+    return next;
+}
+
+float TeamComposer::Evaluate(const State& state) const {
+    return WeightedTotal(Terms(state.roles, state.ranged, state.frontline, state.physical, state.magic, frontlineReference), request.weights);
+}
+
+float TeamComposer::Bound(size_t next, int remaining, const State& state) const {
+    if (remaining <= 0 || next >= candidates.size()) {
+        return Evaluate(state);
+    }
+    Breakdown terms;
+    int roles = std::min(RoleCount(state.roles | suffixRoles[next]), RoleCount(state.roles) + kMaxRolesPerChampion * remaining);
+    terms.coverage = static_cast<float>(roles) / kRoleCount;
+    terms.frontline = FrontlineTerm(state.frontline + suffixTopFrontline[next * (kTeamSize + 1) + remaining], frontlineReference);
+
+    // The gap between physical and magic closes by at most the largest lead
+    // the other way per pick, and the total grows by at most the largest total
+    float gap = std::fabs(state.physical - state.magic);
+    float closing = std::max(0.0f, state.physical > state.magic ? suffixMaxMagicLead[next] : suffixMaxPhysicalLead[next]);
+    float total = state.physical + state.magic + remaining * suffixMaxDamage[next];
+    terms.damage = total > 0.0f ? 1.0f - std::max(0.0f, gap - remaining * closing) / total : 0.0f;
+
+    int fewest = state.ranged, most = state.ranged + remaining;
+    int distance = kIdealRanged < fewest ? fewest - kIdealRanged : (kIdealRanged > most ? kIdealRanged - most : 0);
+    terms.range = RangeTerm(distance);
+    return WeightedTotal(terms, request.weights);
+}
+
+void TeamComposer::Prepare() {
+    frontlineReference = FrontlineReference(request.champions);
+    open = std::max(0, kTeamSize - static_cast<int>(request.picked.size()));
+
+    base = State();
+    std::vector<uint8_t> taken(request.champions.size(), 0);
+    for (uint32_t member : request.picked) {
+        if (member < request.champions.size()) {
+            base = Add(base, request.champions[member]);
+            taken[member] = 1;
+        }
+    }
+    for (uint32_t member : request.excluded) {
+        if (member < taken.size()) taken[member] = 1;
+    }
+
+    // Best single addition first, so strong teams are found early and the
+    // threshold rises quickly
+    std::vector<uint32_t> order;
+    std::vector<float> single(request.champions.size(), 0.0f);
+    for (uint32_t ordinal = 0; ordinal < request.champions.size(); ++ordinal) {
+        if (!taken[ordinal]) {
+            order.push_back(ordinal);
+            single[ordinal] = Evaluate(Add(base, request.champions[ordinal]));
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&single](uint32_t a, uint32_t b) { return single[a] > single[b]; });
+    ordinals = order;
+    candidates.clear();
+    for (uint32_t ordinal : order) {
+        candidates.push_back(request.champions[ordinal]);
+    }
+
+    size_t count = candidates.size();
+    const size_t stride = kTeamSize + 1;
+    suffixRoles.assign(count + 1, 0);
+    suffixTopFrontline.assign((count + 1) * stride, 0.0f);
+    suffixMaxPhysicalLead.assign(count + 1, -FLT_MAX);
+    suffixMaxMagicLead.assign(count + 1, -FLT_MAX);
+    suffixMaxDamage.assign(count + 1, 0.0f);
+    std::array<float, kTeamSize> top{};
+    for (size_t c = count; c-- > 0;) {
+        const Champion& champion = candidates[c];
+        suffixRoles[c] = suffixRoles[c + 1] | champion.roles;
+        suffixMaxPhysicalLead[c] = std::max(suffixMaxPhysicalLead[c + 1], champion.physical - champion.magic);
+        suffixMaxMagicLead[c] = std::max(suffixMaxMagicLead[c + 1], champion.magic - champion.physical);
+        suffixMaxDamage[c] = std::max(suffixMaxDamage[c + 1], champion.physical + champion.magic);
+        if (champion.frontline > top[kTeamSize - 1]) {
+            size_t slot = kTeamSize - 1;
+            while (slot > 0 && top[slot - 1] < champion.frontline) {
+                top[slot] = top[slot - 1];
+                --slot;
+            }
+            top[slot] = champion.frontline;
+        }
+        float sum = 0.0f;
+        for (size_t k = 1; k <= kTeamSize; ++k) {
+            sum += top[k - 1];
+            suffixTopFrontline[c * stride + k] = sum;
+        }
+    }
+
+    // Tasks are the first one or two picks of a completion
+    tasks.clear();
+    if (open == 1) {
+        for (uint32_t first = 0; first < count; ++first) {
+            tasks.push_back({ first, UINT32_MAX });
+        }
+    }
+    else if (open > 1 && count >= static_cast<size_t>(open)) {
+        for (uint32_t first = 0; first + open <= count; ++first) {
+            for (uint32_t second = first + 1; second + open - 1 <= count; ++second) {
+                tasks.push_back({ first, second });
+            }
+        }
+    }
+}
+
+void TeamComposer::Offer(const Team& team) {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    if (best.size() >= request.keep && team.score <= best.back().score) {
+        return;
+    }
+    auto position = std::upper_bound(best.begin(), best.end(), team.score,
+        [](float score, const Team& other) { return score > other.score; });
+    best.insert(position, team);
+    if (best.size() > request.keep) {
+        best.pop_back();
+    }
+    if (best.size() >= request.keep) {
+        threshold = best.back().score;
+    }
+}
+
+bool TeamComposer::ShouldStop() {
+    if (stopping || timedOut) {
+        return true;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+        timedOut = true;
+        return true;
+    }
+    return false;
+}
+
+void TeamComposer::Expand(uint32_t candidate, int depth, Team& team, const State& state, uint64_t& localNodes) {
+    State current = Add(state, candidates[candidate]);
+    team.members[request.picked.size() + depth] = ordinals[candidate];
+    int filled = depth + 1;
+
+    if (++localNodes >= kNodeFlushInterval) {
+        nodes += localNodes;
+        localNodes = 0;
+        if (ShouldStop()) return;
+    }
+    if (filled == open) {
+        team.count = kTeamSize;
+        team.score = Evaluate(current);
+        if (team.score > threshold.load(std::memory_order_relaxed)) {
+            Offer(team);
+        }
+        return;
+    }
+
+    int remaining = open - filled;
+    if (Bound(candidate + 1, remaining, current) <= threshold.load(std::memory_order_relaxed)) {
+        return;
+    }
+    for (uint32_t next = candidate + 1; next + remaining <= candidates.size() && !stopping && !timedOut; ++next) {
+        Expand(next, filled, team, current, localNodes);
+    }
+}
+
+void TeamComposer::RunTask(size_t task) {
+    if (ShouldStop()) {
+        return;
+    }
+    auto [first, second] = tasks[task];
+    Team team;
+    std::copy(request.picked.begin(), request.picked.end(), team.members.begin());
+    uint64_t localNodes = 0;
+    if (second == UINT32_MAX) {
+        Expand(first, 0, team, base, localNodes);
+    }
+    else {
+        State state = Add(base, candidates[first]);
+        team.members[request.picked.size()] = ordinals[first];
+        if (Bound(second, open - 1, state) > threshold.load(std::memory_order_relaxed)) {
+            Expand(second, 1, team, state, localNodes);
+        }
+    }
+    nodes += localNodes;
+}
+
+void TeamComposer::Start(Request newRequest) {
+    Cancel();
+    request = std::move(newRequest);
+    if (request.picked.size() > static_cast<size_t>(kTeamSize)) {
+        request.picked.resize(kTeamSize);
+    }
+    request.keep = std::max<size_t>(1, request.keep);
+    Prepare();
+
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        best.clear();
+    }
+    threshold = -FLT_MAX;
+    tasksDone = 0;
+    nodes = 0;
+    timedOut = false;
+    finishedSeconds = 0.0;
+    startTime = std::chrono::steady_clock::now();
+    deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(std::max(0.0, request.timeBudget)));
+
+    // A full team has nothing to search
+    if (open == 0) {
+        Team team;
+        std::copy(request.picked.begin(), request.picked.end(), team.members.begin());
+        team.count = kTeamSize;
+        team.score = Evaluate(base);
+        Offer(team);
+        return;
+    }
+
+    pendingTasks = tasks.size();
+    for (size_t task = 0; task < tasks.size(); ++task) {
+        search.Run([this, task] {
+            RunTask(task);
+            ++tasksDone;
+            if (--pendingTasks == 0) {
+                finishedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            }
+        });
+    }
+}
+
+void TeamComposer::Cancel() {
+    stopping = true;
+    search.Wait();
+    stopping = false;
+}
+
+TeamComposer::Progress TeamComposer::GetProgress() const {
+    Progress progress;
+    progress.running = pendingTasks > 0;
+    progress.timedOut = timedOut;
+    progress.nodes = nodes;
+    progress.tasksDone = tasksDone;
+    progress.tasksTotal = tasks.size();
+    progress.seconds = progress.running
+        ? std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count()
+        : finishedSeconds.load();
+    std::lock_guard<std::mutex> lock(resultMutex);
+    progress.best = best;
+    return progress;
+}
@@ -0,0 +1,550 @@
+#include "TextIndex.h"
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <unordered_set>
+#include <iostream>
+
+namespace {
+    constexpr float kBm25K1 = 1.2f;
+    constexpr float kBm25B = 0.75f;
+    constexpr uint32_t kFileMagic = 0x5854464C;  // "LFTX"
+    constexpr uint32_t kFileFormat = 1;
+
+    const std::unordered_set<std::string> kStopWords = {
+        "a", "an", "and", "are", "as", "at", "be", "by", "for", "from", "he", "her", "his",
+        "in", "into", "is", "it", "its", "of", "on", "or", "she", "that", "the", "their",
+        "them", "they", "this", "to", "was", "with"
+    };
+
+    bool IsVowel(char c) {
+        return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
+    }
+
+    // Minimal suffix stripping so "knocks", "knocked" and "knocking" share a term.
+    std::string Stem(std::string word) {
+        auto endsWith = [&word](const char* suffix, size_t length) {
+            return word.size() > length && word.compare(word.size() - length, length, suffix) == 0;
+        };
+        bool stripped = false;
+        if (word.size() > 5 && endsWith("ing", 3)) {
+            word.resize(word.size() - 3);
+            stripped = true;
+        }
+        else if (word.size() > 4 && endsWith("ed", 2)) {
+            word.resize(word.size() - 2);
+            stripped = true;
+        }
+        else if (word.size() > 3 && endsWith("s", 1) && !endsWith("ss", 2)) {
+            word.resize(word.size() - 1);
+        }
+        // "stunned" -> "stunn" -> "stun"
+        if (stripped && word.size() > 2) {
+            char last = word.back();
+            if (last == word[word.size() - 2] && !IsVowel(last) && last != 'l' && last != 's' && last != 'z') {
+                word.pop_back();
+            }
+        }
+        return word;
+    }
+
+    void WriteU32(std::ofstream& out, uint32_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::ofstream& out, const std::string& value) {
+        WriteU32(out, static_cast<uint32_t>(value.size()));
+        out.write(value.data(), value.size());
+    }
+
+    bool ReadU32(std::ifstream& in, uint32_t& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool ReadU8(std::ifstream& in, uint8_t& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool ReadString(std::ifstream& in, std::string& value) {
+        uint32_t length = 0;
+        if (!ReadU32(in, length) || length > (1u << 24)) {
+            return false;
+        }
+        value.resize(length);
+        return static_cast<bool>(in.read(value.data(), length));
+    }
+}
+
+TextIndex::TextIndex() = default;
+
+TextIndex::~TextIndex() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    drainTasks.Wait();
+}
+
+std::string TextIndex::StripMarkup(const std::string& text) {
+    static const std::pair<const char*, const char*> kEntities[] = {
+        { "&nbsp;", " " }, { "&amp;", "&" }, { "&lt;", "<" }, { "&gt;", ">" },
+        { "&quot;", "\"" }, { "&#39;", "'" }
+    };
+
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size();) {
+        char c = text[i];
+        if (c == '<') {
+            // Tags such as <br> and <magicDamage> become word breaks.
+            size_t end = text.find('>', i);
+            if (end == std::string::npos) {
+                break;
+            }
+            if (!out.empty() && out.back() != ' ') {
+                out.push_back(' ');
+            }
+            i = end + 1;
+            continue;
+        }
+        if (c == '{' && i + 1 < text.size() && text[i + 1] == '{') {
+            // Tooltip placeholders like {{ e1 }} carry no words.
+            size_t end = text.find("}}", i);
+            i = (end == std::string::npos) ? text.size() : end + 2;
+            continue;
+        }
+        if (c == '&') {
+            bool matched = false;
+            for (const auto& [entity, replacement] : kEntities) {
+                size_t length = std::char_traits<char>::length(entity);
+                if (text.compare(i, length, entity) == 0) {
+                    out += replacement;
+                    i += length;
+                    matched = true;
+                    break;
+                }
+            }
+            if (matched) {
+                continue;
+            }
+        }
+        if (c == '\n' || c == '\r' || c == '\t') {
+            c = ' ';
+        }
+        if (c != ' ' || (!out.empty() && out.back() != ' ')) {
+            out.push_back(c);
+        }
+        ++i;
+    }
+    while (!out.empty() && out.back() == ' ') {
+        out.pop_back();
+    }
+    return out;
+}
+
+std::vector<std::string> TextIndex::Tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string normalized = SearchIndex::Normalize(text);
+    size_t start = 0;
+    while (start < normalized.size()) {
+        size_t end = normalized.find(' ', start);
+        if (end == std::string::npos) {
+            end = normalized.size();
+        }
+        if (end - start >= 2) {
+            std::string word = normalized.substr(start, end - start);
+            if (kStopWords.find(word) == kStopWords.end()) {
+                tokens.push_back(Stem(std::move(word)));
+            }
+        }
+        start = end + 1;
+    }
+    return tokens;
+}
+
+std::string TextIndex::OwnerKey(SearchIndex::EntityKind kind, const std::string& key) {
+    return std::to_string(static_cast<int>(kind)) + ":" + key;
+}
+
+uint32_t TextIndex::GetOwner(SearchIndex::EntityKind kind, const std::string& key) {
+    auto [it, inserted] = ownerIds.emplace(OwnerKey(kind, key), static_cast<uint32_t>(owners.size()));
+    if (inserted) {
+        owners.push_back({ kind, key, Depth::Summary, {} });
+    }
+    return it->second;
+}
+
+void TextIndex::Enqueue(SearchIndex::EntityKind kind, const std::string& key, Depth depth, std::vector<Document> documents) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back({ kind, key, depth, std::move(documents) });
+        if (draining || stopping) {
+            return;
+        }
+        draining = true;
+    }
+    drainTasks.Run([this] { Drain(); }, TaskPool::Priority::Background);
+}
+
+bool TextIndex::HasOwner(SearchIndex::EntityKind kind, const std::string& key, Depth minDepth) const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    auto it = ownerIds.find(OwnerKey(kind, key));
+    if (it == ownerIds.end()) {
+        return false;
+    }
+    const Owner& owner = owners[it->second];
+    return !owner.documents.empty() && owner.depth >= minDepth;
+}
+
+size_t TextIndex::PendingCount() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    // A drain task counts as one more, for the batch it may be applying
+    return queue.size() + (draining ? 1 : 0);
+}
+
+size_t TextIndex::DocumentCount() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    return static_cast<size_t>(liveDocuments);
+}
+
+void TextIndex::Drain() {
+    for (;;) {
+        Batch batch;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (stopping || queue.empty()) {
+                draining = false;
+                return;
+            }
+            batch = std::move(queue.front());
+            queue.pop_front();
+        }
+        Apply(batch);
+    }
+}
+
+void TextIndex::Apply(Batch& batch) {
+    // Strip and tokenize without holding the index lock.
+    struct Prepared {
+        std::string text;
+        std::vector<std::pair<std::string, uint32_t>> terms;
+        uint32_t length;
+    };
+    std::vector<Prepared> prepared;
+    prepared.reserve(batch.documents.size());
+    for (const auto& document : batch.documents) {
+        Prepared entry;
+        entry.text = StripMarkup(document.text);
+        std::vector<std::string> tokens = Tokenize(entry.text);
+        entry.length = static_cast<uint32_t>(tokens.size());
+        std::sort(tokens.begin(), tokens.end());
+        for (size_t i = 0; i < tokens.size();) {
+            size_t j = i;
+            while (j < tokens.size() && tokens[j] == tokens[i]) {
+                ++j;
+            }
+            entry.terms.emplace_back(tokens[i], static_cast<uint32_t>(j - i));
+            i = j;
+        }
+        prepared.push_back(std::move(entry));
+    }
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    uint32_t ownerId = GetOwner(batch.kind, batch.key);
+    Owner& owner = owners[ownerId];
+    if (!owner.documents.empty() && owner.depth > batch.depth) {
+        return;
+    }
+
+    // Replaced documents stay in the postings as tombstones until the next save.
+    for (uint32_t documentId : owner.documents) {
+        StoredDocument& old = documents[documentId];
+        if (old.live) {
+            old.live = false;
+            --liveDocuments;
+            liveTokens -= old.length;
+        }
+    }
+    owner.documents.clear();
+    owner.depth = batch.depth;
+
+    for (size_t i = 0; i < prepared.size(); ++i) {
+        uint32_t documentId = static_cast<uint32_t>(documents.size());
+        const Document& source = batch.documents[i];
+        for (const auto& [term, frequency] : prepared[i].terms) {
+            auto [it, inserted] = termIds.emplace(term, static_cast<uint32_t>(postings.size()));
+            if (inserted) {
+                postings.emplace_back();
+            }
+            postings[it->second].push_back({ documentId, frequency });
+        }
+        documents.push_back({ ownerId, source.field, source.slot, source.label,
+            std::move(prepared[i].text), prepared[i].length, true });
+        owner.documents.push_back(documentId);
+        ++liveDocuments;
+        liveTokens += prepared[i].length;
+    }
+    dirty = true;
+}
+
+std::string TextIndex::MakeSnippet(const std::string& text, const std::vector<std::string>& terms) {
+    constexpr size_t kBefore = 40;
+    constexpr size_t kAfter = 90;
+
+    std::string lower(text.size(), ' ');
+    std::transform(text.begin(), text.end(), lower.begin(),
+        [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; });
+
+    size_t hit = std::string::npos;
+    for (const auto& term : terms) {
+        hit = std::min(hit, lower.find(term));
+    }
+    if (hit == std::string::npos) {
+        hit = 0;
+    }
+
+    size_t start = hit > kBefore ? hit - kBefore : 0;
+    size_t end = std::min(text.size(), hit + kAfter);
+    while (start > 0 && text[start - 1] != ' ') {
+        --start;
+    }
+    while (end < text.size() && text[end] != ' ') {
+        ++end;
+    }
+    std::string snippet = text.substr(start, end - start);
+    if (start > 0) snippet = "..." + snippet;
+    if (end < text.size()) snippet += "...";
+    return snippet;
+}
+
+std::vector<TextIndex::Hit> TextIndex::Search(const std::string& query, size_t maxResults, bool onePerOwner) const {
+    std::vector<std::string> terms = Tokenize(query);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+    std::vector<Hit> hits;
+    if (terms.empty()) {
+        return hits;
+    }
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (liveDocuments == 0) {
+        return hits;
+    }
+    float documentCount = static_cast<float>(liveDocuments);
+    float averageLength = static_cast<float>(liveTokens) / documentCount;
+
+    std::vector<float> scores(documents.size(), 0.0f);
+    std::vector<uint32_t> touched;
+    for (const auto& term : terms) {
+        auto it = termIds.find(term);
+        if (it == termIds.end()) {
+            continue;
+        }
+        const auto& list = postings[it->second];
+        size_t frequencyInDocs = 0;
+        for (const auto& posting : list) {
+            frequencyInDocs += documents[posting.document].live ? 1 : 0;
+        }
+        float df = static_cast<float>(frequencyInDocs);
+        float idf = std::log(1.0f + (documentCount - df + 0.5f) / (df + 0.5f));
+
+        for (const auto& posting : list) {
+            const StoredDocument& document = documents[posting.document];
+            if (!document.live) {
+                continue;
+            }
+            float tf = static_cast<float>(posting.frequency);
+            float norm = kBm25K1 * (1.0f - kBm25B + kBm25B * document.length / averageLength);
+            if (scores[posting.document] == 0.0f) {
+                touched.push_back(posting.document);
+            }
+            scores[posting.document] += idf * tf * (kBm25K1 + 1.0f) / (tf + norm);
+        }
+    }
+
+    std::sort(touched.begin(), touched.end(), [&scores](uint32_t a, uint32_t b) {
+        return scores[a] > scores[b];
+    });
+
+    std::unordered_set<uint32_t> seenOwners;
+    for (uint32_t documentId : touched) {
+        if (maxResults != 0 && hits.size() >= maxResults) {
+            break;
+        }
+        const StoredDocument& document = documents[documentId];
+        if (onePerOwner && !seenOwners.insert(document.owner).second) {
+            continue;
+        }
+        const Owner& owner = owners[document.owner];
+        hits.push_back({ owner.kind, owner.key, document.field, document.slot, document.label,
+            MakeSnippet(document.text, terms), scores[documentId] });
+    }
+    return hits;
+}
+
+bool TextIndex::Save(const std::filesystem::path& path, const std::string& version) const {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open " << temporary << " for writing" << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(indexMutex);
+        // Drop tombstones: live documents are renumbered densely.
+        std::vector<uint32_t> remap(documents.size(), UINT32_MAX);
+        uint32_t next = 0;
+        for (uint32_t i = 0; i < documents.size(); ++i) {
+            if (documents[i].live) {
+                remap[i] = next++;
+            }
+        }
+
+        WriteU32(out, kFileMagic);
+        WriteU32(out, kFileFormat);
+        WriteString(out, version);
+
+        WriteU32(out, static_cast<uint32_t>(owners.size()));
+        for (const auto& owner : owners) {
+            out.put(static_cast<char>(owner.kind));
+            out.put(static_cast<char>(owner.depth));
+            WriteString(out, owner.key);
+        }
+
+        WriteU32(out, next);
+        for (const auto& document : documents) {
+            if (!document.live) {
+                continue;
+            }
+            WriteU32(out, document.owner);
+            out.put(static_cast<char>(document.field));
+            out.put(static_cast<char>(document.slot));
+            WriteString(out, document.label);
+            WriteString(out, document.text);
+            WriteU32(out, document.length);
+        }
+
+        WriteU32(out, static_cast<uint32_t>(termIds.size()));
+        for (const auto& [term, termId] : termIds) {
+            WriteString(out, term);
+            const auto& list = postings[termId];
+            uint32_t liveCount = 0;
+            for (const auto& posting : list) {
+                liveCount += documents[posting.document].live ? 1 : 0;
+            }
+            WriteU32(out, liveCount);
+            for (const auto& posting : list) {
+                if (documents[posting.document].live) {
+                    WriteU32(out, remap[posting.document]);
+                    WriteU32(out, posting.frequency);
+                }
+            }
+        }
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to write text index: " << error.message() << std::endl;
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+bool TextIndex::Load(const std::filesystem::path& path, const std::string& version) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint32_t magic = 0, format = 0;
+    std::string fileVersion;
+    if (!ReadU32(in, magic) || magic != kFileMagic || !ReadU32(in, format) || format != kFileFormat ||
+        !ReadString(in, fileVersion) || fileVersion != version) {
+        return false;
+    }
+
+    std::vector<Owner> loadedOwners;
+    std::unordered_map<std::string, uint32_t> loadedOwnerIds;
+    std::vector<StoredDocument> loadedDocuments;
+    std::unordered_map<std::string, uint32_t> loadedTermIds;
+    std::vector<std::vector<Posting>> loadedPostings;
+    uint64_t tokens = 0;
+
+    uint32_t ownerCount = 0;
+    if (!ReadU32(in, ownerCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < ownerCount; ++i) {
+        uint8_t kind = 0, depth = 0;
+        Owner owner;
+        if (!ReadU8(in, kind) || !ReadU8(in, depth) || !ReadString(in, owner.key) ||
+            kind >= static_cast<uint8_t>(SearchIndex::EntityKind::Count)) {
+            return false;
+        }
+        owner.kind = static_cast<SearchIndex::EntityKind>(kind);
+        owner.depth = static_cast<Depth>(depth);
+        loadedOwnerIds[OwnerKey(owner.kind, owner.key)] = i;
+        loadedOwners.push_back(std::move(owner));
+    }
+
+    uint32_t documentCount = 0;
+    if (!ReadU32(in, documentCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < documentCount; ++i) {
+        StoredDocument document;
+        uint8_t field = 0;
+        if (!ReadU32(in, document.owner) || document.owner >= ownerCount || !ReadU8(in, field) ||
+            !ReadU8(in, document.slot) || !ReadString(in, document.label) ||
+            !ReadString(in, document.text) || !ReadU32(in, document.length)) {
+            return false;
+        }
+        document.field = static_cast<Field>(field);
+        document.live = true;
+        tokens += document.length;
+        loadedOwners[document.owner].documents.push_back(i);
+        loadedDocuments.push_back(std::move(document));
+    }
+
+    uint32_t termCount = 0;
+    if (!ReadU32(in, termCount)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < termCount; ++i) {
+        std::string term;
+        uint32_t postingCount = 0;
+        if (!ReadString(in, term) || !ReadU32(in, postingCount) || postingCount > documentCount) {
+            return false;
+        }
+        std::vector<Posting> list(postingCount);
+        for (auto& posting : list) {
+            if (!ReadU32(in, posting.document) || posting.document >= documentCount ||
+                !ReadU32(in, posting.frequency)) {
+                return false;
+            }
+        }
+        loadedTermIds[term] = i;
+        loadedPostings.push_back(std::move(list));
+    }
+
+    std::lock_guard<std::mutex> lock(indexMutex);
+    owners = std::move(loadedOwners);
+    ownerIds = std::move(loadedOwnerIds);
+    documents = std::move(loadedDocuments);
+    termIds = std::move(loadedTermIds);
+    postings = std::move(loadedPostings);
+    liveDocuments = documentCount;
+    liveTokens = tokens;
+    dirty = false;
+    return true;
+}
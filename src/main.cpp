@@ -1,10 +1,21 @@
 
 #include "../GuiManager.h"
+#include <cstring>
 
-int main()
+int main(int argc, char** argv)
 {
     GUIManager gui;
 
+    // --json=nlohmann parses with the full tree instead of the on-demand reader
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json=nlohmann") == 0) {
+            gui.SetJsonBackend(DataManager::JsonBackend::Nlohmann);
+        }
+        else if (std::strcmp(argv[i], "--json=ondemand") == 0) {
+            gui.SetJsonBackend(DataManager::JsonBackend::OnDemand);
+        }
+    }
+
     if (!gui.Initialize(1280, 720, "Dear ImGui GLFW+OpenGL3 example"))
         return 1;
     gui.SetWindowOffset(20.0f);  // Set a 20-pixel offset
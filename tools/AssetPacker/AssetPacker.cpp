@@ -0,0 +1,196 @@
+// Packs a local Data Dragon mirror into the bundle LoLinfoApp embeds:
+// the dataset snapshots plus every champion, item and summoner spell icon
+// downscaled into one atlas.
+//
+// AssetPacker <mirror> --patch 14.14.1 [--items items.json] [--out assets\bundle.bin] [--icon-size 64]
+//
+// <mirror> is an extracted dragontail archive (the patch folder inside it is
+// found automatically) or a patch folder itself. items.json is the meraki
+// item list, which Data Dragon does not ship; without it the bundle has no
+// item snapshot and the app fetches items on first launch.
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+#include "AssetBundle.h"
+#include "DatasetSnapshot.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace {
+    struct Options {
+        std::filesystem::path mirror;
+        std::string patch;
+        std::filesystem::path items;
+        std::filesystem::path out = std::filesystem::path("assets") / "bundle.bin";
+        int iconSize = 64;
+    };
+
+    bool ReadJson(const std::filesystem::path& path, nlohmann::json& document) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::cerr << "Missing " << path << std::endl;
+            return false;
+        }
+        try {
+            document = nlohmann::json::parse(in);
+            return true;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing " << path << ": " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    // Box filter: every output pixel averages the source pixels it covers
+    std::vector<uint8_t> Downscale(const uint8_t* source, int width, int height, int size) {
+        std::vector<uint8_t> out(static_cast<size_t>(size) * size * 4);
+        for (int y = 0; y < size; ++y) {
+            int y0 = y * height / size;
+            int y1 = std::max(y0 + 1, (y + 1) * height / size);
+            for (int x = 0; x < size; ++x) {
+                int x0 = x * width / size;
+                int x1 = std::max(x0 + 1, (x + 1) * width / size);
+                uint32_t sum[4] = {};
+                for (int sy = y0; sy < y1; ++sy) {
+                    for (int sx = x0; sx < x1; ++sx) {
+                        const uint8_t* pixel = source + (static_cast<size_t>(sy) * width + sx) * 4;
+                        for (int c = 0; c < 4; ++c) sum[c] += pixel[c];
+                    }
+                }
+                uint32_t count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+                for (int c = 0; c < 4; ++c) {
+                    out[(static_cast<size_t>(y) * size + x) * 4 + c] = static_cast<uint8_t>((sum[c] + count / 2) / count);
+                }
+            }
+        }
+        return out;
+    }
+
+    class AtlasPacker {
+    public:
+        explicit AtlasPacker(int size) : size(size) {}
+
+        void Add(const std::string& key, const std::filesystem::path& path) {
+            int width, height, channels;
+            unsigned char* image = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
+            if (!image) {
+                std::cerr << "Skipping unreadable icon " << path << std::endl;
+                return;
+            }
+            keys.push_back(key);
+            cells.push_back(Downscale(image, width, height, size));
+            stbi_image_free(image);
+        }
+
+        AssetBundle::Atlas Finish() const {
+            AssetBundle::Atlas atlas;
+            atlas.cellSize = size;
+            atlas.columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(cells.size())))));
+            atlas.rows = std::max(1, static_cast<int>((cells.size() + atlas.columns - 1) / atlas.columns));
+            atlas.keys = keys;
+            atlas.pixels.assign(static_cast<size_t>(atlas.Width()) * atlas.rows * size * 4, 0);
+            size_t rowBytes = static_cast<size_t>(size) * 4;
+            for (size_t i = 0; i < cells.size(); ++i) {
+                size_t x = (i % atlas.columns) * size;
+                size_t y = (i / atlas.columns) * size;
+                for (int row = 0; row < size; ++row) {
+                    std::copy_n(cells[i].data() + row * rowBytes, rowBytes,
+                        atlas.pixels.data() + ((y + row) * atlas.Width() + x) * 4);
+                }
+            }
+            return atlas;
+        }
+
+        size_t Count() const { return keys.size(); }
+
+    private:
+        int size;
+        std::vector<std::string> keys;
+        std::vector<std::vector<uint8_t>> cells;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--patch" && hasValue) options.patch = argv[++i];
+            else if (arg == "--items" && hasValue) options.items = argv[++i];
+            else if (arg == "--out" && hasValue) options.out = argv[++i];
+            else if (arg == "--icon-size" && hasValue) options.iconSize = std::atoi(argv[++i]);
+            else if (!arg.empty() && arg[0] != '-' && options.mirror.empty()) options.mirror = arg;
+            else return false;
+        }
+        return !options.mirror.empty() && !options.patch.empty() && options.iconSize > 0 && options.iconSize <= 256;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: AssetPacker <mirror> --patch <version> [--items items.json] [--out bundle.bin] [--icon-size 64]" << std::endl;
+        return 2;
+    }
+
+    std::filesystem::path root = options.mirror;
+    if (std::filesystem::exists(root / options.patch / "data")) {
+        root /= options.patch;
+    }
+    std::filesystem::path data = root / "data" / "en_US";
+    std::filesystem::path images = root / "img";
+
+    AssetBundle::Writer writer(options.patch);
+    AtlasPacker icons(options.iconSize);
+
+    nlohmann::json champions;
+    if (!ReadJson(data / "champion.json", champions)) {
+        return 1;
+    }
+    writer.Add("champions.snapshot", DatasetSnapshot::BuildChampions(champions, options.patch));
+    for (const auto& [id, champion] : champions["data"].items()) {
+        icons.Add("champion/" + id, images / "champion" / champion["image"].value("full", id + ".png"));
+    }
+
+    nlohmann::json spells;
+    if (ReadJson(data / "summoner.json", spells)) {
+        writer.Add("summoners.snapshot", DatasetSnapshot::BuildSummonerSpells(spells, options.patch));
+        for (const auto& [id, spell] : spells["data"].items()) {
+            icons.Add("spell/" + id, images / "spell" / spell["image"].value("full", id + ".png"));
+        }
+    }
+
+    // Read on demand, as the app does by default, so the items' content
+    // hashes match the ones it computes
+    std::ifstream itemsFile(options.items, std::ios::binary);
+    if (!options.items.empty() && !itemsFile) {
+        std::cerr << "Missing " << options.items << std::endl;
+    }
+    else if (itemsFile) {
+        std::stringstream buffer;
+        buffer << itemsFile.rdbuf();
+        std::string items = buffer.str();
+        try {
+            writer.Add("items.snapshot", DatasetSnapshot::BuildItems(std::string_view(items), options.patch));
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Exception parsing " << options.items << ": " << e.what() << std::endl;
+        }
+    }
+    // Item icons are named by id in Data Dragon whichever item list is used
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(images / "item", error)) {
+        if (file.path().extension() == ".png") {
+            icons.Add("item/" + file.path().stem().string(), file.path());
+        }
+    }
+
+    writer.AddAtlas("icons.atlas", icons.Finish());
+    if (!writer.Save(options.out)) {
+        return 1;
+    }
+    std::cout << "Packed patch " << options.patch << " with " << icons.Count() << " icons into " << options.out << std::endl;
+    return 0;
+}